@@ -778,6 +778,57 @@ const _makeWindow = (options = {}, parent = null, top = null) => {
     }
   })(DOM.HTMLAudioElement);
 
+  // Also installed in workers, through its source, so it may only reference worker globals.
+  class OffscreenCanvas {
+    constructor(width, height) {
+      this._width = width;
+      this._height = height;
+      this._context = null;
+    }
+
+    get width() {
+      return this._width;
+    }
+    set width(width) {
+      this._width = width;
+      if (this._context) {
+        this._context.resize(this._width, this._height);
+      }
+    }
+    get height() {
+      return this._height;
+    }
+    set height(height) {
+      this._height = height;
+      if (this._context) {
+        this._context.resize(this._width, this._height);
+      }
+    }
+
+    get data() {
+      return (this._context && this._context.data) || null;
+    }
+    set data(data) {}
+
+    getContext(contextType) {
+      if (contextType === '2d') {
+        if (this._context === null) {
+          this._context = new CanvasRenderingContext2D(this._width, this._height);
+        }
+        return this._context;
+      } else {
+        return null;
+      }
+    }
+
+    transferToImageBitmap() {
+      if (this._context === null) {
+        throw new Error('InvalidStateError: canvas has no rendering context');
+      }
+      return this._context.transferToImageBitmap();
+    }
+  }
+
   function createImageBitmap(src, x, y, w, h, options) {
     let image;
     if (src.constructor.name === 'HTMLImageElement') {
@@ -1315,6 +1366,7 @@ const _makeWindow = (options = {}, parent = null, top = null) => {
   window.Path2D = Path2D;
   window.CanvasGradient = CanvasGradient;
   window.CanvasRenderingContext2D = CanvasRenderingContext2D;
+  window.OffscreenCanvas = OffscreenCanvas;
   window.WebGLRenderingContext = WebGLRenderingContext;
   window.WebGL2RenderingContext = WebGL2RenderingContext;
   window.Audio = HTMLAudioElementBound;
@@ -1379,6 +1431,8 @@ const _makeWindow = (options = {}, parent = null, top = null) => {
           global.Image = bindings.nativeImage;
           global.ImageBitmap = bindings.nativeImageBitmap;
           global.createImageBitmap = ${createImageBitmap.toString()};
+          global.CanvasRenderingContext2D = bindings.nativeCanvasRenderingContext2D;
+          global.OffscreenCanvas = ${OffscreenCanvas.toString()};
         `;
       }
 
@@ -1563,6 +1617,7 @@ const _makeWindow = (options = {}, parent = null, top = null) => {
     const xrDisplay = new XR.XRDevice();
     xrDisplay.onrequestpresent = layers => nativeVr.requestPresent(layers);
     xrDisplay.onexitpresent = () => nativeVr.exitPresent();
+    xrDisplay.onrequestviewportscaling = scale => nativeVr.requestViewportScaling(scale);
     xrDisplay.onrequestanimationframe = _makeRequestAnimationFrame(window);
     xrDisplay.oncancelanimationframe = window.cancelAnimationFrame;
     xrDisplay.requestSession = (requestSession => function() {
@@ -26,7 +26,7 @@ v8::Local<v8::Object> makeGl2();
 v8::Local<v8::Object> makeImage();
 v8::Local<v8::Object> makeImageData();
 v8::Local<v8::Object> makeImageBitmap();
-v8::Local<v8::Object> makeCanvasRenderingContext2D(Local<Value> imageDataCons, Local<Value> canvasGradientCons, Local<Value> canvasPatternCons);
+v8::Local<v8::Object> makeCanvasRenderingContext2D(Local<Value> imageDataCons, Local<Value> imageBitmapCons, Local<Value> canvasGradientCons, Local<Value> canvasPatternCons);
 v8::Local<v8::Object> makePath2D();
 v8::Local<v8::Object> makeCanvasGradient();
 v8::Local<v8::Object> makeCanvasPattern();
@@ -39,12 +39,12 @@ Local<Object> makeImageBitmap() {
   return scope.Escape(ImageBitmap::Initialize(isolate));
 }
 
-Local<Object> makeCanvasRenderingContext2D(Local<Value> imageDataCons, Local<Value> canvasGradientCons, Local<Value> canvasPatternCons) {
+Local<Object> makeCanvasRenderingContext2D(Local<Value> imageDataCons, Local<Value> imageBitmapCons, Local<Value> canvasGradientCons, Local<Value> canvasPatternCons) {
   Isolate *isolate = Isolate::GetCurrent();
 
   Nan::EscapableHandleScope scope;
 
-  return scope.Escape(CanvasRenderingContext2D::Initialize(isolate, imageDataCons, canvasGradientCons, canvasPatternCons));
+  return scope.Escape(CanvasRenderingContext2D::Initialize(isolate, imageDataCons, imageBitmapCons, canvasGradientCons, canvasPatternCons));
 }
 
 Local<Object> makePath2D() {
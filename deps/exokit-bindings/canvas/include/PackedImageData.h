@@ -11,7 +11,7 @@ namespace canvas {
   class PackedImageData {
   public:
   PackedImageData() : format(NO_FORMAT), width(0), height(0), levels(0), quality(0) { }
-    PackedImageData(InternalFormat _format, unsigned short _levels, const ImageData & input);
+    PackedImageData(InternalFormat _format, unsigned short _levels, const ImageData & input, unsigned short _quality = 0);
     PackedImageData(InternalFormat _format, unsigned short _width, unsigned short _height, unsigned short _levels, const unsigned char * input = 0);
   
     void setQuality(unsigned short _quality) { quality = _quality; }
@@ -43,25 +43,30 @@ namespace canvas {
       return 0;
     }
 
+    // same rounding as GL so levels can be uploaded as-is
+    static unsigned short getMipSize(unsigned short size) {
+      return size > 1 ? size / 2 : 1;
+    }
+
     static size_t calculateOffset(unsigned short width, unsigned short height, unsigned short level, InternalFormat format) {
       size_t s = 0;
       if (format == RGB_ETC1 || format == RGB_DXT1 || format == RED_RGTC1) {
 	for (unsigned int l = 0; l < level; l++) {
 	  s += 8 * ((width + 3) / 4) * ((height + 3) / 4);
-	  width = (width + 1) / 2;
-	  height = (height + 1) / 2;
+	  width = getMipSize(width);
+	  height = getMipSize(height);
 	}
-      } else if (format == RG_RGTC2) {
+      } else if (format == RG_RGTC2 || format == RGBA_DXT5) {
 	for (unsigned int l = 0; l < level; l++) {
 	  s += 16 * ((width + 3) / 4) * ((height + 3) / 4);
-	  width = (width + 1) / 2;
-	  height = (height + 1) / 2;
+	  width = getMipSize(width);
+	  height = getMipSize(height);
 	}
       } else {
 	for (unsigned int l = 0; l < level; l++) {
 	  s += width * height * getBytesPerPixel(format);
-	  width = (width + 1) / 2;
-	  height = (height + 1) / 2;
+	  width = getMipSize(width);
+	  height = getMipSize(height);
 	}
       }
       return s;
@@ -93,7 +98,7 @@ namespace canvas {
     unsigned short quality;
     std::unique_ptr<unsigned char[]> data;
     
-    static bool etc1_initialized;
+    static void compressLevel(InternalFormat format, const ImageData & input, unsigned char * output, unsigned short quality);
   };
 };
 
@@ -0,0 +1,38 @@
+#ifndef _WORKERPOOL_H_
+#define _WORKERPOOL_H_
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace canvas {
+  // Fixed set of background threads for CPU-heavy image work (texture compression, decoding).
+  class WorkerPool {
+  public:
+    WorkerPool(unsigned int num_threads = 0);
+    ~WorkerPool();
+
+    void queue(std::function<void()> job);
+    // Runs fn(i) for i in [0, n) across the pool and the calling thread, and waits for all of them.
+    // Called from a job already running on the pool, it runs everything on that thread.
+    void parallelFor(unsigned int n, const std::function<void(unsigned int)> & fn);
+
+    unsigned int getNumThreads() const { return threads.size(); }
+
+    static WorkerPool & getDefault();
+
+  private:
+    void run();
+
+    std::vector<std::thread> threads;
+    std::deque<std::function<void()> > jobs;
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool live;
+  };
+};
+
+#endif
@@ -2,19 +2,63 @@
 
 #include <FloydSteinberg.h>
 #include <ImageData.h>
+#include <WorkerPool.h>
 
 #include "rg_etc1.h"
 #include "dxt.h"
 
 #include <cassert>
+#include <mutex>
 
 using namespace std;
 using namespace canvas;
 
-bool PackedImageData::etc1_initialized = false;
+static once_flag compression_initialized;
 
-PackedImageData::PackedImageData(InternalFormat _format, unsigned short _levels, const ImageData & input)
-  : format(_format), width(input.getWidth()), height(input.getHeight()), levels(_levels)
+void
+PackedImageData::compressLevel(InternalFormat format, const ImageData & input, unsigned char * output, unsigned short quality) {
+  // both encoders build their lookup tables lazily and are not safe to initialize from several threads
+  call_once(compression_initialized, []() {
+    rg_etc1::pack_etc1_block_init();
+    unsigned char block[4 * 4 * 4] = { 0 }, dest[16];
+    stb_compress_dxt1_block(dest, block, false, 0);
+  });
+
+  const unsigned short width = input.getWidth(), height = input.getHeight();
+  const unsigned int rows = (height + 3) / 4, cols = (width + 3) / 4;
+  const unsigned int block_size = format == RGBA_DXT5 ? 16 : 8;
+  const unsigned char * input_data = input.getData();
+
+  WorkerPool::getDefault().parallelFor(rows, [&](unsigned int row) {
+    rg_etc1::etc1_pack_params params;
+    params.m_quality = quality > 0 ? rg_etc1::cMediumQuality : rg_etc1::cLowQuality;
+    unsigned char input_block[4 * 4 * 4];
+    unsigned char * target = output + row * cols * block_size;
+
+    for (unsigned int col = 0; col < cols; col++) {
+      // clamp to the edge for partial blocks
+      for (unsigned int y = 0; y < 4; y++) {
+	unsigned int sy = std::min<unsigned int>(row * 4 + y, height - 1);
+	for (unsigned int x = 0; x < 4; x++) {
+	  unsigned int sx = std::min<unsigned int>(col * 4 + x, width - 1);
+	  memcpy(input_block + (y * 4 + x) * 4, input_data + (sy * width + sx) * 4, 4);
+	  if (format != RGBA_DXT5) {
+	    input_block[(y * 4 + x) * 4 + 3] = 255;
+	  }
+	}
+      }
+      if (format == RGB_ETC1) {
+	rg_etc1::pack_etc1_block(target, (const unsigned int *)&(input_block[0]), params);
+      } else {
+	stb_compress_dxt1_block(target, &(input_block[0]), format == RGBA_DXT5, quality > 0 ? STB_DXT_HIGHQUAL : STB_DXT_NORMAL);
+      }
+      target += block_size;
+    }
+  });
+}
+
+PackedImageData::PackedImageData(InternalFormat _format, unsigned short _levels, const ImageData & input, unsigned short _quality)
+  : format(_format), width(input.getWidth()), height(input.getHeight()), levels(_levels), quality(_quality)
 {
   if (format == NO_FORMAT) {
     if (input.getNumChannels() == 4) format = RGBA8;
@@ -39,11 +83,23 @@ PackedImageData::PackedImageData(InternalFormat _format, unsigned short _levels,
     FloydSteinberg fs(format);
     unsigned int offset = fs.apply(input, data.get());
     if (levels >= 2) {
-      auto img = input.scale((input.getWidth() + 1) / 2, (input.getHeight() + 1) / 2);
+      auto img = input.scale(getMipSize(input.getWidth()), getMipSize(input.getHeight()));
       for (unsigned int l = 1; l < levels; l++) {
 	offset += fs.apply(*img, data.get() + offset);
 	if (l + 1 < levels) {
-	  img = img->scale((img->getWidth() + 1) / 2, (img->getHeight() + 1) / 2);
+	  img = img->scale(getMipSize(img->getWidth()), getMipSize(img->getHeight()));
+	}
+      }
+    }
+  } else if (format == RGB_DXT1 || format == RGBA_DXT5 || format == RGB_ETC1) {
+    assert(num_channels == 4);
+    compressLevel(format, input, data.get(), quality);
+    if (levels >= 2) {
+      auto img = input.scale(getMipSize(input.getWidth()), getMipSize(input.getHeight()));
+      for (unsigned int l = 1; l < levels; l++) {
+	compressLevel(format, *img, data.get() + calculateOffset(l), quality);
+	if (l + 1 < levels) {
+	  img = img->scale(getMipSize(img->getWidth()), getMipSize(img->getHeight()));
 	}
       }
     }
@@ -0,0 +1,97 @@
+#include <WorkerPool.h>
+
+#include <algorithm>
+#include <atomic>
+
+using namespace std;
+using namespace canvas;
+
+// set on the pool's own threads; a job waiting there for helpers queued behind it could stall the pool
+static thread_local bool is_worker_thread = false;
+
+WorkerPool::WorkerPool(unsigned int num_threads) : live(true) {
+  if (num_threads == 0) {
+    num_threads = thread::hardware_concurrency();
+    if (num_threads > 1) num_threads--; // leave a core for the main thread
+    if (num_threads == 0) num_threads = 1;
+  }
+  for (unsigned int i = 0; i < num_threads; i++) {
+    threads.push_back(thread([this]() { run(); }));
+  }
+}
+
+WorkerPool::~WorkerPool() {
+  {
+    lock_guard<std::mutex> lock(mutex);
+    live = false;
+  }
+  cv.notify_all();
+  for (auto & t : threads) {
+    t.join();
+  }
+}
+
+void
+WorkerPool::queue(std::function<void()> job) {
+  {
+    lock_guard<std::mutex> lock(mutex);
+    jobs.push_back(std::move(job));
+  }
+  cv.notify_one();
+}
+
+void
+WorkerPool::parallelFor(unsigned int n, const std::function<void(unsigned int)> & fn) {
+  if (n == 0) return;
+  if (is_worker_thread) {
+    for (unsigned int i = 0; i < n; i++) {
+      fn(i);
+    }
+    return;
+  }
+
+  atomic<unsigned int> next(0);
+  unsigned int num_helpers = std::min<unsigned int>(threads.size(), n - 1);
+  unsigned int remaining = num_helpers;
+  std::mutex done_mutex;
+  condition_variable done_cv;
+
+  auto work = [&]() {
+    for (unsigned int i = next++; i < n; i = next++) {
+      fn(i);
+    }
+  };
+  for (unsigned int i = 0; i < num_helpers; i++) {
+    queue([&]() {
+      work();
+      lock_guard<std::mutex> lock(done_mutex);
+      if (--remaining == 0) done_cv.notify_one();
+    });
+  }
+  work();
+
+  unique_lock<std::mutex> lock(done_mutex);
+  done_cv.wait(lock, [&]() { return remaining == 0; });
+}
+
+void
+WorkerPool::run() {
+  is_worker_thread = true;
+  for (;;) {
+    std::function<void()> job;
+    {
+      unique_lock<std::mutex> lock(mutex);
+      cv.wait(lock, [this]() { return !live || !jobs.empty(); });
+      if (!live && jobs.empty()) return;
+      job = std::move(jobs.front());
+      jobs.pop_front();
+    }
+    job();
+  }
+}
+
+WorkerPool &
+WorkerPool::getDefault() {
+  static WorkerPool pool;
+  return pool;
+}
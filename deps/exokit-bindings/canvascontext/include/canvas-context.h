@@ -19,7 +19,16 @@
 #include <SkCanvas.h>
 #include <SkPath.h>
 #include <SkPaint.h>
+#include <SkPicture.h>
+#include <SkPictureRecorder.h>
+#include <atomic>
+#include <future>
+#include <memory>
+#include <vector>
 #include <webglcontext/include/webgl.h>
+#include "canvas-gpu.h"
+#include "color-cache.h"
+#include "font-cache.h"
 
 using namespace v8;
 using namespace node;
@@ -45,7 +54,7 @@ enum class Direction {
 
 class CanvasRenderingContext2D : public ObjectWrap {
 public:
-  static Handle<Object> Initialize(Isolate *isolate, Local<Value> imageDataCons, Local<Value> canvasGradientCons, Local<Value> canvasPatternCons);
+  static Handle<Object> Initialize(Isolate *isolate, Local<Value> imageDataCons, Local<Value> imageBitmapCons, Local<Value> canvasGradientCons, Local<Value> canvasPatternCons);
   unsigned int GetWidth();
   unsigned int GetHeight();
   unsigned int GetNumChannels();
@@ -79,6 +88,15 @@ public:
   void DrawImage(const SkImage *image, float sx, float sy, float sw, float sh, float dx, float dy, float dw, float dh, bool flipY);
   void Save();
   void Restore();
+  // Device-space region drawn since the pixels were last uploaded with TakeUploadDirtyRect. The version changes
+  // each time the region is taken, so an uploader can tell whether the region is relative to its own upload.
+  const SkIRect &GetUploadDirtyRect() const { return uploadDirtyRect; }
+  uint64_t GetUploadVersion() const { return uploadVersion; }
+  uint64_t TakeUploadDirtyRect();
+  // Texture the canvas renders into on CanvasGpu's context, or 0 for a raster canvas.
+  GLuint GetGpuTexture() const { return gpuTexture; }
+  // Plays back anything recorded and returns the canvas holding the pixels, for reading them.
+  SkCanvas *Rasterize();
 
 protected:
   static NAN_METHOD(New);
@@ -142,9 +160,19 @@ protected:
   static NAN_METHOD(CreateImageData);
   static NAN_METHOD(GetImageData);
   static NAN_METHOD(PutImageData);
+  static NAN_METHOD(TransferToImageBitmap);
   static NAN_METHOD(Save);
   static NAN_METHOD(Restore);
   static NAN_METHOD(Destroy);
+  static NAN_METHOD(SetGpuContext);
+  static NAN_METHOD(SetRecording);
+
+  void MarkDirty(const SkRect &bounds, const SkPaint *paint);
+  void MarkDirty();
+  SkCanvas *GetCanvas();
+  sk_sp<SkSurface> MakeSurface(unsigned int w, unsigned int h, GLuint *texture);
+  void BeginRecording(const SkMatrix &matrix);
+  void FlushRecording(bool background);
 
   static bool isImageType(Local<Value> arg);
   static sk_sp<SkImage> getImage(Local<Value> arg);
@@ -153,13 +181,33 @@ protected:
   virtual ~CanvasRenderingContext2D();
 
 private:
+  // Persistent copy of the pixels for the data getter; only dataDirtyRect is read back when it is stale.
   Nan::Persistent<Uint8ClampedArray> dataArray;
+  SkIRect dataDirtyRect;
+  SkIRect uploadDirtyRect;
+  uint64_t uploadVersion;
 
   sk_sp<SkSurface> surface;
+  GLuint gpuTexture;
+
+  // Display list mode: draws go into a picture that is played back onto the surface when the pixels are read, or
+  // on a worker thread once it grows long. The save stack is kept so the next picture starts in the same state.
+  struct SaveLevel {
+    std::vector<std::pair<SkMatrix, SkPath>> clips;
+    SkMatrix matrix; // in effect when the next level was saved
+  };
+  std::unique_ptr<SkPictureRecorder> recorder;
+  size_t recordedOps;
+  std::vector<SaveLevel> saveLevels;
+  std::future<void> rasterizing;
+
   SkPath path;
   SkPaint strokePaint;
   SkPaint fillPaint;
   SkPaint clearPaint;
+  // Last string styles set, so a page setting the same color every frame skips the parse; emptied by gradients and patterns.
+  Nan::Persistent<Value> lastStrokeStyle;
+  Nan::Persistent<Value> lastFillStyle;
   float lineHeight;
   std::string textAlign;
   TextBaseline textBaseline;
@@ -0,0 +1,28 @@
+#ifndef _CANVASCONTEXT_CANVAS_GPU_H_
+#define _CANVASCONTEXT_CANVAS_GPU_H_
+
+#include <thread>
+#include <SkRefCnt.h>
+#include <SkSurface.h>
+#include <GrContext.h>
+#include <webglcontext/include/webgl.h>
+
+// Skia's GPU backend for 2D canvases. Skia renders on a hidden context of its own, shared with a WebGL window, so
+// canvas textures can be read by WebGL in that share group and WebGL calls never disturb the GL state Skia
+// tracks. Only software GL is needed; Mesa's llvmpipe works.
+class CanvasGpu {
+public:
+  // Creates the context against sharedWindow. Returns false if GL or Skia fail, in which case canvases stay raster.
+  static bool Init(GLFWwindow *sharedWindow);
+  // Whether GPU surfaces can be made on the calling thread; canvases on worker threads stay raster.
+  static bool IsAvailable();
+  static GLFWwindow *GetWindow();
+  static void MakeCurrent();
+  // A surface backed by a new RGBA8 texture, top row first like the raster surface. Null if it can't be made.
+  static sk_sp<SkSurface> MakeSurface(int width, int height, GLuint *texture);
+  static void DeleteTexture(GLuint texture);
+  // Submits everything drawn so far and returns a fence for the reading context to wait on.
+  static GLsync Flush();
+};
+
+#endif
@@ -0,0 +1,16 @@
+#ifndef _CANVASCONTEXT_COLOR_CACHE_H_
+#define _CANVASCONTEXT_COLOR_CACHE_H_
+
+#include <string>
+#include <SkColor.h>
+
+// Parsed fillStyle/strokeStyle colors, shared by all canvases and threads. "#rgb", "#rrggbb", "rgb()" and "rgba()"
+// with plain numbers are read directly; anything else goes through the CSS parser once and is kept, least recently
+// used first out.
+class ColorCache {
+public:
+  // Same result as canvas::web_color::from_string.
+  static SkColor Get(const std::string &color);
+};
+
+#endif
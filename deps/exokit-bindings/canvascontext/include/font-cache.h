@@ -0,0 +1,36 @@
+#ifndef _CANVASCONTEXT_FONT_CACHE_H_
+#define _CANVASCONTEXT_FONT_CACHE_H_
+
+#include <string>
+#include <SkFontStyle.h>
+#include <SkPaint.h>
+#include <SkRect.h>
+#include <SkRefCnt.h>
+#include <SkTextBlob.h>
+#include <SkTypeface.h>
+
+// Caches for canvas text, shared by all canvases and threads. Pages set ctx.font before every label and draw the
+// same strings every frame, so parsed and resolved fonts, typefaces and glyph runs are all kept, least recently
+// used first out.
+class FontCache {
+public:
+  struct Font {
+    sk_sp<SkTypeface> typeface;
+    float textSize; // NaN if the font string has none
+    float lineHeight;
+  };
+  // A string shaped with a paint's font; width and bounds are what the paint's measureText gives, for the string
+  // drawn left-aligned.
+  struct TextRun {
+    sk_sp<SkTextBlob> blob; // null for a string without glyphs
+    SkScalar width;
+    SkRect bounds;
+  };
+
+  // Parses a CSS font shorthand and resolves its typeface.
+  static Font GetFont(const std::string &font);
+  static sk_sp<SkTypeface> GetTypeface(const std::string &family, const SkFontStyle &fontStyle);
+  static TextRun GetTextRun(const SkPaint &paint, const std::string &text);
+};
+
+#endif
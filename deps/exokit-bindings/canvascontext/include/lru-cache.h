@@ -0,0 +1,53 @@
+#ifndef _CANVASCONTEXT_LRU_CACHE_H_
+#define _CANVASCONTEXT_LRU_CACHE_H_
+
+#include <functional>
+#include <list>
+#include <unordered_map>
+#include <utility>
+
+// Map holding at most capacity entries, dropping the least recently used one to make room. Not thread safe.
+template<typename K, typename V, typename H = std::hash<K>>
+class LruCache {
+public:
+  explicit LruCache(size_t capacity) : capacity(capacity) {}
+
+  // Returns the value for key and marks it most recently used, or null. Valid until the next Put.
+  V *Get(const K &key) {
+    auto iter = index.find(key);
+    if (iter == index.end()) {
+      return nullptr;
+    }
+    entries.splice(entries.begin(), entries, iter->second);
+    return &iter->second->second;
+  }
+
+  void Put(const K &key, V value) {
+    auto iter = index.find(key);
+    if (iter != index.end()) {
+      iter->second->second = std::move(value);
+      entries.splice(entries.begin(), entries, iter->second);
+      return;
+    }
+
+    entries.emplace_front(key, std::move(value));
+    index[key] = entries.begin();
+    if (entries.size() > capacity) {
+      index.erase(entries.back().first);
+      entries.pop_back();
+    }
+  }
+
+  size_t Size() const {
+    return entries.size();
+  }
+
+private:
+  typedef std::list<std::pair<K, V>> EntryList;
+
+  size_t capacity;
+  EntryList entries;
+  std::unordered_map<K, typename EntryList::iterator, H> index;
+};
+
+#endif
@@ -4,15 +4,19 @@ using namespace v8;
 using namespace node;
 
 bool isImageValue(Local<Value> arg) {
-  if (arg->ToObject()->Get(JS_STR("constructor"))->ToObject()->Get(JS_STR("name"))->StrictEquals(JS_STR("HTMLCanvasElement"))) {
-    Local<Value> otherContextObj = arg->ToObject()->Get(JS_STR("_context"));
-    return otherContextObj->IsObject() && otherContextObj->ToObject()->Get(JS_STR("constructor"))->ToObject()->Get(JS_STR("name"))->StrictEquals(JS_STR("CanvasRenderingContext2D"));
+  Local<Value> constructorName = arg->ToObject()->Get(JS_KEY(constructor))->ToObject()->Get(JS_KEY(name));
+  if (
+    constructorName->StrictEquals(JS_KEY(HTMLCanvasElement)) ||
+    constructorName->StrictEquals(JS_KEY(OffscreenCanvas))
+  ) {
+    Local<Value> otherContextObj = arg->ToObject()->Get(JS_KEY(_context));
+    return otherContextObj->IsObject() && otherContextObj->ToObject()->Get(JS_KEY(constructor))->ToObject()->Get(JS_KEY(name))->StrictEquals(JS_KEY(CanvasRenderingContext2D));
   } else {
     return arg->IsObject() && (
-      arg->ToObject()->Get(JS_STR("constructor"))->ToObject()->Get(JS_STR("name"))->StrictEquals(JS_STR("CanvasRenderingContext2D")) ||
-      arg->ToObject()->Get(JS_STR("constructor"))->ToObject()->Get(JS_STR("name"))->StrictEquals(JS_STR("HTMLImageElement")) ||
-      arg->ToObject()->Get(JS_STR("constructor"))->ToObject()->Get(JS_STR("name"))->StrictEquals(JS_STR("ImageData")) ||
-      arg->ToObject()->Get(JS_STR("constructor"))->ToObject()->Get(JS_STR("name"))->StrictEquals(JS_STR("ImageBitmap"))
+      constructorName->StrictEquals(JS_KEY(CanvasRenderingContext2D)) ||
+      constructorName->StrictEquals(JS_KEY(HTMLImageElement)) ||
+      constructorName->StrictEquals(JS_KEY(ImageData)) ||
+      constructorName->StrictEquals(JS_KEY(ImageBitmap))
     );
   }
 }
@@ -22,7 +26,14 @@ void flipCanvasY(SkCanvas *canvas, float height) {
   canvas->scale(1.0, -1.0);
 }
 
-Handle<Object> CanvasRenderingContext2D::Initialize(Isolate *isolate, Local<Value> imageDataCons, Local<Value> canvasGradientCons, Local<Value> canvasPatternCons) {
+// shared by all canvases, so a version never matches one taken from another canvas; workers make canvases too
+static std::atomic<uint64_t> nextUploadVersion(0);
+// canvases created while this is set record display lists
+static std::atomic<bool> recordingMode(false);
+// draws recorded before a picture is handed to a worker thread to play back
+static const size_t maxRecordedOps = 2048;
+
+Handle<Object> CanvasRenderingContext2D::Initialize(Isolate *isolate, Local<Value> imageDataCons, Local<Value> imageBitmapCons, Local<Value> canvasGradientCons, Local<Value> canvasPatternCons) {
   Nan::EscapableHandleScope scope;
 
   // constructor
@@ -66,11 +77,15 @@ Handle<Object> CanvasRenderingContext2D::Initialize(Isolate *isolate, Local<Valu
   Nan::SetMethod(proto,"createImageData", CreateImageData);
   Nan::SetMethod(proto,"getImageData", GetImageData);
   Nan::SetMethod(proto,"putImageData", PutImageData);
+  Nan::SetMethod(proto,"transferToImageBitmap", TransferToImageBitmap);
 
   Nan::SetMethod(proto,"destroy", Destroy);
 
   Local<Function> ctorFn = ctor->GetFunction();
+  Nan::SetMethod(ctorFn, "setGpuContext", SetGpuContext);
+  Nan::SetMethod(ctorFn, "setRecording", SetRecording);
   ctorFn->Set(JS_STR("ImageData"), imageDataCons);
+  ctorFn->Set(JS_STR("ImageBitmap"), imageBitmapCons);
   ctorFn->Set(JS_STR("CanvasGradient"), canvasGradientCons);
   ctorFn->Set(JS_STR("CanvasPattern"), canvasPatternCons);
 
@@ -94,39 +109,37 @@ bool CanvasRenderingContext2D::isValid() {
 }
 
 void CanvasRenderingContext2D::Scale(float x, float y) {
-  surface->getCanvas()->scale(x, y);
+  GetCanvas()->scale(x, y);
 }
 
 void CanvasRenderingContext2D::Rotate(float angle) {
-  surface->getCanvas()->rotate(angle);
+  GetCanvas()->rotate(angle);
 }
 
 void CanvasRenderingContext2D::Translate(float x, float y) {
-  surface->getCanvas()->translate(x, y);
+  GetCanvas()->translate(x, y);
 }
 
 void CanvasRenderingContext2D::Transform(float a, float b, float c, float d, float e, float f) {
   SkScalar affine[] = {a, b, c, d, e, f};
   SkMatrix m;
   m.setAffine(affine);
-  surface->getCanvas()->setMatrix(m);
+  GetCanvas()->setMatrix(m);
 }
 
 void CanvasRenderingContext2D::SetTransform(float a, float b, float c, float d, float e, float f) {
   SkScalar affine[] = {a, b, c, d, e, f};
   SkMatrix m;
   m.setAffine(affine);
-  surface->getCanvas()->setMatrix(m);
+  GetCanvas()->setMatrix(m);
 }
 
 void CanvasRenderingContext2D::ResetTransform() {
-  surface->getCanvas()->resetMatrix();
+  GetCanvas()->resetMatrix();
 }
 
 float CanvasRenderingContext2D::MeasureText(const std::string &text) {
-  SkRect bounds;
-  strokePaint.measureText(text.c_str(), text.length(), &bounds);
-  return bounds.width();
+  return FontCache::GetTextRun(strokePaint, text).bounds.width();
 }
 
 void CanvasRenderingContext2D::BeginPath() {
@@ -138,23 +151,30 @@ void CanvasRenderingContext2D::ClosePath() {
 }
 
 void CanvasRenderingContext2D::Clip() {
-  surface->getCanvas()->clipPath(path);
+  if (recorder) {
+    saveLevels.back().clips.emplace_back(GetCanvas()->getTotalMatrix(), path);
+  }
+  GetCanvas()->clipPath(path);
 }
 
 void CanvasRenderingContext2D::Stroke() {
-  surface->getCanvas()->drawPath(path, strokePaint);
+  GetCanvas()->drawPath(path, strokePaint);
+  MarkDirty(path.getBounds(), &strokePaint);
 }
 
 void CanvasRenderingContext2D::Stroke(const Path2D &path) {
-  surface->getCanvas()->drawPath(path.path, strokePaint);
+  GetCanvas()->drawPath(path.path, strokePaint);
+  MarkDirty(path.path.getBounds(), &strokePaint);
 }
 
 void CanvasRenderingContext2D::Fill() {
-  surface->getCanvas()->drawPath(path, fillPaint);
+  GetCanvas()->drawPath(path, fillPaint);
+  MarkDirty(path.getBounds(), &fillPaint);
 }
 
 void CanvasRenderingContext2D::Fill(const Path2D &path) {
-  surface->getCanvas()->drawPath(path.path, fillPaint);
+  GetCanvas()->drawPath(path.path, fillPaint);
+  MarkDirty(path.path.getBounds(), &fillPaint);
 }
 
 void CanvasRenderingContext2D::MoveTo(float x, float y) {
@@ -189,19 +209,22 @@ void CanvasRenderingContext2D::Rect(float x, float y, float w, float h) {
 void CanvasRenderingContext2D::FillRect(float x, float y, float w, float h) {
   SkPath path;
   path.addRect(SkRect::MakeXYWH(x, y, w, h));
-  surface->getCanvas()->drawPath(path, fillPaint);
+  GetCanvas()->drawPath(path, fillPaint);
+  MarkDirty(path.getBounds(), &fillPaint);
 }
 
 void CanvasRenderingContext2D::StrokeRect(float x, float y, float w, float h) {
   SkPath path;
   path.addRect(SkRect::MakeXYWH(x, y, w, h));
-  surface->getCanvas()->drawPath(path, strokePaint);
+  GetCanvas()->drawPath(path, strokePaint);
+  MarkDirty(path.getBounds(), &strokePaint);
 }
 
 void CanvasRenderingContext2D::ClearRect(float x, float y, float w, float h) {
   SkPath path;
   path.addRect(SkRect::MakeXYWH(x, y, w, h));
-  surface->getCanvas()->drawPath(path, clearPaint);
+  GetCanvas()->drawPath(path, clearPaint);
+  MarkDirty(path.getBounds(), &clearPaint);
 }
 
 float getFontBaseline(const SkPaint &paint, const TextBaseline &textBaseline, float lineHeight) {
@@ -236,23 +259,69 @@ float getFontBaseline(const SkPaint &paint, const TextBaseline &textBaseline, fl
   return 0;
 }
 
+// Where textAlign puts the left edge of a run of the given advance, relative to the x it is drawn at.
+float getTextAlignOffset(const SkPaint &paint, float width) {
+  switch (paint.getTextAlign()) {
+    case SkPaint::kCenter_Align:
+      return -width / 2.0f;
+    case SkPaint::kRight_Align:
+      return -width;
+    case SkPaint::kLeft_Align:
+    default:
+      return 0;
+  }
+}
+
 void CanvasRenderingContext2D::FillText(const std::string &text, float x, float y) {
   // surface->getCanvas()->drawText(text.c_str(), text.length(), x, y - getFontBaseline(fillPaint, textBaseline, lineHeight), fillPaint);
-  surface->getCanvas()->drawText(text.c_str(), text.length(), x, y, fillPaint);
+  FontCache::TextRun textRun = FontCache::GetTextRun(fillPaint, text);
+  // the run is shaped left-aligned
+  x += getTextAlignOffset(fillPaint, textRun.width);
+  if (textRun.blob) {
+    GetCanvas()->drawTextBlob(textRun.blob, x, y, fillPaint);
+  }
+
+  SkRect bounds = textRun.bounds;
+  bounds.offset(x, y);
+  MarkDirty(bounds, &fillPaint);
 }
 
 void CanvasRenderingContext2D::StrokeText(const std::string &text, float x, float y) {
   // surface->getCanvas()->drawText(text.c_str(), text.length(), x, y - getFontBaseline(strokePaint, textBaseline, lineHeight), strokePaint);
-  surface->getCanvas()->drawText(text.c_str(), text.length(), x, y, strokePaint);
+  FontCache::TextRun textRun = FontCache::GetTextRun(strokePaint, text);
+  // the run is shaped left-aligned
+  x += getTextAlignOffset(strokePaint, textRun.width);
+  if (textRun.blob) {
+    GetCanvas()->drawTextBlob(textRun.blob, x, y, strokePaint);
+  }
+
+  SkRect bounds = textRun.bounds;
+  bounds.offset(x, y);
+  MarkDirty(bounds, &strokePaint);
 }
 
 bool CanvasRenderingContext2D::Resize(unsigned int w, unsigned int h) {
-  SkImageInfo info = SkImageInfo::Make(w, h, SkColorType::kRGBA_8888_SkColorType, SkAlphaType::kPremul_SkAlphaType);
-  sk_sp<SkSurface> newSurface = SkSurface::MakeRaster(info);
+  GLuint newGpuTexture;
+  sk_sp<SkSurface> newSurface = MakeSurface(w, h, &newGpuTexture);
 
   if (newSurface) {
+    if (rasterizing.valid()) {
+      rasterizing.wait();
+    }
     surface = newSurface;
+    if (gpuTexture) {
+      CanvasGpu::DeleteTexture(gpuTexture);
+    }
+    gpuTexture = newGpuTexture;
+    if (recorder) {
+      // the new surface starts out blank, in the default state
+      recorder->finishRecordingAsPicture();
+      saveLevels.clear();
+      saveLevels.emplace_back();
+      BeginRecording(SkMatrix::I());
+    }
     // flipCanvasY(surface->getCanvas());
+    MarkDirty();
     return true;
   } else {
     return false;
@@ -261,27 +330,154 @@ bool CanvasRenderingContext2D::Resize(unsigned int w, unsigned int h) {
 
 void CanvasRenderingContext2D::DrawImage(const SkImage *image, float sx, float sy, float sw, float sh, float dx, float dy, float dw, float dh, bool flipY) {
   if (flipY) {
-    surface->getCanvas()->save();
-    flipCanvasY(surface->getCanvas(), dy + dh);
+    GetCanvas()->save();
+    flipCanvasY(GetCanvas(), dy + dh);
   }
 
   SkPaint paint;
   paint.setColor(0xFFFFFFFF);
   paint.setStyle(SkPaint::kFill_Style);
   paint.setBlendMode(SkBlendMode::kSrcOver);
-  surface->getCanvas()->drawImageRect(image, SkRect::MakeXYWH(sx, sy, sw, sh), SkRect::MakeXYWH(dx, surface->getCanvas()->imageInfo().height() - dy - dh, dw, dh), &paint);
+  const SkRect dst = SkRect::MakeXYWH(dx, GetCanvas()->imageInfo().height() - dy - dh, dw, dh);
+  GetCanvas()->drawImageRect(image, SkRect::MakeXYWH(sx, sy, sw, sh), dst, &paint);
+  MarkDirty(dst, &paint);
 
   if (flipY) {
-    surface->getCanvas()->restore();
+    GetCanvas()->restore();
   }
 }
 
 void CanvasRenderingContext2D::Save() {
-  surface->getCanvas()->save();
+  if (recorder) {
+    saveLevels.back().matrix = GetCanvas()->getTotalMatrix();
+    saveLevels.emplace_back();
+  }
+  GetCanvas()->save();
 }
 
 void CanvasRenderingContext2D::Restore() {
-  surface->getCanvas()->restore();
+  if (recorder && saveLevels.size() > 1) {
+    saveLevels.pop_back();
+  }
+  GetCanvas()->restore();
+}
+
+SkCanvas *CanvasRenderingContext2D::GetCanvas() {
+  if (recorder) {
+    SkCanvas *canvas = recorder->getRecordingCanvas();
+    // a draw that saves and restores around itself may be halfway through, with a save that saveLevels lacks
+    if (recordedOps >= maxRecordedOps && canvas->getSaveCount() == (int)saveLevels.size()) {
+      FlushRecording(true);
+      canvas = recorder->getRecordingCanvas();
+    }
+    return canvas;
+  }
+  if (gpuTexture) {
+    // Skia issues GL commands while recording, not only when flushing
+    CanvasGpu::MakeCurrent();
+  }
+  return surface->getCanvas();
+}
+
+SkCanvas *CanvasRenderingContext2D::Rasterize() {
+  if (recorder) {
+    FlushRecording(false);
+  }
+  if (gpuTexture) {
+    CanvasGpu::MakeCurrent();
+  }
+  return surface->getCanvas();
+}
+
+// Starts a picture in the save stack, clips and transform the last one ended with.
+void CanvasRenderingContext2D::BeginRecording(const SkMatrix &matrix) {
+  SkCanvas *canvas = recorder->beginRecording(GetWidth(), GetHeight());
+  for (size_t i = 0; i < saveLevels.size(); i++) {
+    if (i > 0) {
+      canvas->save();
+    }
+    for (const auto &clip : saveLevels[i].clips) {
+      canvas->setMatrix(clip.first);
+      canvas->clipPath(clip.second);
+    }
+    canvas->setMatrix(i + 1 < saveLevels.size() ? saveLevels[i].matrix : matrix);
+  }
+  recordedOps = 0;
+}
+
+// Plays the recorded picture back onto the surface, on a worker thread if background is set and the surface is
+// raster. The pictures before it have to have landed first.
+void CanvasRenderingContext2D::FlushRecording(bool background) {
+  const SkMatrix matrix = recorder->getRecordingCanvas()->getTotalMatrix();
+  sk_sp<SkPicture> picture = recorder->finishRecordingAsPicture();
+
+  if (rasterizing.valid()) {
+    rasterizing.wait();
+  }
+  if (background && !gpuTexture) {
+    sk_sp<SkSurface> rasterSurface = surface;
+    rasterizing = std::async(std::launch::async, [rasterSurface, picture]() {
+      rasterSurface->getCanvas()->drawPicture(picture);
+    });
+  } else {
+    if (gpuTexture) {
+      CanvasGpu::MakeCurrent();
+    }
+    surface->getCanvas()->drawPicture(picture);
+  }
+
+  BeginRecording(matrix);
+}
+
+// Renders on the GPU once CanvasGpu is set up, falling back to raster if the texture can't be made.
+sk_sp<SkSurface> CanvasRenderingContext2D::MakeSurface(unsigned int w, unsigned int h, GLuint *texture) {
+  if (CanvasGpu::IsAvailable()) {
+    sk_sp<SkSurface> gpuSurface = CanvasGpu::MakeSurface(w, h, texture);
+    if (gpuSurface) {
+      return gpuSurface;
+    }
+  }
+
+  *texture = 0;
+  SkImageInfo info = SkImageInfo::Make(w, h, SkColorType::kRGBA_8888_SkColorType, SkAlphaType::kPremul_SkAlphaType);
+  return SkSurface::MakeRaster(info);
+}
+
+uint64_t CanvasRenderingContext2D::TakeUploadDirtyRect() {
+  uploadDirtyRect.setEmpty();
+  uploadVersion = ++nextUploadVersion;
+  return uploadVersion;
+}
+
+// Adds the device-space bounds of a draw, with the paint's stroke and effects, to the dirty regions.
+void CanvasRenderingContext2D::MarkDirty(const SkRect &bounds, const SkPaint *paint) {
+  recordedOps++;
+
+  if (paint && !paint->canComputeFastBounds()) {
+    MarkDirty();
+    return;
+  }
+
+  SkCanvas *canvas = GetCanvas();
+  SkRect storage;
+  const SkRect &paintBounds = paint ? paint->computeFastBounds(bounds, &storage) : bounds;
+  SkRect deviceBounds;
+  canvas->getTotalMatrix().mapRect(&deviceBounds, paintBounds);
+  // antialiasing touches the pixels around the edges
+  deviceBounds.outset(1, 1);
+
+  SkIRect deviceRect;
+  deviceBounds.roundOut(&deviceRect);
+  if (deviceRect.intersect(canvas->getDeviceClipBounds())) {
+    dataDirtyRect.join(deviceRect);
+    uploadDirtyRect.join(deviceRect);
+  }
+}
+
+void CanvasRenderingContext2D::MarkDirty() {
+  const SkIRect bounds = SkIRect::MakeWH(GetWidth(), GetHeight());
+  dataDirtyRect = bounds;
+  uploadDirtyRect = bounds;
 }
 
 NAN_METHOD(CanvasRenderingContext2D::New) {
@@ -296,9 +492,9 @@ NAN_METHOD(CanvasRenderingContext2D::New) {
       Local<Object> canvasObj = info.This();
       context->Wrap(canvasObj);
 
-      Nan::SetAccessor(canvasObj, JS_STR("width"), WidthGetter);
-      Nan::SetAccessor(canvasObj, JS_STR("height"), HeightGetter);
-      Nan::SetAccessor(canvasObj, JS_STR("data"), DataGetter);
+      Nan::SetAccessor(canvasObj, JS_KEY(width), WidthGetter);
+      Nan::SetAccessor(canvasObj, JS_KEY(height), HeightGetter);
+      Nan::SetAccessor(canvasObj, JS_KEY(data), DataGetter);
       Nan::SetAccessor(canvasObj, JS_STR("lineWidth"), LineWidthGetter, LineWidthSetter);
       Nan::SetAccessor(canvasObj, JS_STR("strokeStyle"), StrokeStyleGetter, StrokeStyleSetter);
       Nan::SetAccessor(canvasObj, JS_STR("fillStyle"), FillStyleGetter, FillStyleSetter);
@@ -343,17 +539,30 @@ NAN_GETTER(CanvasRenderingContext2D::DataGetter) {
 
   CanvasRenderingContext2D *context = ObjectWrap::Unwrap<CanvasRenderingContext2D>(info.This());
 
+  unsigned int width = context->GetWidth();
+  unsigned int height = context->GetHeight();
   if (context->dataArray.IsEmpty()) {
-    unsigned int width = context->GetWidth();
-    unsigned int height = context->GetHeight();
-
     Local<ArrayBuffer> arrayBuffer = ArrayBuffer::New(Isolate::GetCurrent(), width * height * 4); // XXX link lifetime
 
     SkImageInfo imageInfo = SkImageInfo::Make(width, height, SkColorType::kRGBA_8888_SkColorType, SkAlphaType::kPremul_SkAlphaType);
-    bool ok = context->surface->getCanvas()->readPixels(imageInfo, arrayBuffer->GetContents().Data(), width * 4, 0, 0);
+    bool ok = context->Rasterize()->readPixels(imageInfo, arrayBuffer->GetContents().Data(), width * 4, 0, 0);
     if (ok) {
       Local<Uint8ClampedArray> uint8ClampedArray = Uint8ClampedArray::New(arrayBuffer, 0, arrayBuffer->ByteLength());
       context->dataArray.Reset(uint8ClampedArray);
+      context->dataDirtyRect.setEmpty();
+    } else {
+      return info.GetReturnValue().Set(Nan::Null());
+    }
+  } else if (!context->dataDirtyRect.isEmpty()) {
+    // only read back what was drawn since the last read, into the same array
+    const SkIRect &dirtyRect = context->dataDirtyRect;
+    Local<Uint8ClampedArray> uint8ClampedArray = Nan::New(context->dataArray);
+    char *data = (char *)uint8ClampedArray->Buffer()->GetContents().Data() + uint8ClampedArray->ByteOffset();
+
+    SkImageInfo imageInfo = SkImageInfo::Make(dirtyRect.width(), dirtyRect.height(), SkColorType::kRGBA_8888_SkColorType, SkAlphaType::kPremul_SkAlphaType);
+    bool ok = context->Rasterize()->readPixels(imageInfo, data + (dirtyRect.fTop * width + dirtyRect.fLeft) * 4, width * 4, dirtyRect.fLeft, dirtyRect.fTop);
+    if (ok) {
+      context->dataDirtyRect.setEmpty();
     } else {
       return info.GetReturnValue().Set(Nan::Null());
     }
@@ -394,22 +603,28 @@ NAN_SETTER(CanvasRenderingContext2D::StrokeStyleSetter) {
   if (value->IsString()) {
     CanvasRenderingContext2D *context = ObjectWrap::Unwrap<CanvasRenderingContext2D>(info.This());
 
+    if (!context->lastStrokeStyle.IsEmpty() && Nan::New(context->lastStrokeStyle)->StrictEquals(value)) {
+      return;
+    }
+
     v8::String::Utf8Value text(value);
     std::string strokeStyle(*text, text.length());
 
-    canvas::web_color webColor = canvas::web_color::from_string(strokeStyle.c_str());
-    context->strokePaint.setColor(((uint32_t)webColor.a << (8 * 3)) | ((uint32_t)webColor.r << (8 * 2)) | ((uint32_t)webColor.g << (8 * 1)) | ((uint32_t)webColor.b << (8 * 0)));
-    context->fillPaint.setShader(nullptr);
-  } else if (value->IsObject() && value->ToObject()->Get(JS_STR("constructor"))->ToObject()->Get(JS_STR("name"))->StrictEquals(JS_STR("CanvasGradient"))) {
+    context->strokePaint.setColor(ColorCache::Get(strokeStyle));
+    context->strokePaint.setShader(nullptr);
+    context->lastStrokeStyle.Reset(value);
+  } else if (value->IsObject() && value->ToObject()->Get(JS_KEY(constructor))->ToObject()->Get(JS_KEY(name))->StrictEquals(JS_STR("CanvasGradient"))) {
     CanvasRenderingContext2D *context = ObjectWrap::Unwrap<CanvasRenderingContext2D>(info.This());
 
     CanvasGradient *canvasGradient = ObjectWrap::Unwrap<CanvasGradient>(Local<Object>::Cast(value));
-    context->fillPaint.setShader(canvasGradient->getShader());
-  } else if (value->IsObject() && value->ToObject()->Get(JS_STR("constructor"))->ToObject()->Get(JS_STR("name"))->StrictEquals(JS_STR("CanvasPattern"))) {
+    context->strokePaint.setShader(canvasGradient->getShader());
+    context->lastStrokeStyle.Reset();
+  } else if (value->IsObject() && value->ToObject()->Get(JS_KEY(constructor))->ToObject()->Get(JS_KEY(name))->StrictEquals(JS_STR("CanvasPattern"))) {
     CanvasRenderingContext2D *context = ObjectWrap::Unwrap<CanvasRenderingContext2D>(info.This());
 
     CanvasPattern *canvasPattern = ObjectWrap::Unwrap<CanvasPattern>(Local<Object>::Cast(value));
-    context->fillPaint.setShader(canvasPattern->getShader());
+    context->strokePaint.setShader(canvasPattern->getShader());
+    context->lastStrokeStyle.Reset();
   } else {
     Nan::ThrowError("strokeStyle: invalid arguments");
   }
@@ -425,22 +640,28 @@ NAN_SETTER(CanvasRenderingContext2D::FillStyleSetter) {
   if (value->IsString()) {
     CanvasRenderingContext2D *context = ObjectWrap::Unwrap<CanvasRenderingContext2D>(info.This());
 
+    if (!context->lastFillStyle.IsEmpty() && Nan::New(context->lastFillStyle)->StrictEquals(value)) {
+      return;
+    }
+
     v8::String::Utf8Value text(value);
     std::string fillStyle(*text, text.length());
 
-    canvas::web_color webColor = canvas::web_color::from_string(fillStyle.c_str());
-    context->fillPaint.setColor(((uint32_t)webColor.a << (8 * 3)) | ((uint32_t)webColor.r << (8 * 2)) | ((uint32_t)webColor.g << (8 * 1)) | ((uint32_t)webColor.b << (8 * 0)));
+    context->fillPaint.setColor(ColorCache::Get(fillStyle));
     context->fillPaint.setShader(nullptr);
-  } else if (value->IsObject() && value->ToObject()->Get(JS_STR("constructor"))->ToObject()->Get(JS_STR("name"))->StrictEquals(JS_STR("CanvasGradient"))) {
+    context->lastFillStyle.Reset(value);
+  } else if (value->IsObject() && value->ToObject()->Get(JS_KEY(constructor))->ToObject()->Get(JS_KEY(name))->StrictEquals(JS_STR("CanvasGradient"))) {
     CanvasRenderingContext2D *context = ObjectWrap::Unwrap<CanvasRenderingContext2D>(info.This());
 
     CanvasGradient *canvasGradient = ObjectWrap::Unwrap<CanvasGradient>(Local<Object>::Cast(value));
     context->fillPaint.setShader(canvasGradient->getShader());
-  } else if (value->IsObject() && value->ToObject()->Get(JS_STR("constructor"))->ToObject()->Get(JS_STR("name"))->StrictEquals(JS_STR("CanvasPattern"))) {
+    context->lastFillStyle.Reset();
+  } else if (value->IsObject() && value->ToObject()->Get(JS_KEY(constructor))->ToObject()->Get(JS_KEY(name))->StrictEquals(JS_STR("CanvasPattern"))) {
     CanvasRenderingContext2D *context = ObjectWrap::Unwrap<CanvasRenderingContext2D>(info.This());
 
     CanvasPattern *canvasPattern = ObjectWrap::Unwrap<CanvasPattern>(Local<Object>::Cast(value));
     context->fillPaint.setShader(canvasPattern->getShader());
+    context->lastFillStyle.Reset();
   } else {
      Nan::ThrowError("fillStyle: invalid arguments");
   }
@@ -454,19 +675,22 @@ NAN_SETTER(CanvasRenderingContext2D::FontSetter) {
   Nan::HandleScope scope;
 
   if (value->IsString()) {
-    Local<Object> contextObj = info.This();
+    CanvasRenderingContext2D *context = ObjectWrap::Unwrap<CanvasRenderingContext2D>(info.This());
 
     v8::String::Utf8Value text(value);
     std::string font(*text, text.length());
 
-    canvas::FontDeclaration declaration = canvas::parse_short_font(font);
+    FontCache::Font resolvedFont = FontCache::GetFont(font);
 
-    contextObj->Set(JS_STR("fontFamily"), JS_STR(declaration.fontFamily));
-    contextObj->Set(JS_STR("fontStyle"), JS_STR(declaration.fontStyle));
-    contextObj->Set(JS_STR("fontVariant"), JS_STR(declaration.fontVariant));
-    contextObj->Set(JS_STR("fontWeight"), JS_STR(declaration.fontWeight));
-    contextObj->Set(JS_STR("fontSize"), JS_STR(declaration.fontSize));
-    contextObj->Set(JS_STR("lineHeight"), JS_STR(declaration.lineHeight));
+    context->strokePaint.setTypeface(resolvedFont.typeface);
+    context->fillPaint.setTypeface(resolvedFont.typeface);
+    if (!std::isnan(resolvedFont.textSize)) {
+      context->strokePaint.setTextSize(resolvedFont.textSize);
+      context->fillPaint.setTextSize(resolvedFont.textSize);
+    }
+    if (!std::isnan(resolvedFont.lineHeight)) {
+      context->lineHeight = resolvedFont.lineHeight;
+    }
   } else {
     Nan::ThrowError("font: invalid arguments");
   }
@@ -487,8 +711,9 @@ NAN_SETTER(CanvasRenderingContext2D::FontFamilySetter) {
 
     SkTypeface *typeface = context->strokePaint.getTypeface();
     SkFontStyle fontStyle = typeface ? typeface->fontStyle() : SkFontStyle();
-    context->strokePaint.setTypeface(SkTypeface::MakeFromName(fontFamily.c_str(), fontStyle));
-    context->fillPaint.setTypeface(SkTypeface::MakeFromName(fontFamily.c_str(), fontStyle));
+    sk_sp<SkTypeface> newTypeface = FontCache::GetTypeface(fontFamily, fontStyle);
+    context->strokePaint.setTypeface(newTypeface);
+    context->fillPaint.setTypeface(newTypeface);
   } else {
     Nan::ThrowError("fontFamily: invalid arguments");
   }
@@ -539,16 +764,13 @@ NAN_SETTER(CanvasRenderingContext2D::FontWeightSetter) {
     SkFontStyle oldFontStyle = typeface ? typeface->fontStyle() : SkFontStyle();
     SkFontStyle fontStyle(fontWeight, oldFontStyle.width(), oldFontStyle.slant());
 
-    const char *familyNameString;
+    SkString familyName;
     if (typeface) {
-      SkString familyName;
       typeface->getFamilyName(&familyName);
-      familyNameString = familyName.c_str();
-    } else {
-      familyNameString = nullptr;
     }
-    context->strokePaint.setTypeface(SkTypeface::MakeFromName(familyNameString, fontStyle));
-    context->fillPaint.setTypeface(SkTypeface::MakeFromName(familyNameString, fontStyle));
+    sk_sp<SkTypeface> newTypeface = FontCache::GetTypeface(familyName.c_str(), fontStyle);
+    context->strokePaint.setTypeface(newTypeface);
+    context->fillPaint.setTypeface(newTypeface);
   } else {
     Nan::ThrowError("fontWeight: invalid arguments");
   }
@@ -599,16 +821,13 @@ NAN_SETTER(CanvasRenderingContext2D::FontStyleSetter) {
     SkFontStyle oldFontStyle = typeface ? typeface->fontStyle() : SkFontStyle();
     SkFontStyle fontStyle(oldFontStyle.weight(), oldFontStyle.width(), slant);
 
-    const char *familyNameString;
+    SkString familyName;
     if (typeface) {
-      SkString familyName;
       typeface->getFamilyName(&familyName);
-      familyNameString = familyName.c_str();
-    } else {
-      familyNameString = nullptr;
     }
-    context->strokePaint.setTypeface(SkTypeface::MakeFromName(familyNameString, fontStyle));
-    context->fillPaint.setTypeface(SkTypeface::MakeFromName(familyNameString, fontStyle));
+    sk_sp<SkTypeface> newTypeface = FontCache::GetTypeface(familyName.c_str(), fontStyle);
+    context->strokePaint.setTypeface(newTypeface);
+    context->fillPaint.setTypeface(newTypeface);
   } else {
     Nan::ThrowError("fontStyle: invalid arguments");
   }
@@ -794,7 +1013,7 @@ NAN_METHOD(CanvasRenderingContext2D::MeasureText) {
   std::string text(*textUtf8, textUtf8.length());
 
   Local<Object> result = Object::New(Isolate::GetCurrent());
-  result->Set(JS_STR("width"), JS_FLOAT(context->MeasureText(text)));
+  result->Set(JS_KEY(width), JS_FLOAT(context->MeasureText(text)));
 
   info.GetReturnValue().Set(result);
 }
@@ -826,14 +1045,12 @@ NAN_METHOD(CanvasRenderingContext2D::Stroke) {
 
   CanvasRenderingContext2D *context = ObjectWrap::Unwrap<CanvasRenderingContext2D>(info.This());
 
-  if (info[0]->BooleanValue() && info[0]->ToObject()->Get(JS_STR("constructor"))->ToObject()->Get(JS_STR("name"))->StrictEquals(JS_STR("Path2D"))) {
+  if (info[0]->BooleanValue() && info[0]->ToObject()->Get(JS_KEY(constructor))->ToObject()->Get(JS_KEY(name))->StrictEquals(JS_STR("Path2D"))) {
     Path2D *path2d = ObjectWrap::Unwrap<Path2D>(Local<Object>::Cast(info[0]));
     context->Stroke(*path2d);
   } else {
     context->Stroke();
   }
-
-  context->dataArray.Reset();
 }
 
 NAN_METHOD(CanvasRenderingContext2D::Fill) {
@@ -841,14 +1058,12 @@ NAN_METHOD(CanvasRenderingContext2D::Fill) {
 
   CanvasRenderingContext2D *context = ObjectWrap::Unwrap<CanvasRenderingContext2D>(info.This());
 
-  if (info[0]->BooleanValue() && info[0]->ToObject()->Get(JS_STR("constructor"))->ToObject()->Get(JS_STR("name"))->StrictEquals(JS_STR("Path2D"))) {
+  if (info[0]->BooleanValue() && info[0]->ToObject()->Get(JS_KEY(constructor))->ToObject()->Get(JS_KEY(name))->StrictEquals(JS_STR("Path2D"))) {
     Path2D *path2d = ObjectWrap::Unwrap<Path2D>(Local<Object>::Cast(info[0]));
     context->Fill(*path2d);
   } else {
     context->Fill();
   }
-
-  context->dataArray.Reset();
 }
 
 NAN_METHOD(CanvasRenderingContext2D::MoveTo) {
@@ -869,8 +1084,6 @@ NAN_METHOD(CanvasRenderingContext2D::LineTo) {
   double y = info[1]->NumberValue();
 
   context->LineTo(x, y);
-
-  context->dataArray.Reset();
 }
 
 NAN_METHOD(CanvasRenderingContext2D::Arc) {
@@ -885,8 +1098,6 @@ NAN_METHOD(CanvasRenderingContext2D::Arc) {
   double anticlockwise = info[5]->NumberValue();
 
   context->Arc(x, y, radius, startAngle, endAngle, anticlockwise);
-
-  context->dataArray.Reset();
 }
 
 NAN_METHOD(CanvasRenderingContext2D::ArcTo) {
@@ -900,8 +1111,6 @@ NAN_METHOD(CanvasRenderingContext2D::ArcTo) {
   double radius = info[4]->NumberValue();
 
   context->ArcTo(x1, y1, x2, y2, radius);
-
-  context->dataArray.Reset();
 }
 
 NAN_METHOD(CanvasRenderingContext2D::BezierCurveTo) {
@@ -916,8 +1125,6 @@ NAN_METHOD(CanvasRenderingContext2D::BezierCurveTo) {
   double y = info[5]->NumberValue();
 
   context->BezierCurveTo(x1, y1, x2, y2, x, y);
-
-  context->dataArray.Reset();
 }
 
 NAN_METHOD(CanvasRenderingContext2D::Rect) {
@@ -931,8 +1138,6 @@ NAN_METHOD(CanvasRenderingContext2D::Rect) {
 
   context->Rect(x, y, w, h);
 
-  context->dataArray.Reset();
-
   // info.GetReturnValue().Set(JS_INT(image->GetHeight()));
 }
 
@@ -947,8 +1152,6 @@ NAN_METHOD(CanvasRenderingContext2D::FillRect) {
 
   context->FillRect(x, y, w, h);
 
-  context->dataArray.Reset();
-
   // info.GetReturnValue().Set(JS_INT(image->GetHeight()));
 }
 
@@ -963,8 +1166,6 @@ NAN_METHOD(CanvasRenderingContext2D::StrokeRect) {
 
   context->StrokeRect(x, y, w, h);
 
-  context->dataArray.Reset();
-
   // info.GetReturnValue().Set(JS_INT(image->GetHeight()));
 }
 
@@ -979,8 +1180,6 @@ NAN_METHOD(CanvasRenderingContext2D::ClearRect) {
 
   context->ClearRect(x, y, w, h);
 
-  context->dataArray.Reset();
-
   // info.GetReturnValue().Set(JS_INT(image->GetHeight()));
 }
 
@@ -995,8 +1194,6 @@ NAN_METHOD(CanvasRenderingContext2D::FillText) {
 
   context->FillText(string, x, y);
 
-  context->dataArray.Reset();
-
   // info.GetReturnValue().Set(JS_INT(image->GetHeight()));
 }
 
@@ -1011,8 +1208,6 @@ NAN_METHOD(CanvasRenderingContext2D::StrokeText) {
 
   context->StrokeText(string, x, y);
 
-  context->dataArray.Reset();
-
   // info.GetReturnValue().Set(JS_INT(image->GetHeight()));
 }
 
@@ -1021,7 +1216,7 @@ NAN_METHOD(CanvasRenderingContext2D::CreateLinearGradient) {
     Local<Object> contextObj = Local<Object>::Cast(info.This());
     CanvasRenderingContext2D *context = ObjectWrap::Unwrap<CanvasRenderingContext2D>(contextObj);
 
-    Local<Function> canvasGradientCons = Local<Function>::Cast(contextObj->Get(JS_STR("constructor"))->ToObject()->Get(JS_STR("CanvasGradient")));
+    Local<Function> canvasGradientCons = Local<Function>::Cast(contextObj->Get(JS_KEY(constructor))->ToObject()->Get(JS_STR("CanvasGradient")));
     Local<Value> argv[] = {
       info[0],
       info[1],
@@ -1040,7 +1235,7 @@ NAN_METHOD(CanvasRenderingContext2D::CreateRadialGradient) {
     Local<Object> contextObj = Local<Object>::Cast(info.This());
     CanvasRenderingContext2D *context = ObjectWrap::Unwrap<CanvasRenderingContext2D>(contextObj);
 
-    Local<Function> canvasGradientCons = Local<Function>::Cast(contextObj->Get(JS_STR("constructor"))->ToObject()->Get(JS_STR("CanvasGradient")));
+    Local<Function> canvasGradientCons = Local<Function>::Cast(contextObj->Get(JS_KEY(constructor))->ToObject()->Get(JS_STR("CanvasGradient")));
     Local<Value> argv[] = {
       info[0],
       info[1],
@@ -1061,7 +1256,7 @@ NAN_METHOD(CanvasRenderingContext2D::CreatePattern) {
     Local<Object> contextObj = Local<Object>::Cast(info.This());
     CanvasRenderingContext2D *context = ObjectWrap::Unwrap<CanvasRenderingContext2D>(contextObj);
 
-    Local<Function> canvasPatternCons = Local<Function>::Cast(contextObj->Get(JS_STR("constructor"))->ToObject()->Get(JS_STR("CanvasPattern")));
+    Local<Function> canvasPatternCons = Local<Function>::Cast(contextObj->Get(JS_KEY(constructor))->ToObject()->Get(JS_STR("CanvasPattern")));
     Local<Value> argv[] = {
       info[0],
       info[1],
@@ -1126,8 +1321,6 @@ NAN_METHOD(CanvasRenderingContext2D::DrawImage) {
 
         context->DrawImage(image.get(), 0, 0, sw, sh, x, y, dw, dh, false);
       }
-
-      context->dataArray.Reset();
     }
   } else {
     Nan::ThrowError("drawImage: invalid arguments");
@@ -1142,7 +1335,7 @@ NAN_METHOD(CanvasRenderingContext2D::CreateImageData) {
   double h = info[1]->NumberValue();
 
   Local<Function> imageDataCons = Local<Function>::Cast(
-    Local<Object>::Cast(info.This())->Get(JS_STR("constructor"))->ToObject()->Get(JS_STR("ImageData"))
+    Local<Object>::Cast(info.This())->Get(JS_KEY(constructor))->ToObject()->Get(JS_KEY(ImageData))
   );
   Local<Value> argv[] = {
     Number::New(Isolate::GetCurrent(), w),
@@ -1163,7 +1356,7 @@ NAN_METHOD(CanvasRenderingContext2D::GetImageData) {
   unsigned int h = info[3]->Uint32Value();
 
   Local<Function> imageDataCons = Local<Function>::Cast(
-    Local<Object>::Cast(info.This())->Get(JS_STR("constructor"))->ToObject()->Get(JS_STR("ImageData"))
+    Local<Object>::Cast(info.This())->Get(JS_KEY(constructor))->ToObject()->Get(JS_KEY(ImageData))
   );
   Local<Value> argv[] = {
     Number::New(Isolate::GetCurrent(), w),
@@ -1172,7 +1365,7 @@ NAN_METHOD(CanvasRenderingContext2D::GetImageData) {
   Local<Object> imageDataObj = imageDataCons->NewInstance(Isolate::GetCurrent()->GetCurrentContext(), sizeof(argv)/sizeof(argv[0]), argv).ToLocalChecked();
   ImageData *imageData = ObjectWrap::Unwrap<ImageData>(imageDataObj);
 
-  bool ok = context->surface->getCanvas()->readPixels(imageData->bitmap, x, y);
+  bool ok = context->Rasterize()->readPixels(imageData->bitmap, x, y);
   if (ok) {
     return info.GetReturnValue().Set(imageDataObj);
   } else {
@@ -1197,29 +1390,79 @@ NAN_METHOD(CanvasRenderingContext2D::PutImageData) {
     unsigned int dw = imageData->GetWidth();
     unsigned int dh = imageData->GetHeight();
 
-    context->surface->getCanvas()->save();
-    flipCanvasY(context->surface->getCanvas(), y + dh);
+    context->GetCanvas()->save();
+    flipCanvasY(context->GetCanvas(), y + dh);
 
     sk_sp<SkImage> image = SkImage::MakeFromBitmap(imageData->bitmap);
-    context->DrawImage(image.get(), dirtyX, dirtyY, dirtyWidth, dirtyHeight, x, context->surface->getCanvas()->imageInfo().height() - y - dh, dw, dh, false);
+    context->DrawImage(image.get(), dirtyX, dirtyY, dirtyWidth, dirtyHeight, x, context->GetCanvas()->imageInfo().height() - y - dh, dw, dh, false);
 
-    context->surface->getCanvas()->restore();
+    context->GetCanvas()->restore();
   } else {
     unsigned int sw = imageData->GetWidth();
     unsigned int sh = imageData->GetHeight();
     unsigned int dw = sw;
     unsigned int dh = sh;
 
-    context->surface->getCanvas()->save();
-    flipCanvasY(context->surface->getCanvas(), y + dh);
+    context->GetCanvas()->save();
+    flipCanvasY(context->GetCanvas(), y + dh);
 
     sk_sp<SkImage> image = SkImage::MakeFromBitmap(imageData->bitmap);
-    context->DrawImage(image.get(), 0, 0, sw, sh, x, context->surface->getCanvas()->imageInfo().height() - y - dh, dw, dh, false);
+    context->DrawImage(image.get(), 0, 0, sw, sh, x, context->GetCanvas()->imageInfo().height() - y - dh, dw, dh, false);
 
-    context->surface->getCanvas()->restore();
+    context->GetCanvas()->restore();
   }
 }
 
+NAN_METHOD(CanvasRenderingContext2D::TransferToImageBitmap) {
+  Nan::HandleScope scope;
+
+  CanvasRenderingContext2D *context = ObjectWrap::Unwrap<CanvasRenderingContext2D>(info.This());
+  context->Rasterize();
+
+  sk_sp<SkImage> image = context->surface->makeImageSnapshot();
+  SkBitmap bitmap;
+  SkPixmap pixmap;
+  bool ok;
+  if (image && image->peekPixels(&pixmap)) {
+    // the bitmap holds on to the snapshot's pixels, and the surface draws into new ones from here on
+    SkImage *imageRef = image.release();
+    ok = bitmap.installPixels(pixmap.info(), pixmap.writable_addr(), pixmap.rowBytes(), [](void *addr, void *ref) {
+      ((SkImage *)ref)->unref();
+    }, imageRef);
+    context->surface->notifyContentWillChange(SkSurface::kDiscard_ContentChangeMode);
+  } else {
+    // GPU pixels have to come back to memory
+    SkImageInfo imageInfo = SkImageInfo::Make(context->GetWidth(), context->GetHeight(), SkColorType::kRGBA_8888_SkColorType, SkAlphaType::kPremul_SkAlphaType);
+    ok = image && bitmap.tryAllocPixels(imageInfo) && image->readPixels(bitmap.pixmap(), 0, 0);
+  }
+  if (!ok) {
+    return Nan::ThrowError("transferToImageBitmap: failed to read pixels");
+  }
+
+  // the canvas is left transparent, whatever its clip
+  SkPixmap surfacePixmap;
+  if (context->surface->peekPixels(&surfacePixmap)) {
+    surfacePixmap.erase(SK_ColorTRANSPARENT);
+  } else {
+    SkBitmap blankBitmap;
+    if (blankBitmap.tryAllocPixels(bitmap.info())) {
+      blankBitmap.eraseColor(SK_ColorTRANSPARENT);
+      context->surface->writePixels(blankBitmap, 0, 0);
+    }
+  }
+  context->MarkDirty();
+
+  Local<Function> imageBitmapCons = Local<Function>::Cast(
+    Local<Object>::Cast(info.This())->Get(JS_KEY(constructor))->ToObject()->Get(JS_KEY(ImageBitmap))
+  );
+  Local<Object> imageBitmapObj = imageBitmapCons->NewInstance(Isolate::GetCurrent()->GetCurrentContext(), 0, nullptr).ToLocalChecked();
+  ImageBitmap *imageBitmap = ObjectWrap::Unwrap<ImageBitmap>(imageBitmapObj);
+  bitmap.setImmutable();
+  imageBitmap->bitmap = bitmap;
+
+  info.GetReturnValue().Set(imageBitmapObj);
+}
+
 NAN_METHOD(CanvasRenderingContext2D::Save) {
   Nan::HandleScope scope;
 
@@ -1238,8 +1481,21 @@ NAN_METHOD(CanvasRenderingContext2D::Destroy) {
   // nothing
 }
 
+NAN_METHOD(CanvasRenderingContext2D::SetRecording) {
+  recordingMode = info[0]->BooleanValue();
+}
+
+NAN_METHOD(CanvasRenderingContext2D::SetGpuContext) {
+  if (info[0]->IsArray()) {
+    GLFWwindow *window = (GLFWwindow *)arrayToPointer(Local<Array>::Cast(info[0]));
+    info.GetReturnValue().Set(JS_BOOL(CanvasGpu::Init(window)));
+  } else {
+    Nan::ThrowError("setGpuContext: invalid arguments");
+  }
+}
+
 bool CanvasRenderingContext2D::isImageType(Local<Value> arg) {
-  Local<Value> constructorName = arg->ToObject()->Get(JS_STR("constructor"))->ToObject()->Get(JS_STR("name"));
+  Local<Value> constructorName = arg->ToObject()->Get(JS_KEY(constructor))->ToObject()->Get(JS_KEY(name));
 
   v8::String::Utf8Value utf8Value(constructorName);
   std::string stringValue(*utf8Value, utf8Value.length());
@@ -1249,31 +1505,37 @@ bool CanvasRenderingContext2D::isImageType(Local<Value> arg) {
     stringValue == "HTMLVideoElement" ||
     stringValue == "ImageData" ||
     stringValue == "ImageBitmap" ||
-    stringValue == "HTMLCanvasElement";
+    stringValue == "HTMLCanvasElement" ||
+    stringValue == "OffscreenCanvas";
 }
 
 sk_sp<SkImage> CanvasRenderingContext2D::getImage(Local<Value> arg) {
-  if (arg->ToObject()->Get(JS_STR("constructor"))->ToObject()->Get(JS_STR("name"))->StrictEquals(JS_STR("HTMLImageElement"))) {
-    Image *image = ObjectWrap::Unwrap<Image>(Local<Object>::Cast(arg->ToObject()->Get(JS_STR("image"))));
+  Local<Value> constructorName = arg->ToObject()->Get(JS_KEY(constructor))->ToObject()->Get(JS_KEY(name));
+  if (constructorName->StrictEquals(JS_KEY(HTMLImageElement))) {
+    Image *image = ObjectWrap::Unwrap<Image>(Local<Object>::Cast(arg->ToObject()->Get(JS_KEY(image))));
     return image->image;
-  } else if (arg->ToObject()->Get(JS_STR("constructor"))->ToObject()->Get(JS_STR("name"))->StrictEquals(JS_STR("HTMLVideoElement"))) {
-    auto video = arg->ToObject()->Get(JS_STR("video"));
+  } else if (constructorName->StrictEquals(JS_KEY(HTMLVideoElement))) {
+    auto video = arg->ToObject()->Get(JS_KEY(video));
     if (video->IsObject()) {
-      return getImage(video->ToObject()->Get(JS_STR("imageData")));
+      return getImage(video->ToObject()->Get(JS_KEY(imageData)));
     }
     return nullptr;
-  } else if (arg->ToObject()->Get(JS_STR("constructor"))->ToObject()->Get(JS_STR("name"))->StrictEquals(JS_STR("ImageData"))) {
+  } else if (constructorName->StrictEquals(JS_KEY(ImageData))) {
     ImageData *imageData = ObjectWrap::Unwrap<ImageData>(Local<Object>::Cast(arg));
     return SkImage::MakeFromBitmap(imageData->bitmap);
-  } else if (arg->ToObject()->Get(JS_STR("constructor"))->ToObject()->Get(JS_STR("name"))->StrictEquals(JS_STR("ImageBitmap"))) {
+  } else if (constructorName->StrictEquals(JS_KEY(ImageBitmap))) {
     ImageBitmap *imageBitmap = ObjectWrap::Unwrap<ImageBitmap>(Local<Object>::Cast(arg));
     return SkImage::MakeFromBitmap(imageBitmap->bitmap);
-  } else if (arg->ToObject()->Get(JS_STR("constructor"))->ToObject()->Get(JS_STR("name"))->StrictEquals(JS_STR("HTMLCanvasElement"))) {
-    Local<Value> otherContextObj = arg->ToObject()->Get(JS_STR("_context"));
-    if (otherContextObj->IsObject() && otherContextObj->ToObject()->Get(JS_STR("constructor"))->ToObject()->Get(JS_STR("name"))->StrictEquals(JS_STR("CanvasRenderingContext2D"))) {
+  } else if (
+    constructorName->StrictEquals(JS_KEY(HTMLCanvasElement)) ||
+    constructorName->StrictEquals(JS_KEY(OffscreenCanvas))
+  ) {
+    Local<Value> otherContextObj = arg->ToObject()->Get(JS_KEY(_context));
+    Local<Value> otherContextName = otherContextObj->IsObject() ? otherContextObj->ToObject()->Get(JS_KEY(constructor))->ToObject()->Get(JS_KEY(name)) : Local<Value>::Cast(Nan::Undefined());
+    if (otherContextName->StrictEquals(JS_KEY(CanvasRenderingContext2D))) {
       CanvasRenderingContext2D *otherContext = ObjectWrap::Unwrap<CanvasRenderingContext2D>(Local<Object>::Cast(otherContextObj));
 
-      SkCanvas *canvas = otherContext->surface->getCanvas();
+      SkCanvas *canvas = otherContext->Rasterize();
       SkBitmap bitmap;
       bool ok = bitmap.tryAllocPixels(canvas->imageInfo()) && canvas->readPixels(bitmap, 0, 0);
       if (ok) {
@@ -1282,10 +1544,7 @@ sk_sp<SkImage> CanvasRenderingContext2D::getImage(Local<Value> arg) {
       } else {
         return nullptr;
       }
-    } else if (otherContextObj->IsObject() && (
-      otherContextObj->ToObject()->Get(JS_STR("constructor"))->ToObject()->Get(JS_STR("name"))->StrictEquals(JS_STR("WebGLRenderingContext")) ||
-      otherContextObj->ToObject()->Get(JS_STR("constructor"))->ToObject()->Get(JS_STR("name"))->StrictEquals(JS_STR("WebGL2RenderingContext"))
-    )) {
+    } else if (otherContextName->StrictEquals(JS_KEY(WebGLRenderingContext)) || otherContextName->StrictEquals(JS_KEY(WebGL2RenderingContext))) {
       WebGLRenderingContext *gl = ObjectWrap::Unwrap<WebGLRenderingContext>(Local<Object>::Cast(otherContextObj));
 
       int w, h;
@@ -1315,8 +1574,13 @@ sk_sp<SkImage> CanvasRenderingContext2D::getImage(Local<Value> arg) {
 }
 
 CanvasRenderingContext2D::CanvasRenderingContext2D(unsigned int width, unsigned int height) {
-  SkImageInfo info = SkImageInfo::Make(width, height, SkColorType::kRGBA_8888_SkColorType, SkAlphaType::kPremul_SkAlphaType);
-  surface = SkSurface::MakeRaster(info); // XXX can optimize this to not allocate until a width/height is set
+  surface = MakeSurface(width, height, &gpuTexture); // XXX can optimize this to not allocate until a width/height is set
+  recordedOps = 0;
+  if (recordingMode && surface) {
+    recorder.reset(new SkPictureRecorder());
+    saveLevels.emplace_back();
+    BeginRecording(SkMatrix::I());
+  }
   // flipCanvasY(surface->getCanvas());
 
   strokePaint.setTextSize(12);
@@ -1333,6 +1597,20 @@ CanvasRenderingContext2D::CanvasRenderingContext2D(unsigned int width, unsigned
   clearPaint.setBlendMode(SkBlendMode::kSrc);
 
   lineHeight = 1;
+
+  dataDirtyRect.setEmpty();
+  uploadDirtyRect.setEmpty();
+  uploadVersion = ++nextUploadVersion;
 }
 
-CanvasRenderingContext2D::~CanvasRenderingContext2D () {}
+CanvasRenderingContext2D::~CanvasRenderingContext2D () {
+  if (rasterizing.valid()) {
+    rasterizing.wait();
+  }
+  if (gpuTexture) {
+    // Skia must let go of the texture before it is deleted
+    CanvasGpu::MakeCurrent();
+    surface.reset();
+    CanvasGpu::DeleteTexture(gpuTexture);
+  }
+}
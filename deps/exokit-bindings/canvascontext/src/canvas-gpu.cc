@@ -0,0 +1,88 @@
+#include <canvascontext/include/canvas-gpu.h>
+#include <GrBackendSurface.h>
+#include <gl/GrGLInterface.h>
+
+static GLFWwindow *gpuWindow = nullptr;
+static sk_sp<GrContext> grContext;
+static std::thread::id gpuThread;
+
+bool CanvasGpu::Init(GLFWwindow *sharedWindow) {
+  if (grContext) {
+    return true;
+  }
+
+  GLFWwindow *window = glfw::CreateSharedWindow(sharedWindow);
+  if (!window) {
+    return false;
+  }
+  glfw::SetCurrentWindowContext(window);
+
+  sk_sp<const GrGLInterface> interface = GrGLMakeNativeInterface();
+  sk_sp<GrContext> newGrContext = interface ? GrContext::MakeGL(interface) : nullptr;
+  if (!newGrContext) {
+    glfw::DestroySharedWindow(window);
+    return false;
+  }
+
+  gpuWindow = window;
+  grContext = newGrContext;
+  gpuThread = std::this_thread::get_id();
+  return true;
+}
+
+bool CanvasGpu::IsAvailable() {
+  return std::this_thread::get_id() == gpuThread && grContext;
+}
+
+GLFWwindow *CanvasGpu::GetWindow() {
+  return gpuWindow;
+}
+
+void CanvasGpu::MakeCurrent() {
+  glfw::SetCurrentWindowContext(gpuWindow);
+}
+
+sk_sp<SkSurface> CanvasGpu::MakeSurface(int width, int height, GLuint *texture) {
+  *texture = 0;
+  if (!IsAvailable() || width <= 0 || height <= 0) {
+    return nullptr;
+  }
+
+  MakeCurrent();
+
+  GLuint newTexture;
+  glGenTextures(1, &newTexture);
+  glBindTexture(GL_TEXTURE_2D, newTexture);
+  glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+  glBindTexture(GL_TEXTURE_2D, 0);
+  // Skia caches the texture bindings it made
+  grContext->resetContext(kTextureBinding_GrGLBackendState);
+
+  GrGLTextureInfo textureInfo;
+  textureInfo.fTarget = GL_TEXTURE_2D;
+  textureInfo.fID = newTexture;
+  textureInfo.fFormat = GL_RGBA8;
+  GrBackendTexture backendTexture(width, height, GrMipMapped::kNo, textureInfo);
+  sk_sp<SkSurface> surface = SkSurface::MakeFromBackendTexture(grContext.get(), backendTexture, kTopLeft_GrSurfaceOrigin, 0, kRGBA_8888_SkColorType, nullptr, nullptr);
+  if (surface) {
+    *texture = newTexture;
+  } else {
+    glDeleteTextures(1, &newTexture);
+  }
+  return surface;
+}
+
+void CanvasGpu::DeleteTexture(GLuint texture) {
+  MakeCurrent();
+  glDeleteTextures(1, &texture);
+}
+
+GLsync CanvasGpu::Flush() {
+  MakeCurrent();
+  grContext->flush();
+  GLsync fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+  glFlush();
+  return fence;
+}
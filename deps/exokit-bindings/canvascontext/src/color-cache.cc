@@ -0,0 +1,143 @@
+#include <canvascontext/include/color-cache.h>
+#include <canvascontext/include/lru-cache.h>
+#include <canvas/include/web_color.h>
+
+#include <cctype>
+#include <cstdlib>
+#include <mutex>
+
+namespace {
+
+std::mutex colorsMutex;
+LruCache<std::string, SkColor> colors(256);
+
+int hexDigit(char c) {
+  if (c >= '0' && c <= '9') {
+    return c - '0';
+  } else if (c >= 'a' && c <= 'f') {
+    return c - 'a' + 10;
+  } else if (c >= 'A' && c <= 'F') {
+    return c - 'A' + 10;
+  } else {
+    return -1;
+  }
+}
+
+bool parseHex(const std::string &color, SkColor *result) {
+  if (color.length() != 4 && color.length() != 7) {
+    return false;
+  }
+
+  unsigned int channels[6];
+  for (size_t i = 1; i < color.length(); i++) {
+    int digit = hexDigit(color[i]);
+    if (digit < 0) {
+      return false;
+    }
+    channels[i - 1] = digit;
+  }
+
+  if (color.length() == 4) {
+    *result = SkColorSetARGB(0xFF, channels[0] * 17, channels[1] * 17, channels[2] * 17);
+  } else {
+    *result = SkColorSetARGB(0xFF, (channels[0] << 4) | channels[1], (channels[2] << 4) | channels[3], (channels[4] << 4) | channels[5]);
+  }
+  return true;
+}
+
+void skipSpaces(const char *&s) {
+  while (*s == ' ') {
+    s++;
+  }
+}
+
+// An unsigned integer of up to 3 digits, clamped to 255 like the CSS parser.
+bool parseChannel(const char *&s, unsigned int *result) {
+  skipSpaces(s);
+  unsigned int value = 0;
+  const char *start = s;
+  for (; isdigit((unsigned char)*s); s++) {
+    value = value * 10 + (*s - '0');
+  }
+  if (s == start || s - start > 3) {
+    return false;
+  }
+  *result = value < 255 ? value : 255;
+  skipSpaces(s);
+  return true;
+}
+
+// An unsigned decimal, clamped to 0..1 and scaled like web_color::from_string.
+bool parseAlpha(const char *&s, unsigned int *result) {
+  skipSpaces(s);
+  const char *start = s;
+  while (isdigit((unsigned char)*s)) {
+    s++;
+  }
+  if (*s == '.') {
+    s++;
+    while (isdigit((unsigned char)*s)) {
+      s++;
+    }
+  }
+  if (s == start || (s == start + 1 && *start == '.')) {
+    return false;
+  }
+  float alpha = strtof(std::string(start, s).c_str(), nullptr);
+  if (alpha > 1) {
+    alpha = 1;
+  }
+  *result = (unsigned char)(alpha * 255.0);
+  skipSpaces(s);
+  return true;
+}
+
+bool parseRgb(const std::string &color, SkColor *result) {
+  const char *s = color.c_str();
+  bool hasAlpha;
+  if (color.compare(0, 5, "rgba(") == 0) {
+    hasAlpha = true;
+    s += 5;
+  } else if (color.compare(0, 4, "rgb(") == 0) {
+    hasAlpha = false;
+    s += 4;
+  } else {
+    return false;
+  }
+
+  unsigned int r, g, b, a = 0xFF;
+  if (!parseChannel(s, &r) || *s++ != ',' ||
+      !parseChannel(s, &g) || *s++ != ',' ||
+      !parseChannel(s, &b)) {
+    return false;
+  }
+  if (hasAlpha && (*s++ != ',' || !parseAlpha(s, &a))) {
+    return false;
+  }
+  if (*s++ != ')' || *s != '\0') {
+    return false;
+  }
+
+  *result = SkColorSetARGB(a, r, g, b);
+  return true;
+}
+
+}
+
+SkColor ColorCache::Get(const std::string &color) {
+  SkColor result;
+  if (!color.empty() && color[0] == '#' ? parseHex(color, &result) : parseRgb(color, &result)) {
+    return result;
+  }
+
+  std::lock_guard<std::mutex> lock(colorsMutex);
+
+  if (SkColor *cachedColor = colors.Get(color)) {
+    return *cachedColor;
+  }
+
+  canvas::web_color webColor = canvas::web_color::from_string(color.c_str());
+  result = SkColorSetARGB(webColor.a, webColor.r, webColor.g, webColor.b);
+  colors.Put(color, result);
+  return result;
+}
@@ -0,0 +1,201 @@
+#include <canvascontext/include/font-cache.h>
+#include <canvascontext/include/lru-cache.h>
+#include <canvas/include/web_font.h>
+
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <mutex>
+
+namespace {
+
+struct TypefaceKey {
+  std::string family;
+  int weight;
+  int width;
+  SkFontStyle::Slant slant;
+
+  bool operator==(const TypefaceKey &other) const {
+    return family == other.family && weight == other.weight && width == other.width && slant == other.slant;
+  }
+};
+struct TypefaceKeyHash {
+  size_t operator()(const TypefaceKey &key) const {
+    return std::hash<std::string>()(key.family) ^ ((size_t)key.weight << 8) ^ ((size_t)key.width << 20) ^ ((size_t)key.slant << 24);
+  }
+};
+
+// Everything in the paint that changes the glyphs, their positions or the measured bounds. Alignment is left out;
+// runs are shaped left-aligned and the draw offsets them.
+struct TextRunKey {
+  SkFontID typefaceId;
+  SkScalar textSize;
+  SkScalar textScaleX;
+  SkScalar textSkewX;
+  uint32_t flags;
+  SkPaint::Hinting hinting;
+  SkPaint::Style style;
+  SkScalar strokeWidth;
+  std::string text;
+
+  bool operator==(const TextRunKey &other) const {
+    return typefaceId == other.typefaceId && textSize == other.textSize && textScaleX == other.textScaleX && textSkewX == other.textSkewX &&
+      flags == other.flags && hinting == other.hinting && style == other.style && strokeWidth == other.strokeWidth && text == other.text;
+  }
+};
+struct TextRunKeyHash {
+  size_t operator()(const TextRunKey &key) const {
+    size_t hash = std::hash<std::string>()(key.text);
+    hash = hash * 31 + key.typefaceId;
+    hash = hash * 31 + std::hash<float>()(key.textSize);
+    hash = hash * 31 + std::hash<float>()(key.textScaleX);
+    hash = hash * 31 + std::hash<float>()(key.textSkewX);
+    hash = hash * 31 + key.flags;
+    hash = hash * 31 + (size_t)key.hinting;
+    hash = hash * 31 + (size_t)key.style;
+    hash = hash * 31 + std::hash<float>()(key.strokeWidth);
+    return hash;
+  }
+};
+
+// longer strings are rarely repeated and would crowd out the labels
+const size_t maxCachedTextLength = 256;
+
+std::mutex mutex;
+LruCache<std::string, FontCache::Font> fonts(64);
+LruCache<TypefaceKey, sk_sp<SkTypeface>, TypefaceKeyHash> typefaces(64);
+LruCache<TextRunKey, FontCache::TextRun, TextRunKeyHash> textRuns(512);
+
+// Collapses whitespace, so "bold  12px  serif" and "bold 12px serif" share an entry.
+std::string normalizeFont(const std::string &font) {
+  std::string result;
+  result.reserve(font.size());
+  bool space = false;
+  for (char c : font) {
+    if (isspace((unsigned char)c)) {
+      space = !result.empty();
+    } else {
+      if (space) {
+        result += ' ';
+        space = false;
+      }
+      result += c;
+    }
+  }
+  return result;
+}
+
+int parseFontWeight(const std::string &fontWeight) {
+  if (fontWeight == "bold") {
+    return SkFontStyle::kBold_Weight;
+  } else if (!fontWeight.empty() && isdigit((unsigned char)fontWeight[0])) {
+    return atoi(fontWeight.c_str());
+  } else {
+    return SkFontStyle::kNormal_Weight;
+  }
+}
+
+SkFontStyle::Slant parseFontSlant(const std::string &fontStyle) {
+  if (fontStyle == "italic") {
+    return SkFontStyle::kItalic_Slant;
+  } else if (fontStyle == "oblique") {
+    return SkFontStyle::kOblique_Slant;
+  } else {
+    return SkFontStyle::kUpright_Slant;
+  }
+}
+
+float parseFontNumber(const std::string &value) {
+  char *end;
+  float result = strtof(value.c_str(), &end);
+  return end != value.c_str() ? result : NAN;
+}
+
+sk_sp<SkTypeface> resolveTypeface(const std::string &family, const SkFontStyle &fontStyle) {
+  TypefaceKey key{family, fontStyle.weight(), fontStyle.width(), fontStyle.slant()};
+  if (sk_sp<SkTypeface> *typeface = typefaces.Get(key)) {
+    return *typeface;
+  }
+
+  sk_sp<SkTypeface> typeface = SkTypeface::MakeFromName(family.empty() ? nullptr : family.c_str(), fontStyle);
+  typefaces.Put(key, typeface);
+  return typeface;
+}
+
+FontCache::TextRun shapeText(const SkPaint &paint, const std::string &text) {
+  FontCache::TextRun textRun;
+  textRun.width = paint.measureText(text.c_str(), text.length(), &textRun.bounds);
+
+  int count = paint.textToGlyphs(text.c_str(), text.length(), nullptr);
+  if (count > 0) {
+    // the run keeps the paint's font settings; drawing it takes only color and style from the draw's paint
+    SkPaint runPaint(paint);
+    runPaint.setTextEncoding(SkPaint::kGlyphID_TextEncoding);
+    runPaint.setTextAlign(SkPaint::kLeft_Align);
+    SkTextBlobBuilder builder;
+    const SkTextBlobBuilder::RunBuffer &run = builder.allocRun(runPaint, count, 0, 0);
+    paint.textToGlyphs(text.c_str(), text.length(), run.glyphs);
+    textRun.blob = builder.make();
+  }
+  return textRun;
+}
+
+}
+
+FontCache::Font FontCache::GetFont(const std::string &font) {
+  std::string key = normalizeFont(font);
+
+  std::lock_guard<std::mutex> lock(mutex);
+
+  if (Font *cachedFont = fonts.Get(key)) {
+    return *cachedFont;
+  }
+
+  canvas::FontDeclaration declaration = canvas::parse_short_font(key);
+  SkFontStyle fontStyle(parseFontWeight(declaration.fontWeight), SkFontStyle::kNormal_Width, parseFontSlant(declaration.fontStyle));
+  Font result{
+    resolveTypeface(declaration.fontFamily, fontStyle),
+    parseFontNumber(declaration.fontSize),
+    parseFontNumber(declaration.lineHeight),
+  };
+  fonts.Put(key, result);
+  return result;
+}
+
+sk_sp<SkTypeface> FontCache::GetTypeface(const std::string &family, const SkFontStyle &fontStyle) {
+  std::lock_guard<std::mutex> lock(mutex);
+  return resolveTypeface(family, fontStyle);
+}
+
+FontCache::TextRun FontCache::GetTextRun(const SkPaint &paint, const std::string &text) {
+  if (text.length() > maxCachedTextLength) {
+    return shapeText(paint, text);
+  }
+
+  SkTypeface *typeface = paint.getTypeface();
+  TextRunKey key{
+    typeface ? typeface->uniqueID() : 0,
+    paint.getTextSize(),
+    paint.getTextScaleX(),
+    paint.getTextSkewX(),
+    paint.getFlags(),
+    paint.getHinting(),
+    paint.getStyle(),
+    paint.getStrokeWidth(),
+    text,
+  };
+
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (TextRun *textRun = textRuns.Get(key)) {
+      return *textRun;
+    }
+  }
+
+  // shaped unlocked so other threads' text isn't held up
+  TextRun textRun = shapeText(paint, text);
+
+  std::lock_guard<std::mutex> lock(mutex);
+  textRuns.Put(key, textRun);
+  return textRun;
+}
@@ -151,9 +151,9 @@ NAN_METHOD(Image::New) {
   Image *image = new Image();
   image->Wrap(imageObj);
 
-  Nan::SetAccessor(imageObj, JS_STR("width"), WidthGetter);
-  Nan::SetAccessor(imageObj, JS_STR("height"), HeightGetter);
-  Nan::SetAccessor(imageObj, JS_STR("data"), DataGetter);
+  Nan::SetAccessor(imageObj, JS_KEY(width), WidthGetter);
+  Nan::SetAccessor(imageObj, JS_KEY(height), HeightGetter);
+  Nan::SetAccessor(imageObj, JS_KEY(data), DataGetter);
 
   info.GetReturnValue().Set(imageObj);
 }
@@ -115,14 +115,18 @@ NAN_METHOD(ImageBitmap::New) {
 
         return Nan::ThrowError("Failed to install pixels");
       }
+    } else if (info.Length() == 0) {
+      // filled in natively, as by transferToImageBitmap
+      ImageBitmap *imageBitmap = new ImageBitmap();
+      imageBitmap->Wrap(imageBitmapObj);
     } else {
       return Nan::ThrowError("Invalid arguments");
     }
   }
 
-  Nan::SetAccessor(imageBitmapObj, JS_STR("width"), WidthGetter);
-  Nan::SetAccessor(imageBitmapObj, JS_STR("height"), HeightGetter);
-  Nan::SetAccessor(imageBitmapObj, JS_STR("data"), DataGetter);
+  Nan::SetAccessor(imageBitmapObj, JS_KEY(width), WidthGetter);
+  Nan::SetAccessor(imageBitmapObj, JS_KEY(height), HeightGetter);
+  Nan::SetAccessor(imageBitmapObj, JS_KEY(data), DataGetter);
 
   info.GetReturnValue().Set(imageBitmapObj);
 }
@@ -48,9 +48,9 @@ NAN_METHOD(ImageData::New) {
     ImageData *imageData = new ImageData(width, height);
     imageData->Wrap(imageDataObj);
 
-    Nan::SetAccessor(imageDataObj, JS_STR("width"), WidthGetter);
-    Nan::SetAccessor(imageDataObj, JS_STR("height"), HeightGetter);
-    Nan::SetAccessor(imageDataObj, JS_STR("data"), DataGetter);
+    Nan::SetAccessor(imageDataObj, JS_KEY(width), WidthGetter);
+    Nan::SetAccessor(imageDataObj, JS_KEY(height), HeightGetter);
+    Nan::SetAccessor(imageDataObj, JS_KEY(data), DataGetter);
 
     return info.GetReturnValue().Set(imageDataObj);
   } else {
@@ -0,0 +1,58 @@
+#ifndef _GLFW_FRAME_SCHEDULER_H_
+#define _GLFW_FRAME_SCHEDULER_H_
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace glfw {
+
+// Paces the main loop against a high-resolution clock. The caller sleeps coarsely on the event loop for the
+// returned delay and then calls WaitForFrame to land on the frame boundary.
+class FrameScheduler {
+public:
+  typedef std::chrono::steady_clock Clock;
+
+  static constexpr double DEFAULT_FRAME_RATE = 90;
+  // frames with nothing presented and no input before the loop starts skipping frames
+  static constexpr int IDLE_FRAMES = 90;
+  static constexpr int IDLE_FRAME_SKIP = 4;
+  static constexpr size_t NUM_BUCKETS = 100;
+  static constexpr double BUCKET_MS = 0.5;
+
+  FrameScheduler();
+
+  // 0 means the display rate, which is not known until a window exists.
+  void SetFrameRate(double frameRate);
+  bool HasFrameRate() const { return frameRate > 0; }
+
+  void BeginFrame();
+  // Returns the number of milliseconds to wait before the next BeginFrame.
+  double EndFrame(bool active, bool externallyPaced);
+  void WaitForFrame();
+
+  double GetPercentile(double percentile) const;
+  void ResetFrameTimes();
+
+  bool vsync;
+  bool presentedThisFrame;
+  bool waitedForSwap;
+  // counts every BeginFrame, unlike numFrames
+  uint64_t frameIndex;
+
+  uint32_t histogram[NUM_BUCKETS];
+  uint32_t numFrames;
+  double totalFrameTime;
+  double maxFrameTime;
+
+protected:
+  double frameRate;
+  Clock::time_point frameStart;
+  Clock::time_point nextFrame;
+  bool started;
+  int idleFrames;
+};
+
+}
+
+#endif
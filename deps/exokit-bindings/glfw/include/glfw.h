@@ -16,11 +16,21 @@
 #include <GLFW/glfw3.h>
 
 #include <webgl.h>
+#include <input-queue.h>
+#include <render-target-pool.h>
+#include <frame-scheduler.h>
+#include <swap-stats.h>
+#include <present-thread.h>
+#include <gpu-timer.h>
 
 using namespace v8;
 
 namespace glfw {
   void SetCurrentWindowContext(GLFWwindow *window);
+  // Hidden 1x1 window whose context shares textures with sharedWindow's share group.
+  GLFWwindow *CreateSharedWindow(GLFWwindow *sharedWindow);
+  void DestroySharedWindow(GLFWwindow *window);
+  bool IsSameShareGroup(GLFWwindow *a, GLFWwindow *b);
 }
 
 // Local<Object> makeGlfw();
@@ -0,0 +1,42 @@
+#ifndef _GLFW_GPU_TIMER_H_
+#define _GLFW_GPU_TIMER_H_
+
+#include <map>
+#include <mutex>
+
+// expects the GL and GLFW headers to already be included (see glfw.h)
+
+namespace glfw {
+
+// Measures GPU time between Begin and End with a small ring of timestamp query pairs per window, so reading a
+// result never stalls on the GPU; measurements arrive a frame or more late. Does nothing on contexts
+// without timer queries.
+class GpuTimer {
+public:
+  static constexpr size_t NUM_QUERIES = 4;
+
+  // The window's context must be current for all of these.
+  void Begin(GLFWwindow *window);
+  // Returns the newest finished measurement in milliseconds, or -1 if there is none yet.
+  double End(GLFWwindow *window);
+  // Drops the state of a window whose context is gone, without touching GL.
+  void Forget(GLFWwindow *window);
+
+protected:
+  struct State {
+    // begin and end timestamps
+    GLuint queries[NUM_QUERIES][2];
+    size_t next;
+    size_t pending;
+    bool running;
+  };
+
+  State *GetState(GLFWwindow *window);
+
+  std::mutex mutex;
+  std::map<GLFWwindow *, State> states;
+};
+
+}
+
+#endif
@@ -0,0 +1,83 @@
+#ifndef _GLFW_INPUT_QUEUE_H_
+#define _GLFW_INPUT_QUEUE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <vector>
+
+namespace glfw {
+
+enum InputEventType {
+  INPUT_NONE = 0,
+  INPUT_MOUSEMOVE,
+  INPUT_MOUSEDOWN,
+  INPUT_MOUSEUP,
+  INPUT_CLICK,
+  INPUT_WHEEL,
+  INPUT_MOUSEENTER,
+  INPUT_KEYDOWN,
+  INPUT_KEYUP,
+  INPUT_KEYPRESS,
+  INPUT_WINDOW_POS,
+  INPUT_RESIZE,
+  INPUT_FRAMEBUFFER_RESIZE,
+  INPUT_REFRESH,
+  INPUT_ICONIFIED,
+  INPUT_FOCUS,
+  INPUT_QUIT,
+  INPUT_DROP,
+};
+
+// Record layout as seen from JS (one Float64Array row per event):
+// [type, windowHandle[0], windowHandle[1], a, b, c, d, mods]
+//   mousemove: clientX, clientY, movementX, movementY
+//   mousedown/mouseup/click: button, clientX, clientY
+//   wheel: deltaX, deltaY
+//   mouseenter/iconified/focus: flag
+//   keydown/keyup/keypress: which, keyCode, charCode
+//   window_pos/resize/framebuffer_resize: x/width, y/height
+//   drop: none; the paths are taken with TakeDrop in the same order
+struct InputEvent {
+  static constexpr size_t STRIDE = 8;
+
+  uint32_t type;
+  void *window;
+  double a;
+  double b;
+  double c;
+  double d;
+  uint32_t mods;
+};
+
+// Ring filled by the GLFW callbacks during glfwPollEvents and drained once per frame.
+// Consecutive cursor moves and scrolls for the same window are merged unless raw input is requested; nothing
+// else is ever dropped, so the ring grows if the frame loop falls behind.
+class InputQueue {
+public:
+  static constexpr size_t INITIAL_CAPACITY = 1024;
+
+  void Push(const InputEvent &event);
+  // Queues a drop event along with its paths.
+  void PushDrop(void *window, std::vector<std::string> paths);
+  // Writes up to maxEvents rows into out and returns the number written; anything left stays queued.
+  size_t Drain(double *out, size_t maxEvents);
+  // Paths of the oldest drained drop event.
+  std::vector<std::string> TakeDrop();
+  size_t Size() const { return count; }
+  void Clear() { head = 0; count = 0; drops.clear(); }
+
+  bool enabled = false;
+  bool raw = false;
+
+protected:
+  std::vector<InputEvent> events = std::vector<InputEvent>(INITIAL_CAPACITY);
+  size_t head = 0;
+  size_t count = 0;
+  std::deque<std::vector<std::string>> drops;
+};
+
+}
+
+#endif
@@ -0,0 +1,48 @@
+#ifndef _GLFW_PRESENT_THREAD_H_
+#define _GLFW_PRESENT_THREAD_H_
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <set>
+#include <thread>
+
+// expects the GL and GLFW headers to already be included (see glfw.h)
+
+namespace glfw {
+
+// Swaps windows off the JS thread. The JS thread fences its frame, releases the window's context and
+// queues the window; the present thread takes the context, waits for the fence and swaps. The JS thread
+// must call Wait before making that context current again.
+class PresentThread {
+public:
+  explicit PresentThread(SwapStats *swapStats);
+  ~PresentThread();
+
+  // The window's context must be current on the calling thread; it is released by this call.
+  void Present(GLFWwindow *window, uint64_t frameIndex);
+  void Wait(GLFWwindow *window);
+  bool IsPending(GLFWwindow *window);
+
+protected:
+  struct Job {
+    GLFWwindow *window;
+    GLsync fence;
+    uint64_t frameIndex;
+  };
+
+  void Run();
+
+  SwapStats *swapStats;
+  std::thread thread;
+  std::mutex mutex;
+  std::condition_variable jobsCv;
+  std::condition_variable doneCv;
+  std::deque<Job> jobs;
+  std::set<GLFWwindow *> pending;
+  bool live;
+};
+
+}
+
+#endif
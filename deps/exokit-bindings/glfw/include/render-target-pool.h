@@ -0,0 +1,55 @@
+#ifndef _GLFW_RENDER_TARGET_POOL_H_
+#define _GLFW_RENDER_TARGET_POOL_H_
+
+#include <deque>
+#include <map>
+
+// expects the GL headers to already be included (see glfw.h)
+
+namespace glfw {
+
+// Render target textures keyed by share group, size, format and sample count, so that iframes coming and going
+// reuse existing storage instead of reallocating it.
+// All calls must be made with a context of the given share group current.
+class RenderTargetPool {
+public:
+  struct Key {
+    void *shareGroup;
+    int width;
+    int height;
+    GLenum internalformat;
+    int samples;
+
+    bool operator==(const Key &other) const;
+  };
+
+  static constexpr size_t MAX_FREE_TEXTURES = 16;
+
+  // Returns a texture with storage matching key. If name is nonzero, storage is allocated into that name instead of reusing one.
+  GLuint Acquire(const Key &key, GLuint name = 0);
+  // Reallocates the storage of a texture handed out by Acquire at a new size, keeping its name, so other contexts
+  // sharing the name see the new storage. Returns false if the pool did not hand the texture out.
+  bool Resize(void *shareGroup, GLuint tex, int width, int height);
+  // Returns the texture to the pool; textures the pool did not hand out are deleted.
+  void Release(void *shareGroup, GLuint tex);
+  // Drops all bookkeeping for a share group whose contexts are gone, without touching GL.
+  void Forget(void *shareGroup);
+
+  // Rounds a requested sample count down to 0/2/4/8 within GL_MAX_SAMPLES.
+  static int GetSamples(int samples);
+
+protected:
+  struct Entry {
+    Key key;
+    GLuint tex;
+  };
+
+  void Allocate(const Key &key, GLuint tex);
+
+  std::deque<Entry> freeTextures;
+  std::map<std::pair<void *, GLuint>, Key> liveTextures;
+};
+
+}
+
+#endif
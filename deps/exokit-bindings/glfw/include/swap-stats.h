@@ -0,0 +1,51 @@
+#ifndef _GLFW_SWAP_STATS_H_
+#define _GLFW_SWAP_STATS_H_
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <mutex>
+
+// expects the GL and GLFW headers to already be included (see glfw.h)
+
+namespace glfw {
+
+// Records when each window's buffers were actually swapped, on whichever thread swaps them, to report
+// swap intervals and missed vertical blanks. Only intervals between swaps of consecutive loop frames
+// count towards missed vsyncs; a window that had nothing to present for a while is idle, not late.
+class SwapStats {
+public:
+  typedef std::chrono::steady_clock Clock;
+
+  struct Stats {
+    uint32_t swaps;
+    uint32_t missedVsyncs;
+    // milliseconds between the last two swaps, or 0
+    double lastInterval;
+  };
+
+  SwapStats();
+
+  // 0 means unknown, in which case no vsyncs are counted as missed.
+  void SetRefreshRate(double refreshRate);
+  bool HasRefreshRate() const { return refreshRate > 0; }
+
+  void RecordSwap(GLFWwindow *window, uint64_t frameIndex);
+  Stats Get(GLFWwindow *window);
+  void Forget(GLFWwindow *window);
+
+protected:
+  struct State {
+    Clock::time_point lastSwap;
+    uint64_t lastFrameIndex;
+    Stats stats;
+  };
+
+  std::mutex mutex;
+  double refreshRate;
+  std::map<GLFWwindow *, State> states;
+};
+
+}
+
+#endif
@@ -0,0 +1,94 @@
+#include <algorithm>
+#include <cstring>
+#include <thread>
+
+#include <frame-scheduler.h>
+
+namespace glfw {
+
+FrameScheduler::FrameScheduler() : vsync(false), presentedThisFrame(false), waitedForSwap(false), frameIndex(0), numFrames(0), totalFrameTime(0), maxFrameTime(0), frameRate(0), started(false), idleFrames(0) {
+  memset(histogram, 0, sizeof(histogram));
+}
+
+void FrameScheduler::SetFrameRate(double frameRate) {
+  this->frameRate = frameRate;
+}
+
+void FrameScheduler::BeginFrame() {
+  Clock::time_point now = Clock::now();
+
+  if (started) {
+    double frameTime = std::chrono::duration<double, std::milli>(now - frameStart).count();
+    size_t bucket = std::min<size_t>((size_t)(frameTime / BUCKET_MS), NUM_BUCKETS - 1);
+    histogram[bucket]++;
+    numFrames++;
+    totalFrameTime += frameTime;
+    maxFrameTime = std::max(maxFrameTime, frameTime);
+  } else {
+    started = true;
+  }
+
+  frameStart = now;
+  frameIndex++;
+  presentedThisFrame = false;
+  waitedForSwap = false;
+}
+
+double FrameScheduler::EndFrame(bool active, bool externallyPaced) {
+  Clock::time_point now = Clock::now();
+
+  if (presentedThisFrame || active) {
+    idleFrames = 0;
+  } else {
+    idleFrames++;
+  }
+
+  if (externallyPaced || waitedForSwap) {
+    // the swap or the compositor already waited for the display
+    nextFrame = now;
+    return 0;
+  }
+
+  double frameTime = 1000.0 / (frameRate > 0 ? frameRate : DEFAULT_FRAME_RATE);
+  if (idleFrames > IDLE_FRAMES) {
+    frameTime *= IDLE_FRAME_SKIP;
+  }
+  nextFrame = frameStart + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double, std::milli>(frameTime));
+  if (nextFrame <= now) {
+    // running behind; start the next frame right away rather than trying to catch up
+    nextFrame = now;
+    return 0;
+  }
+  return std::chrono::duration<double, std::milli>(nextFrame - now).count();
+}
+
+void FrameScheduler::WaitForFrame() {
+  if (nextFrame > Clock::now()) {
+    std::this_thread::sleep_until(nextFrame);
+  }
+}
+
+double FrameScheduler::GetPercentile(double percentile) const {
+  if (numFrames == 0) {
+    return 0;
+  }
+
+  uint32_t target = (uint32_t)(numFrames * percentile);
+  uint32_t count = 0;
+  for (size_t i = 0; i < NUM_BUCKETS; i++) {
+    count += histogram[i];
+    if (count > target) {
+      return (i + 1) * BUCKET_MS;
+    }
+  }
+  return NUM_BUCKETS * BUCKET_MS;
+}
+
+void FrameScheduler::ResetFrameTimes() {
+  memset(histogram, 0, sizeof(histogram));
+  numFrames = 0;
+  totalFrameTime = 0;
+  maxFrameTime = 0;
+}
+
+}
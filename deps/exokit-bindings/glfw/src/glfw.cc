@@ -47,7 +47,7 @@ NAN_METHOD(GetMonitors) {
     js_monitor->Set(JS_STR("is_primary"), JS_BOOL(monitors[i] == primary));
     js_monitor->Set(JS_STR("index"), JS_INT(i));
 
-    js_monitor->Set(JS_STR("name"), JS_STR(glfwGetMonitorName(monitors[i])));
+    js_monitor->Set(JS_KEY(name), JS_STR(glfwGetMonitorName(monitors[i])));
 
     glfwGetMonitorPos(monitors[i], &xpos, &ypos);
     js_monitor->Set(JS_STR("pos_x"), JS_INT(xpos));
@@ -58,16 +58,16 @@ NAN_METHOD(GetMonitors) {
     js_monitor->Set(JS_STR("height_mm"), JS_INT(height));
 
     mode = glfwGetVideoMode(monitors[i]);
-    js_monitor->Set(JS_STR("width"), JS_INT(mode->width));
-    js_monitor->Set(JS_STR("height"), JS_INT(mode->height));
+    js_monitor->Set(JS_KEY(width), JS_INT(mode->width));
+    js_monitor->Set(JS_KEY(height), JS_INT(mode->height));
     js_monitor->Set(JS_STR("rate"), JS_INT(mode->refreshRate));
 
     modes = glfwGetVideoModes(monitors[i], &mode_count);
     js_modes = Nan::New<Array>(mode_count);
     for(j=0; j<mode_count; j++){
       js_mode = Nan::New<Object>();
-      js_mode->Set(JS_STR("width"), JS_INT(modes[j].width));
-      js_mode->Set(JS_STR("height"), JS_INT(modes[j].height));
+      js_mode->Set(JS_KEY(width), JS_INT(modes[j].width));
+      js_mode->Set(JS_KEY(height), JS_INT(modes[j].height));
       js_mode->Set(JS_STR("rate"), JS_INT(modes[j].refreshRate));
       // NOTE: Are color bits necessary?
       js_modes->Set(JS_INT(j), js_mode);
@@ -81,9 +81,24 @@ NAN_METHOD(GetMonitors) {
 }
 
 /* @Module: Window handling */
-GLFWwindow *currentWindow = nullptr;
+// GL contexts are current per thread, so a worker isolate rendering on its own thread keeps its own cache
+thread_local GLFWwindow *currentWindow = nullptr;
+// GLFW only allows window creation and event polling on the main thread
+std::thread::id mainThreadId;
+SwapStats swapStats;
+PresentThread presentThread(&swapStats);
+bool asyncPresent = false;
+// The state below is main thread only, without locking: the GLFW callbacks feeding it run from glfwPollEvents there,
+// the present thread never touches it, and the methods using it refuse other threads (see IsMainThread).
+FrameScheduler frameScheduler;
+std::map<GLFWwindow *, int> swapIntervals;
 int lastX = 0, lastY = 0; // XXX track this per-window
 std::unique_ptr<Nan::Persistent<Function>> eventHandler;
+InputQueue inputQueue;
+
+bool IsMainThread() {
+  return std::this_thread::get_id() == mainThreadId;
+}
 
 void NAN_INLINE(CallEmitter(int argc, Local<Value> argv[])) {
   if (eventHandler && !(*eventHandler).IsEmpty()) {
@@ -92,15 +107,47 @@ void NAN_INLINE(CallEmitter(int argc, Local<Value> argv[])) {
   }
 }
 
+// Returns true if the event was queued for the next drain instead of being emitted immediately.
+// cursor and scroll callbacks don't get the modifier state
+int getKeyMods(GLFWwindow *window) {
+  int mods = 0;
+  if (glfwGetKey(window, GLFW_KEY_LEFT_CONTROL) == GLFW_PRESS || glfwGetKey(window, GLFW_KEY_RIGHT_CONTROL) == GLFW_PRESS) {
+    mods |= GLFW_MOD_CONTROL;
+  }
+  if (glfwGetKey(window, GLFW_KEY_LEFT_SHIFT) == GLFW_PRESS || glfwGetKey(window, GLFW_KEY_RIGHT_SHIFT) == GLFW_PRESS) {
+    mods |= GLFW_MOD_SHIFT;
+  }
+  if (glfwGetKey(window, GLFW_KEY_LEFT_ALT) == GLFW_PRESS || glfwGetKey(window, GLFW_KEY_RIGHT_ALT) == GLFW_PRESS) {
+    mods |= GLFW_MOD_ALT;
+  }
+  if (glfwGetKey(window, GLFW_KEY_LEFT_SUPER) == GLFW_PRESS || glfwGetKey(window, GLFW_KEY_RIGHT_SUPER) == GLFW_PRESS) {
+    mods |= GLFW_MOD_SUPER;
+  }
+  return mods;
+}
+
+inline bool QueueInput(GLFWwindow *window, InputEventType type, double a = 0, double b = 0, double c = 0, double d = 0, int mods = 0) {
+  if (inputQueue.enabled) {
+    inputQueue.Push(InputEvent{(uint32_t)type, window, a, b, c, d, (uint32_t)mods});
+    return true;
+  } else {
+    return false;
+  }
+}
+
 /* Window callbacks handling */
 void APIENTRY windowPosCB(GLFWwindow *window, int xpos, int ypos) {
+  if (QueueInput(window, INPUT_WINDOW_POS, xpos, ypos)) {
+    return;
+  }
+
   Nan::HandleScope scope;
 
   Local<Object> evt = Nan::New<Object>();
-  evt->Set(JS_STR("type"),JS_STR("window_pos"));
-  evt->Set(JS_STR("xpos"),JS_INT(xpos));
-  evt->Set(JS_STR("ypos"),JS_INT(ypos));
-  evt->Set(JS_STR("windowHandle"), pointerToArray(window));
+  evt->Set(JS_KEY(type),JS_STR("window_pos"));
+  evt->Set(JS_KEY(xpos),JS_INT(xpos));
+  evt->Set(JS_KEY(ypos),JS_INT(ypos));
+  evt->Set(JS_KEY(windowHandle), pointerToArray(window));
 
   Local<Value> argv[] = {
     JS_STR("window_pos"), // event name
@@ -110,38 +157,52 @@ void APIENTRY windowPosCB(GLFWwindow *window, int xpos, int ypos) {
 }
 
 void APIENTRY windowSizeCB(GLFWwindow *window, int w, int h) {
+  if (QueueInput(window, INPUT_RESIZE, w, h)) {
+    return;
+  }
+
   Nan::HandleScope scope;
 
   Local<Object> evt = Nan::New<Object>();
-  evt->Set(JS_STR("type"),JS_STR("resize"));
-  evt->Set(JS_STR("width"),JS_INT(w));
-  evt->Set(JS_STR("height"),JS_INT(h));
-  evt->Set(JS_STR("windowHandle"), pointerToArray(window));
+  evt->Set(JS_KEY(type),JS_KEY(resize));
+  evt->Set(JS_KEY(width),JS_INT(w));
+  evt->Set(JS_KEY(height),JS_INT(h));
+  evt->Set(JS_KEY(windowHandle), pointerToArray(window));
 
   Local<Value> argv[] = {
-    JS_STR("windowResize"), // event name
+    JS_KEY(windowResize), // event name
     evt,
   };
   CallEmitter(sizeof(argv)/sizeof(argv[0]), argv);
 }
 
 void APIENTRY windowFramebufferSizeCB(GLFWwindow *window, int w, int h) {
+  if (QueueInput(window, INPUT_FRAMEBUFFER_RESIZE, w, h)) {
+    return;
+  }
+
   Nan::HandleScope scope;
 
   Local<Object> evt = Nan::New<Object>();
-  evt->Set(JS_STR("type"),JS_STR("framebuffer_resize"));
-  evt->Set(JS_STR("width"),JS_INT(w));
-  evt->Set(JS_STR("height"),JS_INT(h));
-  evt->Set(JS_STR("windowHandle"), pointerToArray(window));
+  evt->Set(JS_KEY(type),JS_STR("framebuffer_resize"));
+  evt->Set(JS_KEY(width),JS_INT(w));
+  evt->Set(JS_KEY(height),JS_INT(h));
+  evt->Set(JS_KEY(windowHandle), pointerToArray(window));
 
   Local<Value> argv[] = {
-    JS_STR("framebufferResize"), // event name
+    JS_KEY(framebufferResize), // event name
     evt,
   };
   CallEmitter(sizeof(argv)/sizeof(argv[0]), argv);
 }
 
 void APIENTRY windowDropCB(GLFWwindow *window, int count, const char **paths) {
+  if (inputQueue.enabled) {
+    // queued like the input around it, so it reaches JS in order
+    inputQueue.PushDrop(window, std::vector<std::string>(paths, paths + count));
+    return;
+  }
+
   Nan::HandleScope scope;
 
   Local<Array> pathsArray = Nan::New<Array>(count);
@@ -150,8 +211,8 @@ void APIENTRY windowDropCB(GLFWwindow *window, int count, const char **paths) {
   }
 
   Local<Object> evt = Nan::New<Object>();
-  evt->Set(JS_STR("windowHandle"), pointerToArray(window));
-  evt->Set(JS_STR("paths"), pathsArray);
+  evt->Set(JS_KEY(windowHandle), pointerToArray(window));
+  evt->Set(JS_KEY(paths), pathsArray);
 
   Local<Value> argv[] = {
     JS_STR("drop"), // event name
@@ -161,10 +222,14 @@ void APIENTRY windowDropCB(GLFWwindow *window, int count, const char **paths) {
 }
 
 void APIENTRY windowCloseCB(GLFWwindow *window) {
+  if (QueueInput(window, INPUT_QUIT)) {
+    return;
+  }
+
   Nan::HandleScope scope;
 
   Local<Object> evt = Nan::New<Object>();
-  evt->Set(JS_STR("windowHandle"), pointerToArray(window));
+  evt->Set(JS_KEY(windowHandle), pointerToArray(window));
 
   Local<Value> argv[] = {
     JS_STR("quit"), // event name
@@ -174,44 +239,56 @@ void APIENTRY windowCloseCB(GLFWwindow *window) {
 }
 
 void APIENTRY windowRefreshCB(GLFWwindow *window) {
+  if (QueueInput(window, INPUT_REFRESH)) {
+    return;
+  }
+
   Nan::HandleScope scope;
 
   Local<Object> evt = Nan::New<Object>();
-  evt->Set(JS_STR("type"),JS_STR("refresh"));
-  evt->Set(JS_STR("windowHandle"), pointerToArray(window));
+  evt->Set(JS_KEY(type),JS_KEY(refresh));
+  evt->Set(JS_KEY(windowHandle), pointerToArray(window));
 
   Local<Value> argv[] = {
-    JS_STR("refresh"), // event name
+    JS_KEY(refresh), // event name
     evt,
   };
   CallEmitter(sizeof(argv)/sizeof(argv[0]), argv);
 }
 
 void APIENTRY windowIconifyCB(GLFWwindow *window, int iconified) {
+  if (QueueInput(window, INPUT_ICONIFIED, iconified)) {
+    return;
+  }
+
   Nan::HandleScope scope;
 
   Local<Object> evt = Nan::New<Object>();
-  evt->Set(JS_STR("type"),JS_STR("iconified"));
-  evt->Set(JS_STR("iconified"),JS_BOOL(iconified));
-  evt->Set(JS_STR("windowHandle"), pointerToArray(window));
+  evt->Set(JS_KEY(type),JS_KEY(iconified));
+  evt->Set(JS_KEY(iconified),JS_BOOL(iconified));
+  evt->Set(JS_KEY(windowHandle), pointerToArray(window));
 
   Local<Value> argv[] = {
-    JS_STR("iconified"), // event name
+    JS_KEY(iconified), // event name
     evt,
   };
   CallEmitter(sizeof(argv)/sizeof(argv[0]), argv);
 }
 
 void APIENTRY windowFocusCB(GLFWwindow *window, int focused) {
+  if (QueueInput(window, INPUT_FOCUS, focused)) {
+    return;
+  }
+
   Nan::HandleScope scope;
 
   Local<Object> evt = Nan::New<Object>();
-  evt->Set(JS_STR("type"),JS_STR("focused"));
-  evt->Set(JS_STR("focused"),JS_BOOL(focused));
-  evt->Set(JS_STR("windowHandle"), pointerToArray(window));
+  evt->Set(JS_KEY(type),JS_KEY(focused));
+  evt->Set(JS_KEY(focused),JS_BOOL(focused));
+  evt->Set(JS_KEY(windowHandle), pointerToArray(window));
 
   Local<Value> argv[] = {
-    JS_STR("focus"), // event name
+    JS_KEY(focus), // event name
     evt,
   };
   CallEmitter(sizeof(argv)/sizeof(argv[0]), argv);
@@ -293,8 +370,6 @@ static int jsKeyCode[]={
 const char *actionNames = "keyup\0  keydown\0keypress";
 void APIENTRY keyCB(GLFWwindow *window, int key, int scancode, int action, int mods) {
   if (key >= 0) { // media keys are -1
-    Nan::HandleScope scope;
-
     bool isPrintable = true;
     switch (key) {
       case GLFW_KEY_ESCAPE:
@@ -455,22 +530,27 @@ void APIENTRY keyCB(GLFWwindow *window, int key, int scancode, int action, int m
 
     int which = key;
 
-    Local<Object> evt = Nan::New<Object>();
-    evt->Set(JS_STR("type"), JS_STR(&actionNames[action << 3]));
-    evt->Set(JS_STR("ctrlKey"), JS_BOOL(mods & GLFW_MOD_CONTROL));
-    evt->Set(JS_STR("shiftKey"), JS_BOOL(mods & GLFW_MOD_SHIFT));
-    evt->Set(JS_STR("altKey"), JS_BOOL(mods & GLFW_MOD_ALT));
-    evt->Set(JS_STR("metaKey"), JS_BOOL(mods & GLFW_MOD_SUPER));
-    evt->Set(JS_STR("which"), JS_INT(which));
-    evt->Set(JS_STR("keyCode"), JS_INT(key));
-    evt->Set(JS_STR("charCode"), JS_INT(charCode));
-    evt->Set(JS_STR("windowHandle"), pointerToArray(window));
-
-    Local<Value> argv[] = {
-      JS_STR(&actionNames[action << 3]), // event name
-      evt,
-    };
-    CallEmitter(sizeof(argv)/sizeof(argv[0]), argv);
+    InputEventType type = action == GLFW_RELEASE ? INPUT_KEYUP : (action == GLFW_PRESS ? INPUT_KEYDOWN : INPUT_KEYPRESS);
+    if (!QueueInput(window, type, which, key, charCode, 0, mods)) {
+      Nan::HandleScope scope;
+
+      Local<Object> evt = Nan::New<Object>();
+      evt->Set(JS_KEY(type), JS_STR(&actionNames[action << 3]));
+      evt->Set(JS_KEY(ctrlKey), JS_BOOL(mods & GLFW_MOD_CONTROL));
+      evt->Set(JS_KEY(shiftKey), JS_BOOL(mods & GLFW_MOD_SHIFT));
+      evt->Set(JS_KEY(altKey), JS_BOOL(mods & GLFW_MOD_ALT));
+      evt->Set(JS_KEY(metaKey), JS_BOOL(mods & GLFW_MOD_SUPER));
+      evt->Set(JS_KEY(which), JS_INT(which));
+      evt->Set(JS_KEY(keyCode), JS_INT(key));
+      evt->Set(JS_KEY(charCode), JS_INT(charCode));
+      evt->Set(JS_KEY(windowHandle), pointerToArray(window));
+
+      Local<Value> argv[] = {
+        JS_STR(&actionNames[action << 3]), // event name
+        evt,
+      };
+      CallEmitter(sizeof(argv)/sizeof(argv[0]), argv);
+    }
 
     if (action == GLFW_PRESS && isPrintable) {
       keyCB(window, charCode, scancode, GLFW_REPEAT, mods);
@@ -499,61 +579,76 @@ void APIENTRY cursorPosCB(GLFWwindow* window, double x, double y) {
   lastX = x;
   lastY = y;
 
+  if (QueueInput(window, INPUT_MOUSEMOVE, x, y, movementX, movementY, getKeyMods(window))) {
+    return;
+  }
+
   Nan::HandleScope scope;
 
   Local<Object> evt = Nan::New<Object>();
-  evt->Set(JS_STR("type"),JS_STR("mousemove"));
-  evt->Set(JS_STR("clientX"),JS_NUM(x));
-  evt->Set(JS_STR("clientY"),JS_NUM(y));
-  evt->Set(JS_STR("pageX"),JS_NUM(x));
-  evt->Set(JS_STR("pageY"),JS_NUM(y));
-  evt->Set(JS_STR("movementX"),JS_NUM(movementX));
-  evt->Set(JS_STR("movementY"),JS_NUM(movementY));
-  evt->Set(JS_STR("ctrlKey"),JS_BOOL(glfwGetKey(window, GLFW_KEY_LEFT_CONTROL) == GLFW_PRESS || glfwGetKey(window, GLFW_KEY_RIGHT_CONTROL) == GLFW_PRESS));
-  evt->Set(JS_STR("shiftKey"),JS_BOOL(glfwGetKey(window, GLFW_KEY_LEFT_SHIFT) == GLFW_PRESS || glfwGetKey(window, GLFW_KEY_RIGHT_SHIFT) == GLFW_PRESS));
-  evt->Set(JS_STR("altKey"),JS_BOOL(glfwGetKey(window, GLFW_KEY_LEFT_ALT) == GLFW_PRESS || glfwGetKey(window, GLFW_KEY_RIGHT_ALT) == GLFW_PRESS));
-  evt->Set(JS_STR("metaKey"),JS_BOOL(glfwGetKey(window, GLFW_KEY_LEFT_SUPER) == GLFW_PRESS || glfwGetKey(window, GLFW_KEY_RIGHT_SUPER) == GLFW_PRESS));
-  evt->Set(JS_STR("windowHandle"), pointerToArray(window));
+  evt->Set(JS_KEY(type),JS_KEY(mousemove));
+  evt->Set(JS_KEY(clientX),JS_NUM(x));
+  evt->Set(JS_KEY(clientY),JS_NUM(y));
+  evt->Set(JS_KEY(pageX),JS_NUM(x));
+  evt->Set(JS_KEY(pageY),JS_NUM(y));
+  evt->Set(JS_KEY(movementX),JS_NUM(movementX));
+  evt->Set(JS_KEY(movementY),JS_NUM(movementY));
+  evt->Set(JS_KEY(ctrlKey),JS_BOOL(glfwGetKey(window, GLFW_KEY_LEFT_CONTROL) == GLFW_PRESS || glfwGetKey(window, GLFW_KEY_RIGHT_CONTROL) == GLFW_PRESS));
+  evt->Set(JS_KEY(shiftKey),JS_BOOL(glfwGetKey(window, GLFW_KEY_LEFT_SHIFT) == GLFW_PRESS || glfwGetKey(window, GLFW_KEY_RIGHT_SHIFT) == GLFW_PRESS));
+  evt->Set(JS_KEY(altKey),JS_BOOL(glfwGetKey(window, GLFW_KEY_LEFT_ALT) == GLFW_PRESS || glfwGetKey(window, GLFW_KEY_RIGHT_ALT) == GLFW_PRESS));
+  evt->Set(JS_KEY(metaKey),JS_BOOL(glfwGetKey(window, GLFW_KEY_LEFT_SUPER) == GLFW_PRESS || glfwGetKey(window, GLFW_KEY_RIGHT_SUPER) == GLFW_PRESS));
+  evt->Set(JS_KEY(windowHandle), pointerToArray(window));
 
   Local<Value> argv[] = {
-    JS_STR("mousemove"), // event name
+    JS_KEY(mousemove), // event name
     evt,
   };
   CallEmitter(sizeof(argv)/sizeof(argv[0]), argv);
 }
 
 void APIENTRY cursorEnterCB(GLFWwindow* window, int entered) {
+  if (QueueInput(window, INPUT_MOUSEENTER, entered)) {
+    return;
+  }
+
   Nan::HandleScope scope;
 
   Local<Object> evt = Nan::New<Object>();
-  evt->Set(JS_STR("type"),JS_STR("mouseenter"));
-  evt->Set(JS_STR("entered"),JS_INT(entered));
-  evt->Set(JS_STR("windowHandle"), pointerToArray(window));
+  evt->Set(JS_KEY(type),JS_KEY(mouseenter));
+  evt->Set(JS_KEY(entered),JS_INT(entered));
+  evt->Set(JS_KEY(windowHandle), pointerToArray(window));
 
   Local<Value> argv[] = {
-    JS_STR("mouseenter"), // event name
+    JS_KEY(mouseenter), // event name
     evt,
   };
   CallEmitter(sizeof(argv)/sizeof(argv[0]), argv);
 }
 
 void APIENTRY mouseButtonCB(GLFWwindow *window, int button, int action, int mods) {
+  if (QueueInput(window, action ? INPUT_MOUSEDOWN : INPUT_MOUSEUP, button, lastX, lastY, 0, mods)) {
+    if (!action) {
+      QueueInput(window, INPUT_CLICK, button, lastX, lastY, 0, mods);
+    }
+    return;
+  }
+
   Nan::HandleScope scope;
 
   {
     Local<Object> evt = Nan::New<Object>();
-    evt->Set(JS_STR("type"),JS_STR(action ? "mousedown" : "mouseup"));
-    evt->Set(JS_STR("button"),JS_INT(button));
-    evt->Set(JS_STR("which"),JS_INT(button));
-    evt->Set(JS_STR("clientX"),JS_INT(lastX));
-    evt->Set(JS_STR("clientY"),JS_INT(lastY));
-    evt->Set(JS_STR("pageX"),JS_INT(lastX));
-    evt->Set(JS_STR("pageY"),JS_INT(lastY));
-    evt->Set(JS_STR("shiftKey"),JS_BOOL(mods & GLFW_MOD_SHIFT));
-    evt->Set(JS_STR("ctrlKey"),JS_BOOL(mods & GLFW_MOD_CONTROL));
-    evt->Set(JS_STR("altKey"),JS_BOOL(mods & GLFW_MOD_ALT));
-    evt->Set(JS_STR("metaKey"),JS_BOOL(mods & GLFW_MOD_SUPER));
-    evt->Set(JS_STR("windowHandle"), pointerToArray(window));
+    evt->Set(JS_KEY(type),JS_STR(action ? "mousedown" : "mouseup"));
+    evt->Set(JS_KEY(button),JS_INT(button));
+    evt->Set(JS_KEY(which),JS_INT(button));
+    evt->Set(JS_KEY(clientX),JS_INT(lastX));
+    evt->Set(JS_KEY(clientY),JS_INT(lastY));
+    evt->Set(JS_KEY(pageX),JS_INT(lastX));
+    evt->Set(JS_KEY(pageY),JS_INT(lastY));
+    evt->Set(JS_KEY(shiftKey),JS_BOOL(mods & GLFW_MOD_SHIFT));
+    evt->Set(JS_KEY(ctrlKey),JS_BOOL(mods & GLFW_MOD_CONTROL));
+    evt->Set(JS_KEY(altKey),JS_BOOL(mods & GLFW_MOD_ALT));
+    evt->Set(JS_KEY(metaKey),JS_BOOL(mods & GLFW_MOD_SUPER));
+    evt->Set(JS_KEY(windowHandle), pointerToArray(window));
 
     Local<Value> argv[] = {
       JS_STR(action ? "mousedown" : "mouseup"), // event name
@@ -564,21 +659,21 @@ void APIENTRY mouseButtonCB(GLFWwindow *window, int button, int action, int mods
 
   if (!action) {
     Local<Object> evt = Nan::New<Object>();
-    evt->Set(JS_STR("type"),JS_STR("click"));
-    evt->Set(JS_STR("button"),JS_INT(button));
-    evt->Set(JS_STR("which"),JS_INT(button));
-    evt->Set(JS_STR("clientX"),JS_INT(lastX));
-    evt->Set(JS_STR("clientY"),JS_INT(lastY));
-    evt->Set(JS_STR("pageX"),JS_INT(lastX));
-    evt->Set(JS_STR("pageY"),JS_INT(lastY));
-    evt->Set(JS_STR("shiftKey"),JS_BOOL(mods & GLFW_MOD_SHIFT));
-    evt->Set(JS_STR("ctrlKey"),JS_BOOL(mods & GLFW_MOD_CONTROL));
-    evt->Set(JS_STR("altKey"),JS_BOOL(mods & GLFW_MOD_ALT));
-    evt->Set(JS_STR("metaKey"),JS_BOOL(mods & GLFW_MOD_SUPER));
-    evt->Set(JS_STR("windowHandle"), pointerToArray(window));
+    evt->Set(JS_KEY(type),JS_KEY(click));
+    evt->Set(JS_KEY(button),JS_INT(button));
+    evt->Set(JS_KEY(which),JS_INT(button));
+    evt->Set(JS_KEY(clientX),JS_INT(lastX));
+    evt->Set(JS_KEY(clientY),JS_INT(lastY));
+    evt->Set(JS_KEY(pageX),JS_INT(lastX));
+    evt->Set(JS_KEY(pageY),JS_INT(lastY));
+    evt->Set(JS_KEY(shiftKey),JS_BOOL(mods & GLFW_MOD_SHIFT));
+    evt->Set(JS_KEY(ctrlKey),JS_BOOL(mods & GLFW_MOD_CONTROL));
+    evt->Set(JS_KEY(altKey),JS_BOOL(mods & GLFW_MOD_ALT));
+    evt->Set(JS_KEY(metaKey),JS_BOOL(mods & GLFW_MOD_SUPER));
+    evt->Set(JS_KEY(windowHandle), pointerToArray(window));
 
     Local<Value> argv[] = {
-      JS_STR("click"), // event name
+      JS_KEY(click), // event name
       evt,
     };
     CallEmitter(sizeof(argv)/sizeof(argv[0]), argv);
@@ -586,18 +681,27 @@ void APIENTRY mouseButtonCB(GLFWwindow *window, int button, int action, int mods
 }
 
 void APIENTRY scrollCB(GLFWwindow *window, double xoffset, double yoffset) {
+  int mods = getKeyMods(window);
+  if (QueueInput(window, INPUT_WHEEL, -xoffset*120, -yoffset*120, 0, 0, mods)) {
+    return;
+  }
+
   Nan::HandleScope scope;
 
   Local<Object> evt = Nan::New<Object>();
-  evt->Set(JS_STR("type"),JS_STR("wheel"));
-  evt->Set(JS_STR("deltaX"),JS_NUM(-xoffset*120));
-  evt->Set(JS_STR("deltaY"),JS_NUM(-yoffset*120));
-  evt->Set(JS_STR("deltaZ"),JS_INT(0));
-  evt->Set(JS_STR("deltaMode"),JS_INT(0));
-  evt->Set(JS_STR("windowHandle"), pointerToArray(window));
+  evt->Set(JS_KEY(type),JS_KEY(wheel));
+  evt->Set(JS_KEY(deltaX),JS_NUM(-xoffset*120));
+  evt->Set(JS_KEY(deltaY),JS_NUM(-yoffset*120));
+  evt->Set(JS_KEY(deltaZ),JS_INT(0));
+  evt->Set(JS_KEY(deltaMode),JS_INT(0));
+  evt->Set(JS_KEY(ctrlKey),JS_BOOL(mods & GLFW_MOD_CONTROL));
+  evt->Set(JS_KEY(shiftKey),JS_BOOL(mods & GLFW_MOD_SHIFT));
+  evt->Set(JS_KEY(altKey),JS_BOOL(mods & GLFW_MOD_ALT));
+  evt->Set(JS_KEY(metaKey),JS_BOOL(mods & GLFW_MOD_SUPER));
+  evt->Set(JS_KEY(windowHandle), pointerToArray(window));
 
   Local<Value> argv[] = {
-    JS_STR("wheel"), // event name
+    JS_KEY(wheel), // event name
     evt,
   };
   CallEmitter(sizeof(argv)/sizeof(argv[0]), argv);
@@ -801,6 +905,59 @@ NAN_METHOD(GetJoystickName) {
   info.GetReturnValue().Set(pointerToArray(window));
 } */
 
+// guards the share group and render target bookkeeping, which worker threads rendering into shared contexts also touch
+std::mutex renderTargetMutex;
+RenderTargetPool renderTargetPool;
+std::map<GLFWwindow *, GLFWwindow *> shareGroups;
+
+// Windows created against a shared window use that window's share group, so their textures are interchangeable.
+// Expects renderTargetMutex to be held.
+GLFWwindow *GetShareGroup(GLFWwindow *window) {
+  auto iter = shareGroups.find(window);
+  return iter != shareGroups.end() ? iter->second : window;
+}
+
+void AttachRenderTarget(GLuint fbo, GLenum target, GLuint colorTex, GLuint depthStencilTex) {
+  glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+  glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, target, depthStencilTex, 0);
+  glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, target, colorTex, 0);
+}
+
+void RestoreRenderTargetBindings(WebGLRenderingContext *gl) {
+  if (gl->HasFramebufferBinding(GL_FRAMEBUFFER)) {
+    glBindFramebuffer(GL_FRAMEBUFFER, gl->GetFramebufferBinding(GL_FRAMEBUFFER));
+  } else {
+    glBindFramebuffer(GL_FRAMEBUFFER, gl->defaultFramebuffer);
+  }
+  if (gl->HasTextureBinding(gl->activeTexture, GL_TEXTURE_2D)) {
+    glBindTexture(GL_TEXTURE_2D, gl->GetTextureBinding(gl->activeTexture, GL_TEXTURE_2D));
+  } else {
+    glBindTexture(GL_TEXTURE_2D, 0);
+  }
+  if (gl->HasTextureBinding(gl->activeTexture, GL_TEXTURE_2D_MULTISAMPLE)) {
+    glBindTexture(GL_TEXTURE_2D_MULTISAMPLE, gl->GetTextureBinding(gl->activeTexture, GL_TEXTURE_2D_MULTISAMPLE));
+  } else {
+    glBindTexture(GL_TEXTURE_2D_MULTISAMPLE, 0);
+  }
+  if (gl->HasTextureBinding(gl->activeTexture, GL_TEXTURE_CUBE_MAP)) {
+    glBindTexture(GL_TEXTURE_CUBE_MAP, gl->GetTextureBinding(gl->activeTexture, GL_TEXTURE_CUBE_MAP));
+  } else {
+    glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
+  }
+}
+
+Local<Array> makeRenderTargetArray(GLuint fbo, GLuint colorTex, GLuint depthStencilTex, GLuint msFbo, GLuint msColorTex, GLuint msDepthStencilTex) {
+  Local<Array> array = Array::New(Isolate::GetCurrent(), 6);
+  array->Set(0, JS_NUM(fbo));
+  array->Set(1, JS_NUM(colorTex));
+  array->Set(2, JS_NUM(depthStencilTex));
+  array->Set(3, JS_NUM(msFbo));
+  array->Set(4, JS_NUM(msColorTex));
+  array->Set(5, JS_NUM(msDepthStencilTex));
+  return array;
+}
+
+// With 0 samples there is no multisampled framebuffer: the ms* names alias the resolve target and no resolve is needed.
 NAN_METHOD(CreateRenderTarget) {
   WebGLRenderingContext *gl = ObjectWrap::Unwrap<WebGLRenderingContext>(Local<Object>::Cast(info[0]));
   int width = info[1]->Uint32Value();
@@ -809,8 +966,15 @@ NAN_METHOD(CreateRenderTarget) {
   GLuint sharedDepthStencilTex = info[4]->Uint32Value();
   GLuint sharedMsColorTex = info[5]->Uint32Value();
   GLuint sharedMsDepthStencilTex = info[6]->Uint32Value();
+  int requestedSamples = info[7]->IsNumber() ? info[7]->Int32Value() : 4;
+
+  if (requestedSamples != 0 && requestedSamples != 2 && requestedSamples != 4 && requestedSamples != 8) {
+    return Nan::ThrowError("createRenderTarget: invalid sample count");
+  }
+  const int samples = RenderTargetPool::GetSamples(requestedSamples);
 
-  const int samples = 4;
+  std::lock_guard<std::mutex> lock(renderTargetMutex);
+  GLFWwindow *shareGroup = GetShareGroup(gl->windowHandle);
 
   GLuint fbo;
   GLuint colorTex;
@@ -819,99 +983,42 @@ NAN_METHOD(CreateRenderTarget) {
   GLuint msColorTex;
   GLuint msDepthStencilTex;
 
-  {
-    glGenFramebuffers(1, &msFbo);
-    glBindFramebuffer(GL_FRAMEBUFFER, msFbo);
+  glGenFramebuffers(1, &fbo);
+  depthStencilTex = renderTargetPool.Acquire(RenderTargetPool::Key{shareGroup, width, height, GL_DEPTH24_STENCIL8, 0}, sharedDepthStencilTex);
+  colorTex = renderTargetPool.Acquire(RenderTargetPool::Key{shareGroup, width, height, GL_RGBA8, 0}, sharedColorTex);
+  AttachRenderTarget(fbo, GL_TEXTURE_2D, colorTex, depthStencilTex);
+  GLenum framebufferStatus = glCheckFramebufferStatus(GL_FRAMEBUFFER);
 
-    if (!sharedMsDepthStencilTex) {
-      glGenTextures(1, &msDepthStencilTex);
-    } else {
-      msDepthStencilTex = sharedMsDepthStencilTex;
-    }
-    glBindTexture(GL_TEXTURE_2D_MULTISAMPLE, msDepthStencilTex);
-    glTexParameteri(GL_TEXTURE_2D_MULTISAMPLE, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D_MULTISAMPLE, GL_TEXTURE_MAX_LEVEL, 0);
-    glTexImage2DMultisample(GL_TEXTURE_2D_MULTISAMPLE, samples, GL_DEPTH24_STENCIL8, width, height, true);
-    // glFramebufferTexture2DMultisampleEXT(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_TEXTURE_2D, msDepthStencilTex, 0, samples);
-    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_TEXTURE_2D_MULTISAMPLE, msDepthStencilTex, 0);
-
-    if (!sharedMsColorTex) {
-      glGenTextures(1, &msColorTex);
-    } else {
-      msColorTex = sharedMsColorTex;
+  if (samples > 0) {
+    glGenFramebuffers(1, &msFbo);
+    msDepthStencilTex = renderTargetPool.Acquire(RenderTargetPool::Key{shareGroup, width, height, GL_DEPTH24_STENCIL8, samples}, sharedMsDepthStencilTex);
+    msColorTex = renderTargetPool.Acquire(RenderTargetPool::Key{shareGroup, width, height, GL_RGBA8, samples}, sharedMsColorTex);
+    AttachRenderTarget(msFbo, GL_TEXTURE_2D_MULTISAMPLE, msColorTex, msDepthStencilTex);
+    if (framebufferStatus == GL_FRAMEBUFFER_COMPLETE) {
+      framebufferStatus = glCheckFramebufferStatus(GL_FRAMEBUFFER);
     }
-    glBindTexture(GL_TEXTURE_2D_MULTISAMPLE, msColorTex);
-    glTexParameteri(GL_TEXTURE_2D_MULTISAMPLE, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D_MULTISAMPLE, GL_TEXTURE_MAX_LEVEL, 0);
-    glTexImage2DMultisample(GL_TEXTURE_2D_MULTISAMPLE, samples, GL_RGBA8, width, height, true);
-    // glFramebufferTexture2DMultisampleEXT(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, msColorTex, 0, samples);
-    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D_MULTISAMPLE, msColorTex, 0);
-  }
-  {
-    glGenFramebuffers(1, &fbo);
-    glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+  } else {
+    GLuint unusedTextures[] = {sharedMsColorTex, sharedMsDepthStencilTex};
+    glDeleteTextures(sizeof(unusedTextures)/sizeof(unusedTextures[0]), unusedTextures);
 
-    if (!sharedDepthStencilTex) {
-      glGenTextures(1, &depthStencilTex);
-    } else {
-      depthStencilTex = sharedDepthStencilTex;
-    }
-    glBindTexture(GL_TEXTURE_2D, depthStencilTex);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0);
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH24_STENCIL8, width, height, 0, GL_DEPTH_STENCIL, GL_UNSIGNED_INT_24_8, nullptr);
-    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_TEXTURE_2D, depthStencilTex, 0);
-
-    if (!sharedColorTex) {
-      glGenTextures(1, &colorTex);
-    } else {
-      colorTex = sharedColorTex;
-    }
-    glBindTexture(GL_TEXTURE_2D, colorTex);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0);
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
-    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, colorTex, 0);
+    msFbo = fbo;
+    msColorTex = colorTex;
+    msDepthStencilTex = depthStencilTex;
   }
 
   Local<Value> result;
-  GLenum framebufferStatus = glCheckFramebufferStatus(GL_FRAMEBUFFER);
   if (framebufferStatus == GL_FRAMEBUFFER_COMPLETE) {
-    Local<Array> array = Array::New(Isolate::GetCurrent(), 6);
-    array->Set(0, JS_NUM(fbo));
-    array->Set(1, JS_NUM(colorTex));
-    array->Set(2, JS_NUM(depthStencilTex));
-    array->Set(3, JS_NUM(msFbo));
-    array->Set(4, JS_NUM(msColorTex));
-    array->Set(5, JS_NUM(msDepthStencilTex));
-    result = array;
+    result = makeRenderTargetArray(fbo, colorTex, depthStencilTex, msFbo, msColorTex, msDepthStencilTex);
   } else {
     result = Null(Isolate::GetCurrent());
   }
   info.GetReturnValue().Set(result);
 
-  if (gl->HasFramebufferBinding(GL_FRAMEBUFFER)) {
-    glBindFramebuffer(GL_FRAMEBUFFER, gl->GetFramebufferBinding(GL_FRAMEBUFFER));
-  } else {
-    glBindFramebuffer(GL_FRAMEBUFFER, gl->defaultFramebuffer);
-  }
-  if (gl->HasTextureBinding(gl->activeTexture, GL_TEXTURE_2D)) {
-    glBindTexture(GL_TEXTURE_2D, gl->GetTextureBinding(gl->activeTexture, GL_TEXTURE_2D));
-  } else {
-    glBindTexture(GL_TEXTURE_2D, 0);
-  }
-  if (gl->HasTextureBinding(gl->activeTexture, GL_TEXTURE_2D_MULTISAMPLE)) {
-    glBindTexture(GL_TEXTURE_2D_MULTISAMPLE, gl->GetTextureBinding(gl->activeTexture, GL_TEXTURE_2D_MULTISAMPLE));
-  } else {
-    glBindTexture(GL_TEXTURE_2D_MULTISAMPLE, 0);
-  }
-  if (gl->HasTextureBinding(gl->activeTexture, GL_TEXTURE_CUBE_MAP)) {
-    glBindTexture(GL_TEXTURE_CUBE_MAP, gl->GetTextureBinding(gl->activeTexture, GL_TEXTURE_CUBE_MAP));
-  } else {
-    glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
-  }
+  RestoreRenderTargetBindings(gl);
 }
 
+// Resizes the textures in place: their names may be shared with the parent window, which keeps sampling them.
+// Returns the (unchanged) names.
 NAN_METHOD(ResizeRenderTarget) {
   WebGLRenderingContext *gl = ObjectWrap::Unwrap<WebGLRenderingContext>(Local<Object>::Cast(info[0]));
   int width = info[1]->Uint32Value();
@@ -923,64 +1030,43 @@ NAN_METHOD(ResizeRenderTarget) {
   GLuint msColorTex = info[7]->Uint32Value();
   GLuint msDepthStencilTex = info[8]->Uint32Value();
 
-  const int samples = 4;
-
-  {
-    glBindFramebuffer(GL_FRAMEBUFFER, msFbo);
-
-    glBindTexture(GL_TEXTURE_2D_MULTISAMPLE, msDepthStencilTex);
-    glTexParameteri(GL_TEXTURE_2D_MULTISAMPLE, GL_TEXTURE_MAX_LEVEL, 0);
-    glTexImage2DMultisample(GL_TEXTURE_2D_MULTISAMPLE, samples, GL_DEPTH24_STENCIL8, width, height, true);
-    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_TEXTURE_2D_MULTISAMPLE, msDepthStencilTex, 0);
-
-    glBindTexture(GL_TEXTURE_2D_MULTISAMPLE, msColorTex);
-    glTexParameteri(GL_TEXTURE_2D_MULTISAMPLE, GL_TEXTURE_MAX_LEVEL, 0);
-    glTexImage2DMultisample(GL_TEXTURE_2D_MULTISAMPLE, samples, GL_RGBA8, width, height, true);
-    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D_MULTISAMPLE, msColorTex, 0);
+  std::lock_guard<std::mutex> lock(renderTargetMutex);
+  GLFWwindow *shareGroup = GetShareGroup(gl->windowHandle);
+
+  if (
+    !renderTargetPool.Resize(shareGroup, depthStencilTex, width, height) ||
+    !renderTargetPool.Resize(shareGroup, colorTex, width, height) ||
+    (msFbo != fbo && (
+      !renderTargetPool.Resize(shareGroup, msDepthStencilTex, width, height) ||
+      !renderTargetPool.Resize(shareGroup, msColorTex, width, height)
+    ))
+  ) {
+    RestoreRenderTargetBindings(gl);
+    return Nan::ThrowError("resizeRenderTarget: invalid arguments");
   }
-  {
-    glBindFramebuffer(GL_FRAMEBUFFER, fbo);
-
-    glBindTexture(GL_TEXTURE_2D, depthStencilTex);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0);
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH24_STENCIL8, width, height, 0, GL_DEPTH_STENCIL, GL_UNSIGNED_INT_24_8, nullptr);
-    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_TEXTURE_2D, depthStencilTex, 0);
-
-    glBindTexture(GL_TEXTURE_2D, colorTex);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0);
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
-    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, colorTex, 0);
+  AttachRenderTarget(fbo, GL_TEXTURE_2D, colorTex, depthStencilTex);
+  if (msFbo != fbo) {
+    AttachRenderTarget(msFbo, GL_TEXTURE_2D_MULTISAMPLE, msColorTex, msDepthStencilTex);
   }
 
-  if (gl->HasFramebufferBinding(GL_FRAMEBUFFER)) {
-    glBindFramebuffer(GL_FRAMEBUFFER, gl->GetFramebufferBinding(GL_FRAMEBUFFER));
-  } else {
-    glBindFramebuffer(GL_FRAMEBUFFER, gl->defaultFramebuffer);
-  }
-  if (gl->HasTextureBinding(gl->activeTexture, GL_TEXTURE_2D)) {
-    glBindTexture(GL_TEXTURE_2D, gl->GetTextureBinding(gl->activeTexture, GL_TEXTURE_2D));
-  } else {
-    glBindTexture(GL_TEXTURE_2D, 0);
-  }
-  if (gl->HasTextureBinding(gl->activeTexture, GL_TEXTURE_2D_MULTISAMPLE)) {
-    glBindTexture(GL_TEXTURE_2D_MULTISAMPLE, gl->GetTextureBinding(gl->activeTexture, GL_TEXTURE_2D_MULTISAMPLE));
-  } else {
-    glBindTexture(GL_TEXTURE_2D_MULTISAMPLE, 0);
-  }
-  if (gl->HasTextureBinding(gl->activeTexture, GL_TEXTURE_CUBE_MAP)) {
-    glBindTexture(GL_TEXTURE_CUBE_MAP, gl->GetTextureBinding(gl->activeTexture, GL_TEXTURE_CUBE_MAP));
-  } else {
-    glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
-  }
+  info.GetReturnValue().Set(makeRenderTargetArray(fbo, colorTex, depthStencilTex, msFbo, msColorTex, msDepthStencilTex));
+
+  RestoreRenderTargetBindings(gl);
 }
 
+// Textures are returned to the pool of the current window's share group.
 NAN_METHOD(DestroyRenderTarget) {
   if (info[0]->IsNumber() && info[1]->IsNumber()) {
     GLuint fbo = info[0]->Uint32Value();
     GLuint tex = info[1]->Uint32Value();
+    GLuint depthStencilTex = info[2]->IsNumber() ? info[2]->Uint32Value() : 0;
+
+    std::lock_guard<std::mutex> lock(renderTargetMutex);
+    GLFWwindow *shareGroup = GetShareGroup(currentWindow);
 
     glDeleteFramebuffers(1, &fbo);
-    glDeleteTextures(1, &tex);
+    renderTargetPool.Release(shareGroup, tex);
+    renderTargetPool.Release(shareGroup, depthStencilTex);
   } else {
     Nan::ThrowError("invalid arguments");
   }
@@ -1003,6 +1089,8 @@ NAN_METHOD(FramebufferTextureLayer) {
   glFramebufferTextureLayer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, depthTex, 0, layer);
 } */
 
+// The optional trailing flags discard the read framebuffer's color and/or depth-stencil once the blit has
+// consumed them, so tiled GPUs do not write them back to memory.
 NAN_METHOD(BlitFrameBuffer) {
   Local<Object> glObj = Local<Object>::Cast(info[0]);
   GLuint fbo1 = info[1]->Uint32Value();
@@ -1014,6 +1102,13 @@ NAN_METHOD(BlitFrameBuffer) {
   bool color = info[7]->BooleanValue();
   bool depth = info[8]->BooleanValue();
   bool stencil = info[9]->BooleanValue();
+  bool invalidateColor = info[10]->BooleanValue();
+  bool invalidateDepthStencil = info[11]->BooleanValue();
+
+  if (fbo1 == fbo2) {
+    // single-sampled render target; nothing to resolve
+    return;
+  }
 
   glBindFramebuffer(GL_READ_FRAMEBUFFER, fbo1);
   glBindFramebuffer(GL_DRAW_FRAMEBUFFER, fbo2);
@@ -1025,7 +1120,20 @@ NAN_METHOD(BlitFrameBuffer) {
     (color ? GL_COLOR_BUFFER_BIT : 0) |
     (depth ? GL_DEPTH_BUFFER_BIT : 0) |
     (stencil ? GL_STENCIL_BUFFER_BIT : 0),
-    (depth || stencil) ? GL_NEAREST : GL_LINEAR);
+    // an unscaled resolve is exact either way, so depth/stencil can ride along with color
+    (depth || stencil || (sw == dw && sh == dh)) ? GL_NEAREST : GL_LINEAR);
+
+  if (fbo1 != 0 && (invalidateColor || invalidateDepthStencil)) {
+    GLenum attachments[2];
+    GLsizei numAttachments = 0;
+    if (invalidateColor) {
+      attachments[numAttachments++] = GL_COLOR_ATTACHMENT0;
+    }
+    if (invalidateDepthStencil) {
+      attachments[numAttachments++] = GL_DEPTH_STENCIL_ATTACHMENT;
+    }
+    invalidateFramebuffer(GL_READ_FRAMEBUFFER, numAttachments, attachments);
+  }
 
   WebGLRenderingContext *gl = ObjectWrap::Unwrap<WebGLRenderingContext>(glObj);
   if (gl->HasFramebufferBinding(GL_FRAMEBUFFER)) {
@@ -1035,13 +1143,67 @@ NAN_METHOD(BlitFrameBuffer) {
   }
 }
 
+GpuTimer gpuTimer;
+
+NAN_METHOD(BeginGpuTimer) {
+  if (info[0]->IsObject()) {
+    WebGLRenderingContext *gl = ObjectWrap::Unwrap<WebGLRenderingContext>(Local<Object>::Cast(info[0]));
+    gpuTimer.Begin(gl->windowHandle);
+  } else {
+    Nan::ThrowError("beginGpuTimer: invalid arguments");
+  }
+}
+
+NAN_METHOD(EndGpuTimer) {
+  if (info[0]->IsObject()) {
+    WebGLRenderingContext *gl = ObjectWrap::Unwrap<WebGLRenderingContext>(Local<Object>::Cast(info[0]));
+    info.GetReturnValue().Set(JS_NUM(gpuTimer.End(gl->windowHandle)));
+  } else {
+    Nan::ThrowError("endGpuTimer: invalid arguments");
+  }
+}
+
 void SetCurrentWindowContext(GLFWwindow *window) {
   if (currentWindow != window) {
+    // the context may still be owned by the present thread
+    presentThread.Wait(window);
     glfwMakeContextCurrent(window);
     currentWindow = window;
   }
 }
 
+GLFWwindow *CreateSharedWindow(GLFWwindow *sharedWindow) {
+  // the shared window's context may not be current on another thread while it is shared
+  SetCurrentWindowContext(sharedWindow);
+
+  glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+  GLFWwindow *window = glfwCreateWindow(1, 1, "Exokit", nullptr, sharedWindow);
+  if (window) {
+    std::lock_guard<std::mutex> lock(renderTargetMutex);
+    shareGroups[window] = GetShareGroup(sharedWindow);
+  }
+  return window;
+}
+
+void DestroySharedWindow(GLFWwindow *window) {
+  // the present thread may still have the context current
+  presentThread.Wait(window);
+  glfwDestroyWindow(window);
+
+  {
+    std::lock_guard<std::mutex> lock(renderTargetMutex);
+    shareGroups.erase(window);
+  }
+  if (currentWindow == window) {
+    currentWindow = nullptr;
+  }
+}
+
+bool IsSameShareGroup(GLFWwindow *a, GLFWwindow *b) {
+  std::lock_guard<std::mutex> lock(renderTargetMutex);
+  return GetShareGroup(a) == GetShareGroup(b);
+}
+
 NAN_METHOD(SetCurrentWindowContext) {
   GLFWwindow *window = (GLFWwindow *)arrayToPointer(Local<Array>::Cast(info[0]));
   SetCurrentWindowContext(window);
@@ -1049,6 +1211,7 @@ NAN_METHOD(SetCurrentWindowContext) {
 
 NAN_METHOD(DestroyWindow) {
   GLFWwindow *window = (GLFWwindow *)arrayToPointer(Local<Array>::Cast(info[0]));
+  presentThread.Wait(window);
   glfwDestroyWindow(window);
 
   if (currentWindow == window) {
@@ -1067,8 +1230,8 @@ NAN_METHOD(GetWindowSize) {
   int w,h;
   glfwGetWindowSize(window, &w, &h);
   Local<Object> result = Nan::New<Object>();
-  result->Set(JS_STR("width"),JS_INT(w));
-  result->Set(JS_STR("height"),JS_INT(h));
+  result->Set(JS_KEY(width),JS_INT(w));
+  result->Set(JS_KEY(height),JS_INT(h));
   info.GetReturnValue().Set(result);
 }
 
@@ -1087,8 +1250,8 @@ NAN_METHOD(GetWindowPos) {
   int xpos, ypos;
   glfwGetWindowPos(window, &xpos, &ypos);
   Local<Object> result = Nan::New<Object>();
-  result->Set(JS_STR("xpos"),JS_INT(xpos));
-  result->Set(JS_STR("ypos"),JS_INT(ypos));
+  result->Set(JS_KEY(xpos),JS_INT(xpos));
+  result->Set(JS_KEY(ypos),JS_INT(ypos));
   info.GetReturnValue().Set(result);
 }
 
@@ -1097,8 +1260,8 @@ NAN_METHOD(GetFramebufferSize) {
   int width, height;
   glfwGetFramebufferSize(window, &width, &height);
   Local<Object> result = Nan::New<Object>();
-  result->Set(JS_STR("width"),JS_INT(width));
-  result->Set(JS_STR("height"),JS_INT(height));
+  result->Set(JS_KEY(width),JS_INT(width));
+  result->Set(JS_KEY(height),JS_INT(height));
   info.GetReturnValue().Set(result);
 }
 
@@ -1247,6 +1410,11 @@ NAN_METHOD(ExtensionSupported) {
 
 bool glfwInitialized = false;
 NAN_METHOD(Create) {
+  if (!IsMainThread()) {
+    // a worker gets its context by making a hidden window created here for it (sharing with the parent's) current
+    return Nan::ThrowError("create: windows can only be created on the main thread");
+  }
+
   if (!glfwInitialized) {
     glewExperimental = GL_TRUE;
 
@@ -1303,6 +1471,10 @@ NAN_METHOD(Create) {
   GLFWwindow *windowHandle = glfwCreateWindow(width, height, "Exokit", nullptr, shared ? sharedWindow : nullptr);
 
   if (windowHandle) {
+    {
+      std::lock_guard<std::mutex> lock(renderTargetMutex);
+      shareGroups[windowHandle] = shared ? GetShareGroup(sharedWindow) : windowHandle;
+    }
     SetCurrentWindowContext(windowHandle);
 
     GLenum err = glewInit();
@@ -1370,11 +1542,32 @@ NAN_METHOD(Create) {
 }
 
 NAN_METHOD(Destroy) {
+  if (!IsMainThread()) {
+    return Nan::ThrowError("destroy: can only be called on the main thread");
+  }
   GLFWwindow *window = (GLFWwindow *)arrayToPointer(Local<Array>::Cast(info[0]));
+  presentThread.Wait(window);
   glfwDestroyWindow(window);
+
+  {
+    std::lock_guard<std::mutex> lock(renderTargetMutex);
+    if (GetShareGroup(window) == window) {
+      renderTargetPool.Forget(window);
+    }
+    shareGroups.erase(window);
+  }
+  gpuTimer.Forget(window);
+  swapStats.Forget(window);
+  swapIntervals.erase(window);
+  if (currentWindow == window) {
+    currentWindow = nullptr;
+  }
 }
 
 NAN_METHOD(SetEventHandler) {
+  if (!IsMainThread()) {
+    return Nan::ThrowError("setEventHandler: can only be called on the main thread");
+  }
   if (!eventHandler) {
     eventHandler.reset(new Nan::Persistent<Function>());
   }
@@ -1382,12 +1575,176 @@ NAN_METHOD(SetEventHandler) {
 }
 
 NAN_METHOD(PollEvents) {
+  if (!IsMainThread()) {
+    return Nan::ThrowError("pollEvents: can only be called on the main thread");
+  }
   glfwPollEvents();
+
+  if (inputQueue.enabled && info[0]->IsFloat64Array()) {
+    Local<Float64Array> array = Local<Float64Array>::Cast(info[0]);
+    double *data = (double *)((char *)array->Buffer()->GetContents().Data() + array->ByteOffset());
+    size_t numEvents = inputQueue.Drain(data, array->Length() / InputEvent::STRIDE);
+    info.GetReturnValue().Set(JS_INT((uint32_t)numEvents));
+  }
+}
+
+NAN_METHOD(TakeDroppedPaths) {
+  if (!IsMainThread()) {
+    return Nan::ThrowError("takeDroppedPaths: can only be called on the main thread");
+  }
+  std::vector<std::string> paths = inputQueue.TakeDrop();
+  Local<Array> result = Nan::New<Array>(paths.size());
+  for (size_t i = 0; i < paths.size(); i++) {
+    result->Set(i, JS_STR(paths[i]));
+  }
+  info.GetReturnValue().Set(result);
+}
+
+NAN_METHOD(SetInputQueue) {
+  if (!IsMainThread()) {
+    return Nan::ThrowError("setInputQueue: can only be called on the main thread");
+  }
+  inputQueue.enabled = info[0]->BooleanValue();
+  inputQueue.raw = info[1]->BooleanValue();
+  if (!inputQueue.enabled) {
+    inputQueue.Clear();
+  }
 }
 
 NAN_METHOD(SwapBuffers) {
+  if (!IsMainThread()) {
+    return Nan::ThrowError("swapBuffers: can only be called on the main thread");
+  }
   GLFWwindow *window = (GLFWwindow *)arrayToPointer(Local<Array>::Cast(info[0]));
-  glfwSwapBuffers(window);
+
+  // with vsync only the first present of a frame waits for the vertical blank, so extra windows do not divide the rate
+  int swapInterval = (frameScheduler.vsync && !frameScheduler.presentedThisFrame) ? 1 : 0;
+  auto iter = swapIntervals.find(window);
+  if (iter == swapIntervals.end() || iter->second != swapInterval) {
+    SetCurrentWindowContext(window);
+    glfwSwapInterval(swapInterval);
+    swapIntervals[window] = swapInterval;
+  }
+
+  if (asyncPresent) {
+    SetCurrentWindowContext(window);
+    presentThread.Present(window, frameScheduler.frameIndex);
+    currentWindow = nullptr;
+  } else {
+    glfwSwapBuffers(window);
+    swapStats.RecordSwap(window, frameScheduler.frameIndex);
+    frameScheduler.waitedForSwap = frameScheduler.waitedForSwap || swapInterval > 0;
+  }
+  frameScheduler.presentedThisFrame = true;
+}
+
+NAN_METHOD(SetPresentMode) {
+  if (info[0]->IsString()) {
+    String::Utf8Value modeValue(info[0]->ToString());
+    std::string mode(*modeValue, modeValue.length());
+    if (mode == "sync") {
+      asyncPresent = false;
+    } else if (mode == "async") {
+      asyncPresent = true;
+    } else {
+      Nan::ThrowError("setPresentMode: invalid mode");
+    }
+  } else {
+    Nan::ThrowError("setPresentMode: invalid arguments");
+  }
+}
+
+NAN_METHOD(SetVsync) {
+  if (!IsMainThread()) {
+    return Nan::ThrowError("setVsync: can only be called on the main thread");
+  }
+  frameScheduler.vsync = info[0]->BooleanValue();
+}
+
+NAN_METHOD(SetFrameRate) {
+  if (!IsMainThread()) {
+    return Nan::ThrowError("setFrameRate: can only be called on the main thread");
+  }
+  if (info[0]->IsNumber()) {
+    frameScheduler.SetFrameRate(info[0]->NumberValue());
+  } else {
+    Nan::ThrowError("setFrameRate: invalid arguments");
+  }
+}
+
+NAN_METHOD(BeginFrame) {
+  if (!IsMainThread()) {
+    return Nan::ThrowError("beginFrame: can only be called on the main thread");
+  }
+  if ((!frameScheduler.HasFrameRate() || !swapStats.HasRefreshRate()) && glfwInitialized) {
+    GLFWmonitor *monitor = glfwGetPrimaryMonitor();
+    const GLFWvidmode *mode = monitor ? glfwGetVideoMode(monitor) : nullptr;
+    if (mode && mode->refreshRate > 0) {
+      if (!frameScheduler.HasFrameRate()) {
+        frameScheduler.SetFrameRate(mode->refreshRate);
+      }
+      swapStats.SetRefreshRate(mode->refreshRate);
+    }
+  }
+
+  frameScheduler.BeginFrame();
+}
+
+NAN_METHOD(EndFrame) {
+  if (!IsMainThread()) {
+    return Nan::ThrowError("endFrame: can only be called on the main thread");
+  }
+  bool active = info[0]->BooleanValue();
+  bool externallyPaced = info[1]->BooleanValue();
+
+  double delay = frameScheduler.EndFrame(active, externallyPaced);
+  info.GetReturnValue().Set(JS_NUM(delay));
+}
+
+NAN_METHOD(WaitForFrame) {
+  if (!IsMainThread()) {
+    return Nan::ThrowError("waitForFrame: can only be called on the main thread");
+  }
+  frameScheduler.WaitForFrame();
+}
+
+NAN_METHOD(GetFrameTimes) {
+  if (!IsMainThread()) {
+    return Nan::ThrowError("getFrameTimes: can only be called on the main thread");
+  }
+  Local<Object> result = Nan::New<Object>();
+  result->Set(JS_KEY(frames), JS_INT(frameScheduler.numFrames));
+  result->Set(JS_KEY(mean), JS_NUM(frameScheduler.numFrames > 0 ? frameScheduler.totalFrameTime / frameScheduler.numFrames : 0));
+  result->Set(JS_KEY(p50), JS_NUM(frameScheduler.GetPercentile(0.5)));
+  result->Set(JS_KEY(p95), JS_NUM(frameScheduler.GetPercentile(0.95)));
+  result->Set(JS_KEY(p99), JS_NUM(frameScheduler.GetPercentile(0.99)));
+  result->Set(JS_KEY(max), JS_NUM(frameScheduler.maxFrameTime));
+  result->Set(JS_KEY(bucketSize), JS_NUM(FrameScheduler::BUCKET_MS));
+
+  Local<ArrayBuffer> arrayBuffer = ArrayBuffer::New(Isolate::GetCurrent(), sizeof(frameScheduler.histogram));
+  memcpy(arrayBuffer->GetContents().Data(), frameScheduler.histogram, sizeof(frameScheduler.histogram));
+  result->Set(JS_KEY(histogram), Uint32Array::New(arrayBuffer, 0, FrameScheduler::NUM_BUCKETS));
+
+  if (info[0]->BooleanValue()) {
+    frameScheduler.ResetFrameTimes();
+  }
+
+  info.GetReturnValue().Set(result);
+}
+
+NAN_METHOD(GetSwapStats) {
+  if (info[0]->IsArray()) {
+    GLFWwindow *window = (GLFWwindow *)arrayToPointer(Local<Array>::Cast(info[0]));
+    SwapStats::Stats stats = swapStats.Get(window);
+
+    Local<Object> result = Nan::New<Object>();
+    result->Set(JS_KEY(swaps), JS_INT(stats.swaps));
+    result->Set(JS_KEY(missedVsyncs), JS_INT(stats.missedVsyncs));
+    result->Set(JS_KEY(interval), JS_NUM(stats.lastInterval));
+    info.GetReturnValue().Set(result);
+  } else {
+    Nan::ThrowError("getSwapStats: invalid arguments");
+  }
 }
 
 NAN_METHOD(SetCursorMode) {
@@ -1798,6 +2155,12 @@ Local<Object> makeWindow() {
   Isolate *isolate = Isolate::GetCurrent();
   v8::EscapableHandleScope scope(isolate);
 
+  // the first isolate to load the bindings is the main one; workers come later
+  static std::once_flag mainThreadFlag;
+  std::call_once(mainThreadFlag, []() {
+    glfw::mainThreadId = std::this_thread::get_id();
+  });
+
   Local<Object> target = Object::New(isolate);
 
   Nan::SetMethod(target, "create", glfw::Create);
@@ -1817,7 +2180,17 @@ Local<Object> makeWindow() {
   Nan::SetMethod(target, "restoreWindow", glfw::RestoreWindow);
   Nan::SetMethod(target, "setEventHandler", glfw::SetEventHandler);
   Nan::SetMethod(target, "pollEvents", glfw::PollEvents);
+  Nan::SetMethod(target, "setInputQueue", glfw::SetInputQueue);
+  Nan::SetMethod(target, "takeDroppedPaths", glfw::TakeDroppedPaths);
   Nan::SetMethod(target, "swapBuffers", glfw::SwapBuffers);
+  Nan::SetMethod(target, "setVsync", glfw::SetVsync);
+  Nan::SetMethod(target, "setPresentMode", glfw::SetPresentMode);
+  Nan::SetMethod(target, "setFrameRate", glfw::SetFrameRate);
+  Nan::SetMethod(target, "beginFrame", glfw::BeginFrame);
+  Nan::SetMethod(target, "endFrame", glfw::EndFrame);
+  Nan::SetMethod(target, "waitForFrame", glfw::WaitForFrame);
+  Nan::SetMethod(target, "getFrameTimes", glfw::GetFrameTimes);
+  Nan::SetMethod(target, "getSwapStats", glfw::GetSwapStats);
   Nan::SetMethod(target, "setCursorMode", glfw::SetCursorMode);
   Nan::SetMethod(target, "setCursorPosition", glfw::SetCursorPosition);
   Nan::SetMethod(target, "getClipboard", glfw::GetClipboard);
@@ -1828,6 +2201,8 @@ Local<Object> makeWindow() {
   // Nan::SetMethod(target, "createFramebuffer", glfw::CreateFramebuffer);
   // Nan::SetMethod(target, "framebufferTextureLayer", glfw::FramebufferTextureLayer);
   Nan::SetMethod(target, "blitFrameBuffer", glfw::BlitFrameBuffer);
+  Nan::SetMethod(target, "beginGpuTimer", glfw::BeginGpuTimer);
+  Nan::SetMethod(target, "endGpuTimer", glfw::EndGpuTimer);
   Nan::SetMethod(target, "setCurrentWindowContext", glfw::SetCurrentWindowContext);
 
   return scope.Escape(target);
@@ -0,0 +1,77 @@
+#include <glfw.h>
+
+namespace glfw {
+
+GpuTimer::State *GpuTimer::GetState(GLFWwindow *window) {
+  if (!(GLEW_VERSION_3_3 || GLEW_ARB_timer_query)) {
+    return nullptr;
+  }
+
+  std::lock_guard<std::mutex> lock(mutex);
+
+  auto iter = states.find(window);
+  if (iter != states.end()) {
+    return &iter->second;
+  }
+
+  State &state = states[window];
+  glGenQueries(NUM_QUERIES * 2, &state.queries[0][0]);
+  state.next = 0;
+  state.pending = 0;
+  state.running = false;
+  return &state;
+}
+
+void GpuTimer::Begin(GLFWwindow *window) {
+  State *state = GetState(window);
+  if (!state || state->running) {
+    return;
+  }
+
+  if (state->pending == NUM_QUERIES) {
+    // the GPU is that far behind; drop the oldest measurement rather than wait for it
+    state->pending--;
+  }
+  // timestamps rather than a GL_TIME_ELAPSED query, which would fail content's own elapsed-time queries since
+  // those cannot nest
+  glQueryCounter(state->queries[state->next][0], GL_TIMESTAMP);
+  state->running = true;
+}
+
+double GpuTimer::End(GLFWwindow *window) {
+  State *state = GetState(window);
+  if (!state || !state->running) {
+    return -1;
+  }
+
+  glQueryCounter(state->queries[state->next][1], GL_TIMESTAMP);
+  state->next = (state->next + 1) % NUM_QUERIES;
+  state->pending++;
+  state->running = false;
+
+  double result = -1;
+  while (state->pending > 0) {
+    const GLuint *queries = state->queries[(state->next + NUM_QUERIES - state->pending) % NUM_QUERIES];
+    // the end timestamp is written after the begin one
+    GLint available = 0;
+    glGetQueryObjectiv(queries[1], GL_QUERY_RESULT_AVAILABLE, &available);
+    if (!available) {
+      break;
+    }
+
+    GLuint64 begin = 0;
+    GLuint64 end = 0;
+    glGetQueryObjectui64v(queries[0], GL_QUERY_RESULT, &begin);
+    glGetQueryObjectui64v(queries[1], GL_QUERY_RESULT, &end);
+    result = (double)(end - begin) / 1e6;
+    state->pending--;
+  }
+  return result;
+}
+
+void GpuTimer::Forget(GLFWwindow *window) {
+  std::lock_guard<std::mutex> lock(mutex);
+  states.erase(window);
+}
+
+}
@@ -0,0 +1,70 @@
+#include <input-queue.h>
+
+namespace glfw {
+
+void InputQueue::Push(const InputEvent &event) {
+  if (!raw && count > 0) {
+    InputEvent &last = events[(head + count - 1) % events.size()];
+    if (last.type == event.type && last.window == event.window && last.mods == event.mods) {
+      if (event.type == INPUT_MOUSEMOVE) {
+        last.a = event.a;
+        last.b = event.b;
+        last.c += event.c;
+        last.d += event.d;
+        return;
+      } else if (event.type == INPUT_WHEEL) {
+        last.a += event.a;
+        last.b += event.b;
+        return;
+      }
+    }
+  }
+
+  if (count == events.size()) {
+    // the frame loop is not keeping up; dropping a keyup or mouseup would leave keys and buttons stuck
+    std::vector<InputEvent> newEvents(events.size() * 2);
+    for (size_t i = 0; i < count; i++) {
+      newEvents[i] = events[(head + i) % events.size()];
+    }
+    events.swap(newEvents);
+    head = 0;
+  }
+  events[(head + count) % events.size()] = event;
+  count++;
+}
+
+void InputQueue::PushDrop(void *window, std::vector<std::string> paths) {
+  Push(InputEvent{(uint32_t)INPUT_DROP, window, 0, 0, 0, 0, 0});
+  drops.push_back(std::move(paths));
+}
+
+std::vector<std::string> InputQueue::TakeDrop() {
+  std::vector<std::string> paths;
+  if (!drops.empty()) {
+    paths = std::move(drops.front());
+    drops.pop_front();
+  }
+  return paths;
+}
+
+size_t InputQueue::Drain(double *out, size_t maxEvents) {
+  size_t n = count < maxEvents ? count : maxEvents;
+  for (size_t i = 0; i < n; i++) {
+    const InputEvent &event = events[(head + i) % events.size()];
+    uintptr_t window = (uintptr_t)event.window;
+    double *row = out + i * InputEvent::STRIDE;
+    row[0] = event.type;
+    row[1] = (uint32_t)(window >> 32);
+    row[2] = (uint32_t)(window & 0xFFFFFFFF);
+    row[3] = event.a;
+    row[4] = event.b;
+    row[5] = event.c;
+    row[6] = event.d;
+    row[7] = event.mods;
+  }
+  head = (head + n) % events.size();
+  count -= n;
+  return n;
+}
+
+}
@@ -0,0 +1,79 @@
+#include <glfw.h>
+
+namespace glfw {
+
+PresentThread::PresentThread(SwapStats *swapStats) : swapStats(swapStats), live(true) {}
+
+PresentThread::~PresentThread() {
+  if (thread.joinable()) {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      live = false;
+    }
+    jobsCv.notify_one();
+    thread.join();
+  }
+}
+
+void PresentThread::Present(GLFWwindow *window, uint64_t frameIndex) {
+  GLsync fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+  glFlush();
+  glfwMakeContextCurrent(nullptr);
+
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!thread.joinable()) {
+      thread = std::thread([this]() {
+        Run();
+      });
+    }
+    jobs.push_back(Job{window, fence, frameIndex});
+    pending.insert(window);
+  }
+  jobsCv.notify_one();
+}
+
+void PresentThread::Wait(GLFWwindow *window) {
+  std::unique_lock<std::mutex> lock(mutex);
+  doneCv.wait(lock, [&]() {
+    return pending.find(window) == pending.end();
+  });
+}
+
+bool PresentThread::IsPending(GLFWwindow *window) {
+  std::lock_guard<std::mutex> lock(mutex);
+  return pending.find(window) != pending.end();
+}
+
+void PresentThread::Run() {
+  for (;;) {
+    Job job;
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      jobsCv.wait(lock, [&]() {
+        return !jobs.empty() || !live;
+      });
+      if (!live) {
+        break;
+      }
+      job = jobs.front();
+      jobs.pop_front();
+    }
+
+    glfwMakeContextCurrent(job.window);
+    // the flush on the JS thread already submitted the frame, so this only waits for the GPU
+    glClientWaitSync(job.fence, 0, 1000 * 1000 * 1000);
+    glDeleteSync(job.fence);
+    glfwSwapBuffers(job.window);
+    swapStats->RecordSwap(job.window, job.frameIndex);
+    glfwMakeContextCurrent(nullptr);
+
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      pending.erase(job.window);
+    }
+    doneCv.notify_all();
+  }
+}
+
+}
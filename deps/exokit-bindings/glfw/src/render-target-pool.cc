@@ -0,0 +1,132 @@
+#include <iterator>
+
+#include <glfw.h>
+
+namespace glfw {
+
+bool RenderTargetPool::Key::operator==(const Key &other) const {
+  return shareGroup == other.shareGroup &&
+    width == other.width &&
+    height == other.height &&
+    internalformat == other.internalformat &&
+    samples == other.samples;
+}
+
+GLuint RenderTargetPool::Acquire(const Key &key, GLuint name) {
+  GLuint tex = name;
+  if (!tex) {
+    // most recently released first
+    for (auto iter = freeTextures.rbegin(); iter != freeTextures.rend(); iter++) {
+      if (iter->key == key) {
+        tex = iter->tex;
+        freeTextures.erase(std::next(iter).base());
+        break;
+      }
+    }
+  }
+  if (!tex) {
+    glGenTextures(1, &tex);
+    Allocate(key, tex);
+  } else if (name) {
+    Allocate(key, tex);
+  }
+
+  liveTextures[std::make_pair(key.shareGroup, tex)] = key;
+  return tex;
+}
+
+bool RenderTargetPool::Resize(void *shareGroup, GLuint tex, int width, int height) {
+  auto iter = liveTextures.find(std::make_pair(shareGroup, tex));
+  if (iter == liveTextures.end()) {
+    return false;
+  }
+  Key &key = iter->second;
+  if (key.width != width || key.height != height) {
+    key.width = width;
+    key.height = height;
+    Allocate(key, tex);
+  }
+  return true;
+}
+
+void RenderTargetPool::Release(void *shareGroup, GLuint tex) {
+  if (!tex) {
+    return;
+  }
+
+  auto iter = liveTextures.find(std::make_pair(shareGroup, tex));
+  if (iter == liveTextures.end()) {
+    glDeleteTextures(1, &tex);
+    return;
+  }
+  freeTextures.push_back(Entry{iter->second, tex});
+  liveTextures.erase(iter);
+
+  // only textures of the current share group can be deleted here
+  size_t numFree = 0;
+  for (const Entry &entry : freeTextures) {
+    if (entry.key.shareGroup == shareGroup) {
+      numFree++;
+    }
+  }
+  for (auto iter = freeTextures.begin(); numFree > MAX_FREE_TEXTURES && iter != freeTextures.end();) {
+    if (iter->key.shareGroup == shareGroup) {
+      glDeleteTextures(1, &iter->tex);
+      iter = freeTextures.erase(iter);
+      numFree--;
+    } else {
+      iter++;
+    }
+  }
+}
+
+void RenderTargetPool::Forget(void *shareGroup) {
+  for (auto iter = freeTextures.begin(); iter != freeTextures.end();) {
+    if (iter->key.shareGroup == shareGroup) {
+      iter = freeTextures.erase(iter);
+    } else {
+      iter++;
+    }
+  }
+  for (auto iter = liveTextures.begin(); iter != liveTextures.end();) {
+    if (iter->first.first == shareGroup) {
+      iter = liveTextures.erase(iter);
+    } else {
+      iter++;
+    }
+  }
+}
+
+int RenderTargetPool::GetSamples(int samples) {
+  GLint maxSamples = 0;
+  glGetIntegerv(GL_MAX_SAMPLES, &maxSamples);
+
+  const int sampleCounts[] = {8, 4, 2};
+  for (int sampleCount : sampleCounts) {
+    if (samples >= sampleCount && maxSamples >= sampleCount) {
+      return sampleCount;
+    }
+  }
+  return 0;
+}
+
+void RenderTargetPool::Allocate(const Key &key, GLuint tex) {
+  bool depthStencil = key.internalformat == GL_DEPTH24_STENCIL8;
+  if (key.samples > 0) {
+    glBindTexture(GL_TEXTURE_2D_MULTISAMPLE, tex);
+    glTexParameteri(GL_TEXTURE_2D_MULTISAMPLE, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D_MULTISAMPLE, GL_TEXTURE_MAX_LEVEL, 0);
+    glTexImage2DMultisample(GL_TEXTURE_2D_MULTISAMPLE, key.samples, key.internalformat, key.width, key.height, true);
+  } else {
+    glBindTexture(GL_TEXTURE_2D, tex);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0);
+    if (depthStencil) {
+      glTexImage2D(GL_TEXTURE_2D, 0, key.internalformat, key.width, key.height, 0, GL_DEPTH_STENCIL, GL_UNSIGNED_INT_24_8, nullptr);
+    } else {
+      glTexImage2D(GL_TEXTURE_2D, 0, key.internalformat, key.width, key.height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    }
+  }
+}
+
+}
@@ -0,0 +1,54 @@
+#include <cmath>
+
+#include <glfw.h>
+
+namespace glfw {
+
+SwapStats::SwapStats() : refreshRate(0) {}
+
+void SwapStats::SetRefreshRate(double refreshRate) {
+  std::lock_guard<std::mutex> lock(mutex);
+  this->refreshRate = refreshRate;
+}
+
+void SwapStats::RecordSwap(GLFWwindow *window, uint64_t frameIndex) {
+  Clock::time_point now = Clock::now();
+
+  std::lock_guard<std::mutex> lock(mutex);
+
+  auto iter = states.find(window);
+  if (iter == states.end()) {
+    State &state = states[window];
+    state.lastSwap = now;
+    state.lastFrameIndex = frameIndex;
+    state.stats = Stats{1, 0, 0};
+    return;
+  }
+
+  State &state = iter->second;
+  double interval = std::chrono::duration<double, std::milli>(now - state.lastSwap).count();
+  if (refreshRate > 0 && frameIndex == state.lastFrameIndex + 1) {
+    double vsyncs = std::round(interval * refreshRate / 1000.0);
+    if (vsyncs > 1) {
+      state.stats.missedVsyncs += (uint32_t)(vsyncs - 1);
+    }
+  }
+  state.stats.swaps++;
+  state.stats.lastInterval = interval;
+  state.lastSwap = now;
+  state.lastFrameIndex = frameIndex;
+}
+
+SwapStats::Stats SwapStats::Get(GLFWwindow *window) {
+  std::lock_guard<std::mutex> lock(mutex);
+
+  auto iter = states.find(window);
+  return iter != states.end() ? iter->second.stats : Stats{0, 0, 0};
+}
+
+void SwapStats::Forget(GLFWwindow *window) {
+  std::lock_guard<std::mutex> lock(mutex);
+  states.erase(window);
+}
+
+}
@@ -182,31 +182,35 @@ NAN_METHOD(LMContext::WaitGetPoses) {
   if (info[0]->IsArray()) {
     Local<Array> array = Local<Array>::Cast(info[0]);
 
-    for (size_t i = 0; i < 2; i++) {
-      Local<Float32Array> handFloat32Array = Local<Float32Array>::Cast(array->Get(i));
-      for (size_t j = 0; j < 6; j++) {
-        handFloat32Array->Set(j, JS_NUM(0));
-      }
-    }
+    // palm, then per finger its tip followed by its four bones, six floats apiece
+    constexpr size_t HAND_SIZE = (1 + 5 * 5) * (3 + 3);
+    float hand[HAND_SIZE];
 
     Leap::Frame frame = lmContext->controller.frame();
     Leap::HandList hands = frame.hands();
     size_t numHands = hands.count();
-    for (size_t i = 0; i < numHands && i < 2; i++) {
-      const Leap::Hand hand = hands[i];
-      const Leap::Vector position = hand.palmPosition();
-      const Leap::Vector normal = hand.palmNormal();
-
+    for (size_t i = 0; i < 2; i++) {
       Local<Float32Array> handFloat32Array = Local<Float32Array>::Cast(array->Get(i));
-      handFloat32Array->Set(0, JS_NUM(-position.x / 1000.0));
-      handFloat32Array->Set(1, JS_NUM(-position.z / 1000.0));
-      handFloat32Array->Set(2, JS_NUM(-position.y / 1000.0));
-      handFloat32Array->Set(3, JS_NUM(-normal.x));
-      handFloat32Array->Set(4, JS_NUM(-normal.z));
-      handFloat32Array->Set(5, JS_NUM(-normal.y));
-      
-      const Leap::FingerList fingers = hand.fingers();
-      size_t numFingers = fingers.count();
+      if (i >= numHands) {
+        memset(hand, 0, 6 * sizeof(float));
+        setTypedArrayData(handFloat32Array, hand, 6);
+        continue;
+      }
+
+      const Leap::Hand leapHand = hands[i];
+      const Leap::Vector position = leapHand.palmPosition();
+      const Leap::Vector normal = leapHand.palmNormal();
+
+      size_t handSize = 6;
+      hand[0] = -position.x / 1000.0;
+      hand[1] = -position.z / 1000.0;
+      hand[2] = -position.y / 1000.0;
+      hand[3] = -normal.x;
+      hand[4] = -normal.z;
+      hand[5] = -normal.y;
+
+      const Leap::FingerList fingers = leapHand.fingers();
+      size_t numFingers = std::min<size_t>(fingers.count(), 5);
       for (size_t j = 0; j < numFingers; j++) {
         const Leap::Finger finger = fingers[j];
 
@@ -214,14 +218,14 @@ NAN_METHOD(LMContext::WaitGetPoses) {
         Leap::Vector fingerTipV(-fingerTip.x / 1000.0, -fingerTip.z / 1000.0, -fingerTip.y / 1000.0);
         Leap::Vector fingerDirection = finger.direction();
         Leap::Vector fingerDirectionV(-fingerDirection.x, -fingerDirection.z, -fingerDirection.y);
-        
+
         size_t fingerBaseIndex = (1 + (j * 5)) * (3 + 3);
-        handFloat32Array->Set(fingerBaseIndex + 0, JS_NUM(fingerTipV.x));
-        handFloat32Array->Set(fingerBaseIndex + 1, JS_NUM(fingerTipV.y));
-        handFloat32Array->Set(fingerBaseIndex + 2, JS_NUM(fingerTipV.z));
-        handFloat32Array->Set(fingerBaseIndex + 3, JS_NUM(fingerDirectionV.x));
-        handFloat32Array->Set(fingerBaseIndex + 4, JS_NUM(fingerDirectionV.y));
-        handFloat32Array->Set(fingerBaseIndex + 5, JS_NUM(fingerDirectionV.z));
+        hand[fingerBaseIndex + 0] = fingerTipV.x;
+        hand[fingerBaseIndex + 1] = fingerTipV.y;
+        hand[fingerBaseIndex + 2] = fingerTipV.z;
+        hand[fingerBaseIndex + 3] = fingerDirectionV.x;
+        hand[fingerBaseIndex + 4] = fingerDirectionV.y;
+        hand[fingerBaseIndex + 5] = fingerDirectionV.z;
 
         for (int k = 0; k < 4; k++) {
           Leap::Bone::Type boneType = static_cast<Leap::Bone::Type>(k);
@@ -231,19 +235,23 @@ NAN_METHOD(LMContext::WaitGetPoses) {
           Leap::Vector boneDirection = bone.direction();
           Leap::Vector boneDirectionV(-boneDirection.x, -boneDirection.z, -boneDirection.y);
           float length = bone.length() / 1000.0;
-          
+
           Leap::Vector boneStart = boneCenterV + (boneDirectionV * length/2);
           Leap::Vector boneEnd = boneCenterV - (boneDirectionV * length/2);
-          
+
           size_t boneBaseIndex = (1 + (j * 5) + (k + 1)) * (3 + 3);
-          handFloat32Array->Set(boneBaseIndex + 0, JS_NUM(boneStart.x));
-          handFloat32Array->Set(boneBaseIndex + 1, JS_NUM(boneStart.y));
-          handFloat32Array->Set(boneBaseIndex + 2, JS_NUM(boneStart.z));
-          handFloat32Array->Set(boneBaseIndex + 3, JS_NUM(boneEnd.x));
-          handFloat32Array->Set(boneBaseIndex + 4, JS_NUM(boneEnd.y));
-          handFloat32Array->Set(boneBaseIndex + 5, JS_NUM(boneEnd.z));
+          hand[boneBaseIndex + 0] = boneStart.x;
+          hand[boneBaseIndex + 1] = boneStart.y;
+          hand[boneBaseIndex + 2] = boneStart.z;
+          hand[boneBaseIndex + 3] = boneEnd.x;
+          hand[boneBaseIndex + 4] = boneEnd.y;
+          hand[boneBaseIndex + 5] = boneEnd.z;
         }
+
+        handSize = (1 + (j + 1) * 5) * (3 + 3);
       }
+
+      setTypedArrayData(handFloat32Array, hand, handSize);
     }
   } else {
     Nan::ThrowError("LMContext::WaitGetPoses: invalid arguments");
@@ -81,16 +81,13 @@ void readPlanesQuery(MLPlane *planes, uint32_t numPlanes, int planeType, Local<F
   for (int i = 0; i < numPlanes; i++) {
     const MLPlane &plane = planes[i];
     uint32_t baseIndex = (*planesIndex) * PLANE_ENTRY_SIZE;
-    planesArray->Set(baseIndex + 0, JS_NUM(plane.position.x));
-    planesArray->Set(baseIndex + 1, JS_NUM(plane.position.y));
-    planesArray->Set(baseIndex + 2, JS_NUM(plane.position.z));
-    planesArray->Set(baseIndex + 3, JS_NUM(plane.rotation.x));
-    planesArray->Set(baseIndex + 4, JS_NUM(plane.rotation.y));
-    planesArray->Set(baseIndex + 5, JS_NUM(plane.rotation.z));
-    planesArray->Set(baseIndex + 6, JS_NUM(plane.rotation.w));
-    planesArray->Set(baseIndex + 7, JS_NUM(plane.width));
-    planesArray->Set(baseIndex + 8, JS_NUM(plane.height));
-    planesArray->Set(baseIndex + 9, JS_INT(planeType));
+    const float entry[] = {
+      plane.position.x, plane.position.y, plane.position.z,
+      plane.rotation.x, plane.rotation.y, plane.rotation.z, plane.rotation.w,
+      plane.width, plane.height,
+      (float)planeType,
+    };
+    setTypedArrayData(planesArray, entry, sizeof(entry)/sizeof(entry[0]), baseIndex);
 
    (*planesIndex)++;
   }
@@ -441,25 +438,21 @@ NAN_METHOD(MLContext::WaitGetPoses) {
       }
 
       // framebuffer
-      framebufferArray->Set(0, JS_INT((unsigned int)mlContext->virtual_camera_array.color_id));
-      framebufferArray->Set(1, JS_INT((unsigned int)mlContext->virtual_camera_array.depth_id));
+      const uint32_t framebuffer[] = {(uint32_t)mlContext->virtual_camera_array.color_id, (uint32_t)mlContext->virtual_camera_array.depth_id};
+      setTypedArrayData(framebufferArray, framebuffer, 2);
 
       // transform
       for (int i = 0; i < 2; i++) {
         const MLGraphicsVirtualCameraInfo &cameraInfo = mlContext->virtual_camera_array.virtual_cameras[i];
         const MLTransform &transform = cameraInfo.transform;
-        transformArray->Set(i*7 + 0, JS_NUM(transform.position.x));
-        transformArray->Set(i*7 + 1, JS_NUM(transform.position.y));
-        transformArray->Set(i*7 + 2, JS_NUM(transform.position.z));
-        transformArray->Set(i*7 + 3, JS_NUM(transform.rotation.x));
-        transformArray->Set(i*7 + 4, JS_NUM(transform.rotation.y));
-        transformArray->Set(i*7 + 5, JS_NUM(transform.rotation.z));
-        transformArray->Set(i*7 + 6, JS_NUM(transform.rotation.w));
+        const float transformEntry[] = {
+          transform.position.x, transform.position.y, transform.position.z,
+          transform.rotation.x, transform.rotation.y, transform.rotation.z, transform.rotation.w,
+        };
+        setTypedArrayData(transformArray, transformEntry, 7, i*7);
 
         const MLMat4f &projection = cameraInfo.projection;
-        for (int j = 0; j < 16; j++) {
-          projectionArray->Set(i*16 + j, JS_NUM(projection.matrix_colmajor[j]));
-        }
+        setTypedArrayData(projectionArray, projection.matrix_colmajor, 16, i*16);
       }
 
       // position
@@ -474,10 +467,8 @@ NAN_METHOD(MLContext::WaitGetPoses) {
 
       // viewport
       const MLRectf &viewport = mlContext->virtual_camera_array.viewport;
-      viewportArray->Set(0, JS_INT((int)viewport.x));
-      viewportArray->Set(1, JS_INT((int)viewport.y));
-      viewportArray->Set(2, JS_INT((unsigned int)viewport.w));
-      viewportArray->Set(3, JS_INT((unsigned int)viewport.h));
+      const uint32_t viewportEntry[] = {(uint32_t)(int)viewport.x, (uint32_t)(int)viewport.y, (uint32_t)viewport.w, (uint32_t)viewport.h};
+      setTypedArrayData(viewportArray, viewportEntry, 4);
 
       // planes
       endPlanesQuery(mlContext->planesFloorHandle, mlContext->planesFloorQueryHandle, mlContext->floorPlanes, &mlContext->numFloorPlanes);
@@ -488,7 +479,7 @@ NAN_METHOD(MLContext::WaitGetPoses) {
       readPlanesQuery(mlContext->floorPlanes, mlContext->numFloorPlanes, 0, planesArray, &planesIndex);
       readPlanesQuery(mlContext->wallPlanes, mlContext->numWallPlanes, 1, planesArray, &planesIndex);
       readPlanesQuery(mlContext->ceilingPlanes, mlContext->numCeilingPlanes, 2, planesArray, &planesIndex);
-      numPlanesArray->Set(0, JS_INT((int)planesIndex));
+      setTypedArrayData(numPlanesArray, &planesIndex, 1);
 
       // controllers
       MLInputControllerState controllerStates[MLInput_MaxControllers];
@@ -500,14 +491,12 @@ NAN_METHOD(MLContext::WaitGetPoses) {
           MLQuaternionf &orientation = controllerState.orientation;
           float trigger = controllerState.trigger_normalized;
 
-          controllersArray->Set((i*CONTROLLER_ENTRY_SIZE) + 0, JS_NUM(position.x));
-          controllersArray->Set((i*CONTROLLER_ENTRY_SIZE) + 1, JS_NUM(position.y));
-          controllersArray->Set((i*CONTROLLER_ENTRY_SIZE) + 2, JS_NUM(position.z));
-          controllersArray->Set((i*CONTROLLER_ENTRY_SIZE) + 3, JS_NUM(orientation.x));
-          controllersArray->Set((i*CONTROLLER_ENTRY_SIZE) + 4, JS_NUM(orientation.y));
-          controllersArray->Set((i*CONTROLLER_ENTRY_SIZE) + 5, JS_NUM(orientation.z));
-          controllersArray->Set((i*CONTROLLER_ENTRY_SIZE) + 6, JS_NUM(orientation.w));
-          controllersArray->Set((i*CONTROLLER_ENTRY_SIZE) + 7, JS_NUM(trigger));
+          const float controllerEntry[] = {
+            position.x, position.y, position.z,
+            orientation.x, orientation.y, orientation.z, orientation.w,
+            trigger,
+          };
+          setTypedArrayData(controllersArray, controllerEntry, sizeof(controllerEntry)/sizeof(controllerEntry[0]), i*CONTROLLER_ENTRY_SIZE);
         }
       } else {
         ML_LOG(Error, "MLInputGetControllerState failed: %s", application_name);
@@ -519,17 +508,15 @@ NAN_METHOD(MLContext::WaitGetPoses) {
       if (result == MLResult_Ok) {
         MLGestureOneHandedState &leftHand = gestureData.left_hand_state;
         MLVec3f &leftCenter = leftHand.hand_center_normalized;
-        gesturesArray->Set(0*4 + 0, JS_NUM(leftCenter.x));
-        gesturesArray->Set(0*4 + 1, JS_NUM(leftCenter.y));
-        gesturesArray->Set(0*4 + 2, JS_NUM(leftCenter.z));
-        gesturesArray->Set(0*4 + 3, JS_NUM(gestureCategoryToIndex(leftHand.static_gesture_category)));
 
         MLGestureOneHandedState &rightHand = gestureData.right_hand_state;
         MLVec3f &rightCenter = rightHand.hand_center_normalized;
-        gesturesArray->Set(1*4 + 0, JS_NUM(rightCenter.x));
-        gesturesArray->Set(1*4 + 1, JS_NUM(rightCenter.y));
-        gesturesArray->Set(1*4 + 2, JS_NUM(rightCenter.z));
-        gesturesArray->Set(1*4 + 3, JS_NUM(gestureCategoryToIndex(rightHand.static_gesture_category)));
+
+        const float gestures[] = {
+          leftCenter.x, leftCenter.y, leftCenter.z, (float)gestureCategoryToIndex(leftHand.static_gesture_category),
+          rightCenter.x, rightCenter.y, rightCenter.z, (float)gestureCategoryToIndex(rightHand.static_gesture_category),
+        };
+        setTypedArrayData(gesturesArray, gestures, 2*4);
       } else {
         ML_LOG(Error, "MLGestureGetData failed: %s", application_name);
       }
@@ -1,6 +1,9 @@
 #ifndef _DEFINES_H_
 #define _DEFINES_H_
 
+#include <cstring>
+#include <algorithm>
+#include <type_traits>
 #include <v8.h>
 #include <nan/nan.h>
 
@@ -12,6 +15,104 @@ using namespace v8;
 #define JS_FLOAT(val) Nan::New<v8::Number>(val)
 #define JS_BOOL(val) Nan::New<v8::Boolean>(val)
 
+// Property names used on hot paths. Each isolate gets one internalized copy of every key,
+// so JS_KEY(id) costs an array lookup instead of a string allocation and hash.
+#define JS_KEYS(V) \
+  V(id) \
+  V(type) \
+  V(constructor) \
+  V(name) \
+  V(data) \
+  V(width) \
+  V(height) \
+  V(levels) \
+  V(internalformat) \
+  V(compressed) \
+  V(windowHandle) \
+  V(xpos) \
+  V(ypos) \
+  V(paths) \
+  V(iconified) \
+  V(focused) \
+  V(entered) \
+  V(button) \
+  V(which) \
+  V(keyCode) \
+  V(charCode) \
+  V(clientX) \
+  V(clientY) \
+  V(pageX) \
+  V(pageY) \
+  V(movementX) \
+  V(movementY) \
+  V(deltaX) \
+  V(deltaY) \
+  V(deltaZ) \
+  V(deltaMode) \
+  V(ctrlKey) \
+  V(shiftKey) \
+  V(altKey) \
+  V(metaKey) \
+  V(mousemove) \
+  V(mousedown) \
+  V(mouseup) \
+  V(mouseenter) \
+  V(click) \
+  V(wheel) \
+  V(keydown) \
+  V(keyup) \
+  V(keypress) \
+  V(resize) \
+  V(windowResize) \
+  V(framebufferResize) \
+  V(focus) \
+  V(refresh) \
+  V(swaps) \
+  V(missedVsyncs) \
+  V(interval) \
+  V(frames) \
+  V(mean) \
+  V(p50) \
+  V(p95) \
+  V(p99) \
+  V(max) \
+  V(bucketSize) \
+  V(histogram) \
+  V(AudioContext) \
+  V(AudioBuffer) \
+  V(AudioNode) \
+  V(AudioParam) \
+  V(HTMLAudioElement) \
+  V(HTMLImageElement) \
+  V(HTMLVideoElement) \
+  V(HTMLCanvasElement) \
+  V(OffscreenCanvas) \
+  V(ImageData) \
+  V(ImageBitmap) \
+  V(CanvasRenderingContext2D) \
+  V(WebGLRenderingContext) \
+  V(WebGL2RenderingContext) \
+  V(_context) \
+  V(image) \
+  V(video) \
+  V(imageData) \
+  V(MicrophoneMediaStream)
+
+namespace keys {
+  enum Key {
+#define JS_KEY_ENUM(key) key,
+    JS_KEYS(JS_KEY_ENUM)
+#undef JS_KEY_ENUM
+    NUM_KEYS
+  };
+
+  void init(Isolate *isolate, Local<Object> owner);
+  void dispose(Isolate *isolate);
+  Local<String> get(Isolate *isolate, Key key);
+}
+
+#define JS_KEY(key) keys::get(Isolate::GetCurrent(), keys::key)
+
 template <typename T>
 class shared_ptr_release_deleter {
 public:
@@ -30,15 +131,51 @@ template<> struct V8TypedArrayTraits<Float64Array> { typedef double value_type;
 template<> struct V8TypedArrayTraits<Int32Array> { typedef int value_type; };
 template<> struct V8TypedArrayTraits<Uint32Array> { typedef unsigned int value_type; };
 
+// Typed array contents are written through the backing store rather than Set(i, ...), which boxes every
+// element and goes through the generic setter.
+template <typename T>
+typename V8TypedArrayTraits<T>::value_type *getTypedArrayData(Local<T> array) {
+  return (typename V8TypedArrayTraits<T>::value_type *)((char *)array->Buffer()->GetContents().Data() + array->ByteOffset());
+}
+
+// Copies size elements to the array starting at offset, converting them to the array's element type. Elements past the end are dropped.
+template <typename T, typename S>
+void setTypedArrayData(Local<T> array, const S *data, size_t size, size_t offset = 0) {
+  typedef typename V8TypedArrayTraits<T>::value_type value_type;
+
+  const size_t length = array->Length();
+  if (offset >= length) {
+    return;
+  }
+  size = std::min(size, length - offset);
+  value_type *dst = getTypedArrayData(array) + offset;
+  if (std::is_same<S, value_type>::value) {
+    memcpy(dst, data, size * sizeof(value_type));
+  } else {
+    for (size_t i = 0; i < size; i++) {
+      dst[i] = (value_type)data[i];
+    }
+  }
+}
+
+// Transposes a row-major matrix of rows x 4 elements (a 3x4 affine transform or a 4x4) into the column-major
+// 4x4 layout WebGL uses, filling missing rows from the identity.
+template <typename S, typename D>
+void transposeMatrix(const S *src, size_t rows, D *dst) {
+  for (size_t v = 0; v < 4; v++) {
+    for (size_t u = 0; u < 4; u++) {
+      dst[v * 4 + u] = u < rows ? (D)src[u * 4 + v] : (D)(u == v ? 1 : 0);
+    }
+  }
+}
+
 template <typename T>
 Local<T> createTypedArray(size_t size, const typename V8TypedArrayTraits<T>::value_type* data = NULL) {
   size_t byteLength = size * sizeof(typename V8TypedArrayTraits<T>::value_type);
   Local<ArrayBuffer> buffer = ArrayBuffer::New(Isolate::GetCurrent(), byteLength);
   Local<T> result = T::New(buffer, 0, size);
   if (data) {
-    for (unsigned int i = 0; i < size; i++) {
-      result->Set(i, Nan::New(data[i]));
-    }
+    setTypedArrayData(result, data, size);
   }
   return result;
 };
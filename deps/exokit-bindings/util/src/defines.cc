@@ -1,5 +1,9 @@
 #include <defines.h>
 
+#include <atomic>
+#include <map>
+#include <mutex>
+
 Local<Array> pointerToArray(void *ptr) {
   uintptr_t n = (uintptr_t)ptr;
   Local<Array> result = Nan::New<Array>(2);
@@ -11,4 +15,119 @@ Local<Array> pointerToArray(void *ptr) {
 void *arrayToPointer(Local<Array> array) {
   uintptr_t n = ((uintptr_t)array->Get(0)->Uint32Value() << 32) | (uintptr_t)array->Get(1)->Uint32Value();
   return (void *)n;
-}
\ No newline at end of file
+}
+namespace keys {
+
+static const char *keyNames[] = {
+#define JS_KEY_NAME(key) #key,
+  JS_KEYS(JS_KEY_NAME)
+#undef JS_KEY_NAME
+};
+
+struct KeyTable {
+  Persistent<String> strings[NUM_KEYS];
+  // the bindings' exports object; once it is collected the isolate has no further use for the table
+  Persistent<Object> owner;
+};
+
+static std::mutex keyTablesMutex;
+static std::map<Isolate *, KeyTable *> keyTables;
+// bumped whenever a table is freed, so other threads drop their cached pointer to it
+static std::atomic<unsigned int> keyTablesGeneration(0);
+static thread_local Isolate *lastIsolate = nullptr;
+static thread_local KeyTable *lastKeyTable = nullptr;
+static thread_local unsigned int lastGeneration = 0;
+
+static KeyTable *makeKeyTable(Isolate *isolate) {
+  KeyTable *keyTable = new KeyTable();
+  for (size_t i = 0; i < NUM_KEYS; i++) {
+    keyTable->strings[i].Reset(isolate, String::NewFromUtf8(isolate, keyNames[i], NewStringType::kInternalized).ToLocalChecked());
+  }
+  return keyTable;
+}
+
+static void disposeCollected(const WeakCallbackInfo<Isolate> &info) {
+  dispose(info.GetParameter());
+}
+
+static void ownerCollected(const WeakCallbackInfo<Isolate> &info) {
+  Isolate *isolate = info.GetParameter();
+  {
+    std::lock_guard<std::mutex> lock(keyTablesMutex);
+    auto iter = keyTables.find(isolate);
+    if (iter != keyTables.end()) {
+      iter->second->owner.Reset();
+    }
+  }
+  info.SetSecondPassCallback(disposeCollected);
+}
+
+// Called when the bindings are loaded into an isolate. The table is freed by dispose, or when owner is collected.
+void init(Isolate *isolate, Local<Object> owner) {
+  KeyTable *keyTable = makeKeyTable(isolate);
+  if (!owner.IsEmpty()) {
+    keyTable->owner.Reset(isolate, owner);
+    keyTable->owner.SetWeak(isolate, ownerCollected, WeakCallbackType::kParameter);
+  }
+  KeyTable *oldKeyTable = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(keyTablesMutex);
+    KeyTable *&entry = keyTables[isolate];
+    oldKeyTable = entry;
+    entry = keyTable;
+  }
+  if (oldKeyTable) {
+    // left behind by a disposed isolate at the same address, whose handles went with it
+    delete oldKeyTable;
+    keyTablesGeneration++;
+  }
+  lastIsolate = isolate;
+  lastKeyTable = keyTable;
+  lastGeneration = keyTablesGeneration;
+}
+
+// Must run on the isolate's thread before it is disposed.
+void dispose(Isolate *isolate) {
+  KeyTable *keyTable = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(keyTablesMutex);
+    auto iter = keyTables.find(isolate);
+    if (iter != keyTables.end()) {
+      keyTable = iter->second;
+      keyTables.erase(iter);
+    }
+  }
+  if (keyTable) {
+    for (size_t i = 0; i < NUM_KEYS; i++) {
+      keyTable->strings[i].Reset();
+    }
+    keyTable->owner.Reset();
+    delete keyTable;
+    keyTablesGeneration++;
+  }
+  if (lastIsolate == isolate) {
+    lastIsolate = nullptr;
+    lastKeyTable = nullptr;
+  }
+}
+
+Local<String> get(Isolate *isolate, Key key) {
+  if (isolate != lastIsolate || lastGeneration != keyTablesGeneration.load(std::memory_order_relaxed)) {
+    KeyTable *keyTable;
+    {
+      std::lock_guard<std::mutex> lock(keyTablesMutex);
+      auto iter = keyTables.find(isolate);
+      keyTable = iter != keyTables.end() ? iter->second : nullptr;
+    }
+    if (!keyTable) {
+      init(isolate, Local<Object>());
+    } else {
+      lastIsolate = isolate;
+      lastKeyTable = keyTable;
+      lastGeneration = keyTablesGeneration;
+    }
+  }
+  return Local<String>::New(isolate, lastKeyTable->strings[key]);
+}
+
+}
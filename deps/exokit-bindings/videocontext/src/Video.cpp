@@ -244,10 +244,10 @@ Handle<Object> Video::Initialize(Isolate *isolate) {
   Nan::SetMethod(proto, "update", Update);
   Nan::SetMethod(proto, "play", Play);
   Nan::SetMethod(proto, "pause", Pause);
-  Nan::SetAccessor(proto, JS_STR("width"), WidthGetter);
-  Nan::SetAccessor(proto, JS_STR("height"), HeightGetter);
+  Nan::SetAccessor(proto, JS_KEY(width), WidthGetter);
+  Nan::SetAccessor(proto, JS_KEY(height), HeightGetter);
   Nan::SetAccessor(proto, JS_STR("loop"), LoopGetter, LoopSetter);
-  Nan::SetAccessor(proto, JS_STR("data"), DataGetter);
+  Nan::SetAccessor(proto, JS_KEY(data), DataGetter);
   Nan::SetAccessor(proto, JS_STR("currentTime"), CurrentTimeGetter, CurrentTimeSetter);
   Nan::SetAccessor(proto, JS_STR("duration"), DurationGetter);
 
@@ -502,8 +502,8 @@ NAN_METHOD(Video::GetDevices) {
     const DeviceString& name(device.second);
     Local<Object> obj = Object::New(Isolate::GetCurrent());
     lst->Set(i++, obj);
-    obj->Set(JS_STR("id"), JS_STR(id.c_str()));
-    obj->Set(JS_STR("name"), JS_STR(name.c_str()));
+    obj->Set(JS_KEY(id), JS_STR(id.c_str()));
+    obj->Set(JS_KEY(name), JS_STR(name.c_str()));
 
     VideoModeList modes;
     VideoMode::getDeviceModes(modes, id);
@@ -513,8 +513,8 @@ NAN_METHOD(Video::GetDevices) {
     for (auto mode : modes) {
       Local<Object> obj = Object::New(Isolate::GetCurrent());
       lst->Set(j++, obj);
-      obj->Set(JS_STR("width"), JS_NUM(mode.width));
-      obj->Set(JS_STR("height"), JS_NUM(mode.height));
+      obj->Set(JS_KEY(width), JS_NUM(mode.width));
+      obj->Set(JS_KEY(height), JS_NUM(mode.height));
       obj->Set(JS_STR("fps"), JS_NUM(mode.FPS));
     }
     obj->Set(JS_STR("modes"), lst);
@@ -575,10 +575,10 @@ Handle<Object> VideoDevice::Initialize(Isolate *isolate, Local<Value> imageDataC
   Local<ObjectTemplate> proto = ctor->PrototypeTemplate();
   Nan::SetMethod(proto, "open", Open);
   Nan::SetMethod(proto, "close", Close);
-  Nan::SetAccessor(proto, JS_STR("width"), WidthGetter);
-  Nan::SetAccessor(proto, JS_STR("height"), HeightGetter);
+  Nan::SetAccessor(proto, JS_KEY(width), WidthGetter);
+  Nan::SetAccessor(proto, JS_KEY(height), HeightGetter);
   Nan::SetAccessor(proto, JS_STR("size"), SizeGetter);
-  Nan::SetAccessor(proto, JS_STR("data"), DataGetter);
+  Nan::SetAccessor(proto, JS_KEY(data), DataGetter);
   Nan::SetAccessor(proto, JS_STR("imageData"), ImageDataGetter);
 
   Local<Function> ctorFn = ctor->GetFunction();
@@ -672,7 +672,7 @@ NAN_GETTER(VideoDevice::DataGetter) {
       double h = video->dev->getHeight();
 
       Local<Function> imageDataCons = Local<Function>::Cast(
-          Local<Object>::Cast(info.This())->Get(JS_STR("constructor"))->ToObject()->Get(JS_STR("ImageData"))
+          Local<Object>::Cast(info.This())->Get(JS_KEY(constructor))->ToObject()->Get(JS_KEY(ImageData))
           );
       Local<Value> argv[] = {
         Number::New(Isolate::GetCurrent(), w),
@@ -681,7 +681,7 @@ NAN_GETTER(VideoDevice::DataGetter) {
       video->imageData.Reset(imageDataCons->NewInstance(Isolate::GetCurrent()->GetCurrentContext(), sizeof(argv)/sizeof(argv[0]), argv).ToLocalChecked());
     }
 
-    auto data = Nan::New(video->imageData)->Get(JS_STR("data"));
+    auto data = Nan::New(video->imageData)->Get(JS_KEY(data));
     if (data->IsUint8ClampedArray()) {
       auto uint8ClampedArray = Uint8ClampedArray::Cast(*data);
       uint8_t *buffer = (uint8_t *)uint8ClampedArray->Buffer()->GetContents().Data() + uint8ClampedArray->ByteOffset();
@@ -690,7 +690,7 @@ NAN_GETTER(VideoDevice::DataGetter) {
   }
 
   if (!video->imageData.IsEmpty()) {
-    info.GetReturnValue().Set(Nan::New(video->imageData)->Get(JS_STR("data")));
+    info.GetReturnValue().Set(Nan::New(video->imageData)->Get(JS_KEY(data)));
   } else {
     info.GetReturnValue().Set(Nan::Null());
   }
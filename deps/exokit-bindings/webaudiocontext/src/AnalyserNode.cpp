@@ -40,7 +40,7 @@ void AnalyserNode::InitializePrototype(Local<ObjectTemplate> proto) {
 NAN_METHOD(AnalyserNode::New) {
   Nan::HandleScope scope;
 
-  if (info[0]->IsObject() && info[0]->ToObject()->Get(JS_STR("constructor"))->ToObject()->Get(JS_STR("name"))->StrictEquals(JS_STR("AudioContext"))) {
+  if (info[0]->IsObject() && info[0]->ToObject()->Get(JS_KEY(constructor))->ToObject()->Get(JS_KEY(name))->StrictEquals(JS_KEY(AudioContext))) {
     Local<Object> audioContextObj = Local<Object>::Cast(info[0]);
 
     AnalyserNode *analyserNode = new AnalyserNode();
@@ -195,7 +195,7 @@ void AudioBufferSourceNode::InitializePrototype(Local<ObjectTemplate> proto) {
 NAN_METHOD(AudioBufferSourceNode::New) {
   // Nan::HandleScope scope;
 
-  if (info[0]->IsObject() && info[0]->ToObject()->Get(JS_STR("constructor"))->ToObject()->Get(JS_STR("name"))->StrictEquals(JS_STR("AudioContext"))) {
+  if (info[0]->IsObject() && info[0]->ToObject()->Get(JS_KEY(constructor))->ToObject()->Get(JS_KEY(name))->StrictEquals(JS_KEY(AudioContext))) {
     Local<Object> audioContextObj = Local<Object>::Cast(info[0]);
     AudioContext *audioContext = ObjectWrap::Unwrap<AudioContext>(audioContextObj);
 
@@ -237,7 +237,7 @@ NAN_SETTER(AudioBufferSourceNode::BufferSetter) {
   AudioContext *audioContext = ObjectWrap::Unwrap<AudioContext>(audioContextObj);
   lab::FinishableSourceNode *audioNode = (lab::FinishableSourceNode *)audioBufferSourceNode->audioNode.get();
 
-  if (value->IsObject() && value->ToObject()->Get(JS_STR("constructor"))->ToObject()->Get(JS_STR("name"))->StrictEquals(JS_STR("AudioBuffer"))) {
+  if (value->IsObject() && value->ToObject()->Get(JS_KEY(constructor))->ToObject()->Get(JS_KEY(name))->StrictEquals(JS_KEY(AudioBuffer))) {
     Local<Object> audioBufferObj = Local<Object>::Cast(value);
     audioBufferSourceNode->buffer.Reset(audioBufferObj);
 
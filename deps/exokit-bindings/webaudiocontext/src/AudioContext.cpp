@@ -247,14 +247,14 @@ NAN_METHOD(AudioContext::New) {
   AudioContext *audioContext = new AudioContext(sampleRate);
   audioContext->Wrap(audioContextObj);
 
-  Local<Function> audioDestinationNodeConstructor = Local<Function>::Cast(audioContextObj->Get(JS_STR("constructor"))->ToObject()->Get(JS_STR("AudioDestinationNode")));
+  Local<Function> audioDestinationNodeConstructor = Local<Function>::Cast(audioContextObj->Get(JS_KEY(constructor))->ToObject()->Get(JS_STR("AudioDestinationNode")));
   Local<Value> argv1[] = {
     audioContextObj,
   };
   Local<Object> audioDestinationNodeObj = audioDestinationNodeConstructor->NewInstance(Isolate::GetCurrent()->GetCurrentContext(), sizeof(argv1)/sizeof(argv1[0]), argv1).ToLocalChecked();
   audioContextObj->Set(JS_STR("destination"), audioDestinationNodeObj);
 
-  Local<Function> audioListenerConstructor = Local<Function>::Cast(audioContextObj->Get(JS_STR("constructor"))->ToObject()->Get(JS_STR("AudioListener")));
+  Local<Function> audioListenerConstructor = Local<Function>::Cast(audioContextObj->Get(JS_KEY(constructor))->ToObject()->Get(JS_STR("AudioListener")));
   Local<Value> argv2[] = {
     audioContextObj,
   };
@@ -280,7 +280,7 @@ NAN_METHOD(AudioContext::_DecodeAudioDataSync) {
 
     Local<ArrayBuffer> srcArrayBuffer = Local<ArrayBuffer>::Cast(info[0]);
 
-    Local<Function> audioBufferConstructor = Local<Function>::Cast(audioContextObj->Get(JS_STR("constructor"))->ToObject()->Get(JS_STR("AudioBuffer")));
+    Local<Function> audioBufferConstructor = Local<Function>::Cast(audioContextObj->Get(JS_KEY(constructor))->ToObject()->Get(JS_KEY(AudioBuffer)));
     Local<Value> audioBufferObj = audioContext->_DecodeAudioDataSync(audioBufferConstructor, srcArrayBuffer);
 
     info.GetReturnValue().Set(audioBufferObj);
@@ -292,13 +292,13 @@ NAN_METHOD(AudioContext::_DecodeAudioDataSync) {
 NAN_METHOD(AudioContext::CreateMediaElementSource) {
   Nan::HandleScope scope;
 
-  if (info[0]->IsObject() && info[0]->ToObject()->Get(JS_STR("constructor"))->ToObject()->Get(JS_STR("name"))->StrictEquals(JS_STR("HTMLAudioElement"))) {
+  if (info[0]->IsObject() && info[0]->ToObject()->Get(JS_KEY(constructor))->ToObject()->Get(JS_KEY(name))->StrictEquals(JS_KEY(HTMLAudioElement))) {
     Local<Object> htmlAudioElement = Local<Object>::Cast(info[0]);
 
     Local<Object> audioContextObj = info.This();
     AudioContext *audioContext = ObjectWrap::Unwrap<AudioContext>(audioContextObj);
 
-    Local<Function> audioDestinationNodeConstructor = Local<Function>::Cast(audioContextObj->Get(JS_STR("constructor"))->ToObject()->Get(JS_STR("AudioSourceNode")));
+    Local<Function> audioDestinationNodeConstructor = Local<Function>::Cast(audioContextObj->Get(JS_KEY(constructor))->ToObject()->Get(JS_STR("AudioSourceNode")));
     Local<Object> audioNodeObj = audioContext->CreateMediaElementSource(audioDestinationNodeConstructor, htmlAudioElement, audioContextObj);
 
     info.GetReturnValue().Set(audioNodeObj);
@@ -310,13 +310,13 @@ NAN_METHOD(AudioContext::CreateMediaElementSource) {
 NAN_METHOD(AudioContext::CreateMediaStreamSource) {
   Nan::HandleScope scope;
 
-  if (info[0]->IsObject() && info[0]->ToObject()->Get(JS_STR("constructor"))->ToObject()->Get(JS_STR("name"))->StrictEquals(JS_STR("MicrophoneMediaStream"))) {
+  if (info[0]->IsObject() && info[0]->ToObject()->Get(JS_KEY(constructor))->ToObject()->Get(JS_KEY(name))->StrictEquals(JS_KEY(MicrophoneMediaStream))) {
     Local<Object> microphoneMediaStream = Local<Object>::Cast(info[0]);
 
     Local<Object> audioContextObj = info.This();
     AudioContext *audioContext = ObjectWrap::Unwrap<AudioContext>(audioContextObj);
 
-    Local<Function> audioSourceNodeConstructor = Local<Function>::Cast(audioContextObj->Get(JS_STR("constructor"))->ToObject()->Get(JS_STR("AudioSourceNode")));
+    Local<Function> audioSourceNodeConstructor = Local<Function>::Cast(audioContextObj->Get(JS_KEY(constructor))->ToObject()->Get(JS_STR("AudioSourceNode")));
     Local<Object> audioNodeObj = audioContext->CreateMediaStreamSource(audioSourceNodeConstructor, microphoneMediaStream, audioContextObj);
 
     info.GetReturnValue().Set(audioNodeObj);
@@ -345,7 +345,7 @@ NAN_METHOD(AudioContext::CreateGain) {
   Local<Object> audioContextObj = info.This();
   AudioContext *audioContext = ObjectWrap::Unwrap<AudioContext>(audioContextObj);
 
-  Local<Function> gainNodeConstructor = Local<Function>::Cast(audioContextObj->Get(JS_STR("constructor"))->ToObject()->Get(JS_STR("GainNode")));
+  Local<Function> gainNodeConstructor = Local<Function>::Cast(audioContextObj->Get(JS_KEY(constructor))->ToObject()->Get(JS_STR("GainNode")));
   Local<Object> gainNodeObj = audioContext->CreateGain(gainNodeConstructor, audioContextObj);
 
   info.GetReturnValue().Set(gainNodeObj);
@@ -357,7 +357,7 @@ NAN_METHOD(AudioContext::CreateAnalyser) {
   Local<Object> audioContextObj = info.This();
   AudioContext *audioContext = ObjectWrap::Unwrap<AudioContext>(audioContextObj);
 
-  Local<Function> analyserNodeConstructor = Local<Function>::Cast(audioContextObj->Get(JS_STR("constructor"))->ToObject()->Get(JS_STR("AnalyserNode")));
+  Local<Function> analyserNodeConstructor = Local<Function>::Cast(audioContextObj->Get(JS_KEY(constructor))->ToObject()->Get(JS_STR("AnalyserNode")));
   Local<Object> analyserNodeObj = audioContext->CreateAnalyser(analyserNodeConstructor, audioContextObj);
 
   info.GetReturnValue().Set(analyserNodeObj);
@@ -369,7 +369,7 @@ NAN_METHOD(AudioContext::CreatePanner) {
   Local<Object> audioContextObj = info.This();
   AudioContext *audioContext = ObjectWrap::Unwrap<AudioContext>(audioContextObj);
 
-  Local<Function> pannerNodeConstructor = Local<Function>::Cast(audioContextObj->Get(JS_STR("constructor"))->ToObject()->Get(JS_STR("PannerNode")));
+  Local<Function> pannerNodeConstructor = Local<Function>::Cast(audioContextObj->Get(JS_KEY(constructor))->ToObject()->Get(JS_STR("PannerNode")));
   Local<Object> pannerNodeObj = audioContext->CreatePanner(pannerNodeConstructor, audioContextObj);
 
   info.GetReturnValue().Set(pannerNodeObj);
@@ -381,7 +381,7 @@ NAN_METHOD(AudioContext::CreateStereoPanner) {
   Local<Object> audioContextObj = info.This();
   AudioContext *audioContext = ObjectWrap::Unwrap<AudioContext>(audioContextObj);
 
-  Local<Function> stereoPannerNodeConstructor = Local<Function>::Cast(audioContextObj->Get(JS_STR("constructor"))->ToObject()->Get(JS_STR("StereoPannerNode")));
+  Local<Function> stereoPannerNodeConstructor = Local<Function>::Cast(audioContextObj->Get(JS_KEY(constructor))->ToObject()->Get(JS_STR("StereoPannerNode")));
   Local<Object> stereoPannerNodeObj = audioContext->CreateStereoPanner(stereoPannerNodeConstructor, audioContextObj);
 
   info.GetReturnValue().Set(stereoPannerNodeObj);
@@ -393,7 +393,7 @@ NAN_METHOD(AudioContext::CreateOscillator) {
   Local<Object> audioContextObj = info.This();
   AudioContext *audioContext = ObjectWrap::Unwrap<AudioContext>(audioContextObj);
 
-  Local<Function> oscillatorNodeConstructor = Local<Function>::Cast(audioContextObj->Get(JS_STR("constructor"))->ToObject()->Get(JS_STR("OscillatorNode")));
+  Local<Function> oscillatorNodeConstructor = Local<Function>::Cast(audioContextObj->Get(JS_KEY(constructor))->ToObject()->Get(JS_STR("OscillatorNode")));
   Local<Object> oscillatorNodeObj = audioContext->CreateOscillator(oscillatorNodeConstructor, audioContextObj);
 
   info.GetReturnValue().Set(oscillatorNodeObj);
@@ -410,7 +410,7 @@ NAN_METHOD(AudioContext::CreateBuffer) {
     Local<Object> audioContextObj = info.This();
     AudioContext *audioContext = ObjectWrap::Unwrap<AudioContext>(audioContextObj);
 
-    Local<Function> audioBufferConstructor = Local<Function>::Cast(audioContextObj->Get(JS_STR("constructor"))->ToObject()->Get(JS_STR("AudioBuffer")));
+    Local<Function> audioBufferConstructor = Local<Function>::Cast(audioContextObj->Get(JS_KEY(constructor))->ToObject()->Get(JS_KEY(AudioBuffer)));
     Local<Object> audioBufferObj = audioContext->CreateBuffer(audioBufferConstructor, numOfChannels, length, sampleRate);
 
     info.GetReturnValue().Set(audioBufferObj);
@@ -425,7 +425,7 @@ NAN_METHOD(AudioContext::CreateBufferSource) {
   Local<Object> audioContextObj = info.This();
   AudioContext *audioContext = ObjectWrap::Unwrap<AudioContext>(audioContextObj);
 
-  Local<Function> audioBufferSourceNodeConstructor = Local<Function>::Cast(audioContextObj->Get(JS_STR("constructor"))->ToObject()->Get(JS_STR("AudioBufferSourceNode")));
+  Local<Function> audioBufferSourceNodeConstructor = Local<Function>::Cast(audioContextObj->Get(JS_KEY(constructor))->ToObject()->Get(JS_STR("AudioBufferSourceNode")));
   Local<Object> audioBufferSourceNodeObj = audioContext->CreateBufferSource(audioBufferSourceNodeConstructor, audioContextObj);
 
   info.GetReturnValue().Set(audioBufferSourceNodeObj);
@@ -441,7 +441,7 @@ NAN_METHOD(AudioContext::CreateScriptProcessor) {
   Local<Object> audioContextObj = info.This();
   AudioContext *audioContext = ObjectWrap::Unwrap<AudioContext>(audioContextObj);
 
-  Local<Function> scriptProcessorNodeConstructor = Local<Function>::Cast(audioContextObj->Get(JS_STR("constructor"))->ToObject()->Get(JS_STR("ScriptProcessorNode")));
+  Local<Function> scriptProcessorNodeConstructor = Local<Function>::Cast(audioContextObj->Get(JS_KEY(constructor))->ToObject()->Get(JS_STR("ScriptProcessorNode")));
   Local<Object> scriptProcessorNodeObj = audioContext->CreateScriptProcessor(scriptProcessorNodeConstructor, bufferSize, numberOfInputChannels, numberOfOutputChannels, audioContextObj);
 
   info.GetReturnValue().Set(scriptProcessorNodeObj);
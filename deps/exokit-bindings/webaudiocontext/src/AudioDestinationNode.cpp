@@ -31,7 +31,7 @@ void AudioDestinationNode::InitializePrototype(Local<ObjectTemplate> proto) {
 NAN_METHOD(AudioDestinationNode::New) {
   Nan::HandleScope scope;
 
-  if (info[0]->IsObject() && info[0]->IsObject() && info[0]->ToObject()->Get(JS_STR("constructor"))->ToObject()->Get(JS_STR("name"))->StrictEquals(JS_STR("AudioContext"))) {
+  if (info[0]->IsObject() && info[0]->IsObject() && info[0]->ToObject()->Get(JS_KEY(constructor))->ToObject()->Get(JS_KEY(name))->StrictEquals(JS_KEY(AudioContext))) {
     Local<Object> audioContextObj = Local<Object>::Cast(info[0]);
     AudioContext *audioContext = ObjectWrap::Unwrap<AudioContext>(audioContextObj);
     lab::AudioContext *labAudioContext = audioContext->audioContext;
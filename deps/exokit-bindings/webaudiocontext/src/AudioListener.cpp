@@ -29,7 +29,7 @@ Handle<Object> AudioListener::Initialize(Isolate *isolate, Local<Value> fakeAudi
 NAN_METHOD(AudioListener::New) {
   Nan::HandleScope scope;
 
-  if (info[0]->IsObject() && info[0]->ToObject()->Get(JS_STR("constructor"))->ToObject()->Get(JS_STR("name"))->StrictEquals(JS_STR("AudioContext"))) {
+  if (info[0]->IsObject() && info[0]->ToObject()->Get(JS_KEY(constructor))->ToObject()->Get(JS_KEY(name))->StrictEquals(JS_KEY(AudioContext))) {
     Local<Object> audioContextObj = Local<Object>::Cast(info[0]);
     AudioContext *audioContext = ObjectWrap::Unwrap<AudioContext>(audioContextObj);
 
@@ -40,7 +40,7 @@ NAN_METHOD(AudioListener::New) {
     lab::AudioListener *labAudioListener = &audioContext->audioContext->listener();
     audioListener->audioListener = labAudioListener;
     
-    Local<Function> fakeAudioParamConstructor = Local<Function>::Cast(audioListenerObj->Get(JS_STR("constructor"))->ToObject()->Get(JS_STR("FakeAudioParam")));
+    Local<Function> fakeAudioParamConstructor = Local<Function>::Cast(audioListenerObj->Get(JS_KEY(constructor))->ToObject()->Get(JS_STR("FakeAudioParam")));
 
     Local<Object> positionXAudioParamObj = fakeAudioParamConstructor->NewInstance(Isolate::GetCurrent()->GetCurrentContext(), 0, nullptr).ToLocalChecked();
     FakeAudioParam *positionXAudioParam = ObjectWrap::Unwrap<FakeAudioParam>(positionXAudioParamObj);
@@ -49,7 +49,7 @@ NAN_METHOD(AudioNode::Connect) {
   Nan::HandleScope scope;
 
   if (info[0]->IsObject()) {
-    Local<Value> constructorName = info[0]->ToObject()->Get(JS_STR("constructor"))->ToObject()->Get(JS_STR("name"));
+    Local<Value> constructorName = info[0]->ToObject()->Get(JS_KEY(constructor))->ToObject()->Get(JS_KEY(name));
 
     if (
       constructorName->StrictEquals(JS_STR("AudioSourceNode")) ||
@@ -146,7 +146,7 @@ NAN_METHOD(AudioNode::Disconnect) {
     }
   } else {
     if (info[0]->IsObject()) {
-      Local<Value> constructorName = info[0]->ToObject()->Get(JS_STR("constructor"))->ToObject()->Get(JS_STR("name"));
+      Local<Value> constructorName = info[0]->ToObject()->Get(JS_KEY(constructor))->ToObject()->Get(JS_KEY(name));
 
       if (
         constructorName->StrictEquals(JS_STR("AudioSourceNode")) ||
@@ -31,14 +31,14 @@ void AudioSourceNode::InitializePrototype(Local<ObjectTemplate> proto) {
 NAN_METHOD(AudioSourceNode::New) {
   Nan::HandleScope scope;
 
-  if (info[1]->IsObject() && info[1]->ToObject()->Get(JS_STR("constructor"))->ToObject()->Get(JS_STR("name"))->StrictEquals(JS_STR("AudioContext"))) {
+  if (info[1]->IsObject() && info[1]->ToObject()->Get(JS_KEY(constructor))->ToObject()->Get(JS_KEY(name))->StrictEquals(JS_KEY(AudioContext))) {
     Local<Object> audioContextObj = Local<Object>::Cast(info[1]);
 
-    if (info[0]->IsObject() && info[0]->ToObject()->Get(JS_STR("constructor"))->ToObject()->Get(JS_STR("name"))->StrictEquals(JS_STR("HTMLAudioElement"))) {
+    if (info[0]->IsObject() && info[0]->ToObject()->Get(JS_KEY(constructor))->ToObject()->Get(JS_KEY(name))->StrictEquals(JS_KEY(HTMLAudioElement))) {
       Local<Object> htmlAudioElement = Local<Object>::Cast(info[0]);
       Local<Value> audioValue = htmlAudioElement->Get(JS_STR("audio"));
 
-      if (audioValue->BooleanValue() && audioValue->IsObject() && audioValue->ToObject()->Get(JS_STR("constructor"))->ToObject()->Get(JS_STR("name"))->StrictEquals(JS_STR("Audio"))) {
+      if (audioValue->BooleanValue() && audioValue->IsObject() && audioValue->ToObject()->Get(JS_KEY(constructor))->ToObject()->Get(JS_KEY(name))->StrictEquals(JS_STR("Audio"))) {
         Audio *audio = ObjectWrap::Unwrap<Audio>(Local<Object>::Cast(audioValue));
 
         AudioSourceNode *audioSourceNode = new AudioSourceNode();
@@ -52,7 +52,7 @@ NAN_METHOD(AudioSourceNode::New) {
       } else {
         Nan::ThrowError("AudioSourceNode: invalid audio element state");
       }
-    } else if (info[0]->IsObject() && info[0]->ToObject()->Get(JS_STR("constructor"))->ToObject()->Get(JS_STR("name"))->StrictEquals(JS_STR("MicrophoneMediaStream"))) {
+    } else if (info[0]->IsObject() && info[0]->ToObject()->Get(JS_KEY(constructor))->ToObject()->Get(JS_KEY(name))->StrictEquals(JS_KEY(MicrophoneMediaStream))) {
       Local<Object> microphoneMediaStreamObj = Local<Object>::Cast(info[0]);
       MicrophoneMediaStream *microphoneMediaStream = ObjectWrap::Unwrap<MicrophoneMediaStream>(Local<Object>::Cast(microphoneMediaStreamObj));
 
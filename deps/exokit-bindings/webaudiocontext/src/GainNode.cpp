@@ -34,7 +34,7 @@ void GainNode::InitializePrototype(Local<ObjectTemplate> proto) {
 NAN_METHOD(GainNode::New) {
   Nan::HandleScope scope;
 
-  if (info[0]->IsObject() && info[0]->ToObject()->Get(JS_STR("constructor"))->ToObject()->Get(JS_STR("name"))->StrictEquals(JS_STR("AudioContext"))) {
+  if (info[0]->IsObject() && info[0]->ToObject()->Get(JS_KEY(constructor))->ToObject()->Get(JS_KEY(name))->StrictEquals(JS_KEY(AudioContext))) {
     Local<Object> audioContextObj = Local<Object>::Cast(info[0]);
 
     GainNode *gainNode = new GainNode();
@@ -44,7 +44,7 @@ NAN_METHOD(GainNode::New) {
     gainNode->context.Reset(audioContextObj);
     gainNode->audioNode = make_shared<lab::GainNode>();
 
-    Local<Function> audioParamConstructor = Local<Function>::Cast(gainNodeObj->Get(JS_STR("constructor"))->ToObject()->Get(JS_STR("AudioParam")));
+    Local<Function> audioParamConstructor = Local<Function>::Cast(gainNodeObj->Get(JS_KEY(constructor))->ToObject()->Get(JS_KEY(AudioParam)));
     Local<Object> gainAudioParamObj = audioParamConstructor->NewInstance(Isolate::GetCurrent()->GetCurrentContext(), 0, nullptr).ToLocalChecked();
     AudioParam *gainAudioParam = ObjectWrap::Unwrap<AudioParam>(gainAudioParamObj);
     gainAudioParam->audioParam = (*(shared_ptr<lab::GainNode> *)(&gainNode->audioNode))->gain();
@@ -35,7 +35,7 @@ void MediaStreamTrack::InitializePrototype(Local<ObjectTemplate> proto) {
 NAN_METHOD(MediaStreamTrack::New) {
   Nan::HandleScope scope;
 
-  if (info[0]->IsObject() && info[0]->ToObject()->Get(JS_STR("constructor"))->ToObject()->Get(JS_STR("name"))->StrictEquals(JS_STR("MicrophoneMediaStream"))) {
+  if (info[0]->IsObject() && info[0]->ToObject()->Get(JS_KEY(constructor))->ToObject()->Get(JS_KEY(name))->StrictEquals(JS_KEY(MicrophoneMediaStream))) {
     Local<Object> microphoneMediaStreamObj = Local<Object>::Cast(info[0]);
     MicrophoneMediaStream *microphoneMediaStream = ObjectWrap::Unwrap<MicrophoneMediaStream>(microphoneMediaStreamObj);
     
@@ -37,7 +37,7 @@ NAN_METHOD(MicrophoneMediaStream::New) {
   Local<Object> microphoneMediaStreamObj = info.This();
   microphoneMediaStream->Wrap(microphoneMediaStreamObj);
 
-  Local<Function> mediaStreamTrackConstructor = Local<Function>::Cast(microphoneMediaStreamObj->Get(JS_STR("constructor"))->ToObject()->Get(JS_STR("MediaStreamTrack")));
+  Local<Function> mediaStreamTrackConstructor = Local<Function>::Cast(microphoneMediaStreamObj->Get(JS_KEY(constructor))->ToObject()->Get(JS_STR("MediaStreamTrack")));
   Local<Value> argv[] = {
     microphoneMediaStreamObj,
   };
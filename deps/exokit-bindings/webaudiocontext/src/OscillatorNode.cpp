@@ -34,7 +34,7 @@ void OscillatorNode::InitializePrototype(Local<ObjectTemplate> proto) {
 NAN_METHOD(OscillatorNode::New) {
   Nan::HandleScope scope;
 
-  if (info[0]->IsObject() && info[0]->ToObject()->Get(JS_STR("constructor"))->ToObject()->Get(JS_STR("name"))->StrictEquals(JS_STR("AudioContext"))) {
+  if (info[0]->IsObject() && info[0]->ToObject()->Get(JS_KEY(constructor))->ToObject()->Get(JS_KEY(name))->StrictEquals(JS_KEY(AudioContext))) {
     Local<Object> audioContextObj = Local<Object>::Cast(info[0]);
 
     OscillatorNode *oscillatorNode = new OscillatorNode();
@@ -45,7 +45,7 @@ NAN_METHOD(OscillatorNode::New) {
     oscillatorNode->context.Reset(audioContextObj);
     oscillatorNode->audioNode = make_shared<lab::OscillatorNode>(sampleRate);
 
-    Local<Function> audioParamConstructor = Local<Function>::Cast(oscillatorNodeObj->Get(JS_STR("constructor"))->ToObject()->Get(JS_STR("AudioParam")));
+    Local<Function> audioParamConstructor = Local<Function>::Cast(oscillatorNodeObj->Get(JS_KEY(constructor))->ToObject()->Get(JS_KEY(AudioParam)));
 
     Local<Object> frequencyAudioParamObj = audioParamConstructor->NewInstance(Isolate::GetCurrent()->GetCurrentContext(), 0, nullptr).ToLocalChecked();
     AudioParam *frequencyAudioParam = ObjectWrap::Unwrap<AudioParam>(frequencyAudioParamObj);
@@ -48,7 +48,7 @@ void PannerNode::InitializePrototype(Local<ObjectTemplate> proto) {
 NAN_METHOD(PannerNode::New) {
   Nan::HandleScope scope;
 
-  if (info[0]->IsObject() && info[0]->ToObject()->Get(JS_STR("constructor"))->ToObject()->Get(JS_STR("name"))->StrictEquals(JS_STR("AudioContext"))) {
+  if (info[0]->IsObject() && info[0]->ToObject()->Get(JS_KEY(constructor))->ToObject()->Get(JS_KEY(name))->StrictEquals(JS_KEY(AudioContext))) {
     Local<Object> audioContextObj = Local<Object>::Cast(info[0]);
 
     PannerNode *pannerNode = new PannerNode();
@@ -60,7 +60,7 @@ NAN_METHOD(PannerNode::New) {
     pannerNode->context.Reset(audioContextObj);
     pannerNode->audioNode = labPannerNode;
 
-    Local<Function> fakeAudioParamConstructor = Local<Function>::Cast(pannerNodeObj->Get(JS_STR("constructor"))->ToObject()->Get(JS_STR("FakeAudioParam")));
+    Local<Function> fakeAudioParamConstructor = Local<Function>::Cast(pannerNodeObj->Get(JS_KEY(constructor))->ToObject()->Get(JS_STR("FakeAudioParam")));
 
     Local<Object> positionXAudioParamObj = fakeAudioParamConstructor->NewInstance(Isolate::GetCurrent()->GetCurrentContext(), 0, nullptr).ToLocalChecked();
     FakeAudioParam *positionXAudioParam = ObjectWrap::Unwrap<FakeAudioParam>(positionXAudioParamObj);
@@ -104,7 +104,7 @@ NAN_METHOD(ScriptProcessorNode::New) {
 
   if (
     info[0]->IsNumber() && info[1]->IsNumber() && info[2]->IsNumber() &&
-    info[3]->IsObject() && info[3]->ToObject()->Get(JS_STR("constructor"))->ToObject()->Get(JS_STR("name"))->StrictEquals(JS_STR("AudioContext"))
+    info[3]->IsObject() && info[3]->ToObject()->Get(JS_KEY(constructor))->ToObject()->Get(JS_KEY(name))->StrictEquals(JS_KEY(AudioContext))
   ) {
     uint32_t bufferSize = info[0]->Uint32Value();
     uint32_t numberOfInputChannels = info[1]->Uint32Value();
@@ -123,9 +123,9 @@ NAN_METHOD(ScriptProcessorNode::New) {
       });
       scriptProcessorNode->audioNode.reset(labScriptProcessorNode);
 
-      Local<Function> audioBufferConstructor = Local<Function>::Cast(scriptProcessorNodeObj->Get(JS_STR("constructor"))->ToObject()->Get(JS_STR("AudioBuffer")));
+      Local<Function> audioBufferConstructor = Local<Function>::Cast(scriptProcessorNodeObj->Get(JS_KEY(constructor))->ToObject()->Get(JS_KEY(AudioBuffer)));
       scriptProcessorNode->audioBufferConstructor.Reset(audioBufferConstructor);
-      Local<Function> audioProcessingEventConstructor = Local<Function>::Cast(scriptProcessorNodeObj->Get(JS_STR("constructor"))->ToObject()->Get(JS_STR("AudioProcessingEvent")));
+      Local<Function> audioProcessingEventConstructor = Local<Function>::Cast(scriptProcessorNodeObj->Get(JS_KEY(constructor))->ToObject()->Get(JS_STR("AudioProcessingEvent")));
       scriptProcessorNode->audioProcessingEventConstructor.Reset(audioProcessingEventConstructor);
 
       info.GetReturnValue().Set(scriptProcessorNodeObj);
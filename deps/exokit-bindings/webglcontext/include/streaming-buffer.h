@@ -0,0 +1,44 @@
+#ifndef _WEBGLCONTEXT_STREAMING_BUFFER_H_
+#define _WEBGLCONTEXT_STREAMING_BUFFER_H_
+
+#include <cstdint>
+#include <deque>
+
+// expects the GL headers to already be included (see webgl.h)
+
+// Ring of staging memory used to stream bufferSubData uploads into DYNAMIC_DRAW/STREAM_DRAW buffers.
+// Writes go through an unsynchronized mapping of a region the GPU is known to be done with, then a
+// GPU-side copy into the destination, so the CPU never waits for draws still reading the destination.
+class StreamingBuffer {
+public:
+  StreamingBuffer(GLsizeiptr capacity = 4 * 1024 * 1024);
+  ~StreamingBuffer();
+
+  // Returns false if the upload could not be streamed without stalling; the caller should fall back to glBufferSubData.
+  // The staging buffer is bound to GL_COPY_READ_BUFFER while copying; the caller is responsible for restoring it.
+  bool Upload(GLenum target, GLintptr dstOffset, const void *data, GLsizeiptr size);
+  // Fences everything written since the last call.
+  void EndFrame();
+  void Destroy();
+
+  // Uploads streamed through the ring and uploads turned away, for diagnostics.
+  uint64_t numStreamed;
+  uint64_t numRejected;
+
+protected:
+  void Retire();
+
+  struct Frame {
+    GLsync fence;
+    GLsizeiptr bytes;
+  };
+
+  GLuint buffer;
+  GLsizeiptr capacity;
+  GLsizeiptr head;
+  GLsizeiptr inFlight;
+  GLsizeiptr frameBytes;
+  std::deque<Frame> frames;
+};
+
+#endif
@@ -0,0 +1,93 @@
+#ifndef _WEBGLCONTEXT_TEXTURE_COMPRESSION_H_
+#define _WEBGLCONTEXT_TEXTURE_COMPRESSION_H_
+
+#include <cstdint>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <PackedImageData.h>
+
+// expects the GL headers to already be included (see webgl.h)
+
+// Upload-time compression of decoded images into DXT1/DXT5 or ETC1, whichever the driver supports,
+// or dithered 16-bit RGB565/RGBA4444 packing.
+// Encoding runs on the shared worker pool; until it is done the caller uploads the image as it is and swaps the
+// encoded levels in later. Results are cached by content so the same image uploaded to several textures or contexts
+// is only encoded once.
+class TextureCompression {
+public:
+  enum PackingMode {
+    PACKING_NONE = 0,
+    // large opaque images only
+    PACKING_AUTO,
+    PACKING_ALWAYS,
+  };
+
+  // One image's encoding, shared by the cache and every texture it was uploaded to.
+  struct Upload {
+    canvas::InternalFormat internalFormat;
+    GLenum glInternalFormat;
+    GLenum glFormat;
+    GLenum glType; // 0 for compressed formats
+    GLsizei width;
+    GLsizei height;
+    unsigned short levels;
+    // the RGBA8 level 0 as the caller would have uploaded it, kept to re-upload the texture uncompressed
+    std::shared_ptr<const std::vector<unsigned char>> pixels;
+    // set by the worker once encoded; read under cacheMutex
+    std::shared_ptr<canvas::PackedImageData> packedImageData;
+  };
+
+  // Starts encoding the RGBA8 pixels, or finds them already encoded. Returns null if neither compression nor the
+  // packing mode applies to them.
+  static std::shared_ptr<Upload> Encode(const unsigned char *pixels, GLsizei width, GLsizei height, bool compress, PackingMode packing);
+  static bool IsReady(const Upload &upload);
+  // Uploads the full encoded mip chain into the texture bound to target. Upload must be ready.
+  // Changes GL_UNPACK_ALIGNMENT; the caller restores it.
+  static void TexImage2D(GLenum target, const Upload &upload);
+  // Uploads the original pixels as RGBA8 level 0.
+  static void TexImage2DUncompressed(GLenum target, const Upload &upload);
+
+  static bool HasAlpha(const unsigned char *pixels, GLsizei width, GLsizei height);
+  static unsigned short GetNumLevels(GLsizei width, GLsizei height);
+
+protected:
+  struct Key {
+    uint64_t hash;
+    GLsizei width;
+    GLsizei height;
+    GLenum format;
+    GLenum type;
+
+    bool operator<(const Key &other) const {
+      if (hash != other.hash) return hash < other.hash;
+      if (width != other.width) return width < other.width;
+      if (height != other.height) return height < other.height;
+      if (format != other.format) return format < other.format;
+      return type < other.type;
+    }
+  };
+  struct Entry {
+    std::shared_ptr<Upload> upload;
+    std::list<Key>::iterator lruIter;
+  };
+
+  static void DetectFormats();
+  static void Trim();
+
+  static bool formatsDetected;
+  static bool hasS3tc;
+  static GLenum etc1Format;
+
+  static std::mutex cacheMutex;
+  static std::map<Key, Entry> cache;
+  static std::list<Key> lru;
+  // source pixels plus encoded data of everything in the cache
+  static size_t cacheSize;
+  static const size_t maxCacheSize = 256 * 1024 * 1024;
+};
+
+#endif
@@ -0,0 +1,48 @@
+#ifndef _WEBGLCONTEXT_TEXTURE_CONTAINER_H_
+#define _WEBGLCONTEXT_TEXTURE_CONTAINER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// expects the GL headers to already be included (see webgl.h)
+
+// Mip levels of a KTX, KTX2 or DDS file, pointing into its data.
+class TextureContainer {
+public:
+  struct Level {
+    GLsizei width;
+    GLsizei height;
+    // one pointer per face; cube maps have 6
+    std::vector<const unsigned char *> faces;
+    size_t size;
+  };
+
+  TextureContainer();
+
+  // Levels larger than maxTextureSize are dropped; it is an error if none are left.
+  bool Parse(const unsigned char *data, size_t size, GLint maxTextureSize, std::string &error);
+  // Uploads every level to the texture bound to target (GL_TEXTURE_2D or GL_TEXTURE_CUBE_MAP), then generates the
+  // rest of the chain if the file asks for it.
+  // Changes GL_UNPACK_ALIGNMENT for uncompressed data; the caller restores it.
+  void Upload(GLenum target) const;
+
+  GLenum internalFormat;
+  // zero for compressed formats
+  GLenum format;
+  GLenum type;
+  bool compressed;
+  GLint unpackAlignment;
+  unsigned int numFaces;
+  std::vector<Level> levels;
+  // the file has level 0 only and leaves the mip chain to the loader; ignored for compressed formats
+  bool generateMipmaps;
+
+protected:
+  bool ParseKtx(const unsigned char *data, size_t size, std::string &error);
+  bool ParseKtx2(const unsigned char *data, size_t size, std::string &error);
+  bool ParseDds(const unsigned char *data, size_t size, std::string &error);
+};
+
+#endif
@@ -60,11 +60,19 @@
 
 #include <defines.h>
 #include <glfw.h>
+#include <streaming-buffer.h>
+#include <texture-compression.h>
+#include <texture-container.h>
+#include <set>
 
 using namespace v8;
 using namespace node;
 
+class CanvasRenderingContext2D;
+
 void flipImageData(char *dstData, char *srcData, size_t width, size_t height, size_t pixelSize);
+void invalidateFramebuffer(GLenum target, GLsizei numAttachments, const GLenum *attachments);
+void invalidateSubFramebuffer(GLenum target, GLsizei numAttachments, const GLenum *attachments, GLint x, GLint y, GLsizei width, GLsizei height);
 
 class WebGLRenderingContext : public ObjectWrap {
 public:
@@ -80,6 +88,10 @@ public:
   static NAN_METHOD(SetDefaultVao);
   static NAN_METHOD(IsDirty);
   static NAN_METHOD(ClearDirty);
+  static NAN_METHOD(EndFrame);
+  static NAN_METHOD(GetStreamingStats);
+  static NAN_METHOD(SetTextureCompression);
+  static NAN_METHOD(SetTexturePacking);
 
   static NAN_METHOD(Uniform1f);
   static NAN_METHOD(Uniform2f);
@@ -144,6 +156,7 @@ public:
   static NAN_METHOD(FlipTextureData);
   static NAN_METHOD(TexImage2D);
   static NAN_METHOD(CompressedTexImage2D);
+  static NAN_METHOD(TexImage2DFromContainer);
   static NAN_METHOD(TexParameteri);
   static NAN_METHOD(TexParameterf);
   static NAN_METHOD(Clear);
@@ -154,6 +167,8 @@ public:
   static NAN_METHOD(BindFramebuffer);
   static NAN_METHOD(FramebufferTexture2D);
   static NAN_METHOD(BlitFramebuffer);
+  static NAN_METHOD(InvalidateFramebuffer);
+  static NAN_METHOD(InvalidateSubFramebuffer);
   static NAN_METHOD(BufferData);
   static NAN_METHOD(BufferSubData);
   static NAN_METHOD(BlendEquation);
@@ -284,6 +299,16 @@ public:
     return framebufferBindings.find(target) != framebufferBindings.end();
   }
 
+  void SetBufferBinding(GLenum target, GLuint buffer) {
+    bufferBindings[target] = buffer;
+  }
+  GLuint GetBufferBinding(GLenum target) {
+    return bufferBindings[target];
+  }
+  bool HasBufferBinding(GLenum target) {
+    return bufferBindings.find(target) != bufferBindings.end();
+  }
+
   void SetRenderbufferBinding(GLenum target, GLuint renderbuffer) {
     renderbufferBindings[target] = renderbuffer;
   }
@@ -304,6 +329,36 @@ public:
     return textureBindings.find(std::make_pair(framebuffer, target)) != textureBindings.end();
   }
 
+  // Forgets that level 0 of the bound texture holds a canvas upload, once something else wrote to it.
+  void ForgetCanvasTexture(GLenum target) {
+    if (target == GL_TEXTURE_2D) {
+      canvasTextures.erase(GetTextureBinding(activeTexture, target));
+    }
+  }
+
+  // Forgets the encoded image of the bound texture, once something else replaced it.
+  void ForgetCompressedTexture(GLenum target) {
+    if (target == GL_TEXTURE_2D) {
+      GLuint texture = GetTextureBinding(activeTexture, target);
+      pendingCompressedTextures.erase(texture);
+      compressedTextures.erase(texture);
+    }
+  }
+  // Puts a compressed texture back to RGBA8 and stops compressing it, before it is written in part or attached to a
+  // framebuffer; neither works on compressed formats.
+  void DecompressTexture(GLuint texture);
+  // Swaps the encoded levels into textures whose encode has finished.
+  void UploadCompressedTextures();
+
+  struct CanvasTexture {
+    const CanvasRenderingContext2D *canvas;
+    uint64_t version;
+    GLsizei width;
+    GLsizei height;
+    GLenum internalformat;
+    bool flipY;
+  };
+
   static Nan::Persistent<FunctionTemplate> s_ct;
 
   bool live;
@@ -317,6 +372,22 @@ public:
   GLint unpackAlignment;
   GLuint activeTexture;
   std::map<GLenum, GLuint> framebufferBindings;
+  std::map<GLenum, GLuint> bufferBindings;
+  std::map<GLuint, GLenum> bufferUsages;
+  StreamingBuffer streamingBuffer;
+  bool textureCompression;
+  TextureCompression::PackingMode texturePacking;
+  std::set<GLuint> mipmappedTextures;
+  // textures showing their image uncompressed until its encode finishes
+  std::map<GLuint, std::shared_ptr<TextureCompression::Upload>> pendingCompressedTextures;
+  // textures holding encoded levels, with the pixels to fall back to
+  std::map<GLuint, std::shared_ptr<TextureCompression::Upload>> compressedTextures;
+  // textures written in part or attached to a framebuffer, which are never compressed again
+  std::set<GLuint> uncompressedTextures;
+  // textures whose level 0 was last filled from a whole 2D canvas, so uploading that canvas again only sends what was drawn since
+  std::map<GLuint, CanvasTexture> canvasTextures;
+  // textures attached to a framebuffer may have been rendered to, so canvases are always uploaded to them in full
+  std::set<GLuint> framebufferTextures;
   std::map<GLenum, GLuint> renderbufferBindings;
   std::map<std::pair<GLenum, GLenum>, GLuint> textureBindings;
 };
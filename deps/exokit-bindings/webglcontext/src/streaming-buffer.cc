@@ -0,0 +1,89 @@
+#include <cstring>
+
+#include <webglcontext/include/webgl.h>
+
+StreamingBuffer::StreamingBuffer(GLsizeiptr capacity) : numStreamed(0), numRejected(0), buffer(0), capacity(capacity), head(0), inFlight(0), frameBytes(0) {}
+
+StreamingBuffer::~StreamingBuffer() {}
+
+bool StreamingBuffer::Upload(GLenum target, GLintptr dstOffset, const void *data, GLsizeiptr size) {
+  if (size <= 0 || size > capacity || target == GL_COPY_READ_BUFFER) {
+    numRejected++;
+    return false;
+  }
+
+  if (!buffer) {
+    glGenBuffers(1, &buffer);
+    glBindBuffer(GL_COPY_READ_BUFFER, buffer);
+    glBufferData(GL_COPY_READ_BUFFER, capacity, nullptr, GL_STREAM_DRAW);
+  } else {
+    glBindBuffer(GL_COPY_READ_BUFFER, buffer);
+  }
+
+  // skip the tail of the ring if the write does not fit before the end
+  bool wrap = head + size > capacity;
+  GLsizeiptr padding = wrap ? (capacity - head) : 0;
+  if (inFlight + padding + size > capacity) {
+    Retire();
+    if (inFlight + padding + size > capacity) {
+      numRejected++;
+      return false;
+    }
+  }
+  GLintptr srcOffset = wrap ? 0 : head;
+
+  void *dst = glMapBufferRange(GL_COPY_READ_BUFFER, srcOffset, size, GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT | GL_MAP_INVALIDATE_RANGE_BIT);
+  if (!dst) {
+    return false;
+  }
+  memcpy(dst, data, size);
+  if (!glUnmapBuffer(GL_COPY_READ_BUFFER)) {
+    return false;
+  }
+
+  glCopyBufferSubData(GL_COPY_READ_BUFFER, target, srcOffset, dstOffset, size);
+
+  head = srcOffset + size;
+  inFlight += padding + size;
+  frameBytes += padding + size;
+  numStreamed++;
+
+  return true;
+}
+
+void StreamingBuffer::EndFrame() {
+  if (frameBytes > 0) {
+    GLsync fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    frames.push_back(Frame{fence, frameBytes});
+    frameBytes = 0;
+  }
+  Retire();
+}
+
+void StreamingBuffer::Retire() {
+  while (!frames.empty()) {
+    Frame &frame = frames.front();
+    GLenum result = glClientWaitSync(frame.fence, 0, 0);
+    if (result == GL_ALREADY_SIGNALED || result == GL_CONDITION_SATISFIED) {
+      glDeleteSync(frame.fence);
+      inFlight -= frame.bytes;
+      frames.pop_front();
+    } else {
+      break;
+    }
+  }
+}
+
+void StreamingBuffer::Destroy() {
+  for (size_t i = 0; i < frames.size(); i++) {
+    glDeleteSync(frames[i].fence);
+  }
+  frames.clear();
+  if (buffer) {
+    glDeleteBuffers(1, &buffer);
+    buffer = 0;
+  }
+  head = 0;
+  inFlight = 0;
+  frameBytes = 0;
+}
@@ -0,0 +1,218 @@
+#include <algorithm>
+#include <cstring>
+
+#include <webglcontext/include/webgl.h>
+#include <ImageData.h>
+#include <WorkerPool.h>
+
+#ifndef GL_RGB565
+#define GL_RGB565 0x8D62
+#endif
+#ifndef GL_COMPRESSED_RGB8_ETC2
+#define GL_COMPRESSED_RGB8_ETC2 0x9274
+#endif
+
+bool TextureCompression::formatsDetected = false;
+bool TextureCompression::hasS3tc = false;
+GLenum TextureCompression::etc1Format = 0;
+
+std::mutex TextureCompression::cacheMutex;
+std::map<TextureCompression::Key, TextureCompression::Entry> TextureCompression::cache;
+std::list<TextureCompression::Key> TextureCompression::lru;
+size_t TextureCompression::cacheSize = 0;
+
+void TextureCompression::DetectFormats() {
+  GLint numExtensions = 0;
+  glGetIntegerv(GL_NUM_EXTENSIONS, &numExtensions);
+  for (GLint i = 0; i < numExtensions; i++) {
+    const char *extension = (const char *)glGetStringi(GL_EXTENSIONS, i);
+    if (!extension) {
+      continue;
+    }
+    if (strcmp(extension, "GL_EXT_texture_compression_s3tc") == 0) {
+      hasS3tc = true;
+    } else if (strcmp(extension, "GL_OES_compressed_ETC1_RGB8_texture") == 0) {
+      etc1Format = GL_ETC1_RGB8_OES;
+    } else if (strcmp(extension, "GL_ARB_ES3_compatibility") == 0 && etc1Format == 0) {
+      // ETC2 decoders accept ETC1 data
+      etc1Format = GL_COMPRESSED_RGB8_ETC2;
+    }
+  }
+#if __ANDROID__
+  if (etc1Format == 0) {
+    etc1Format = GL_COMPRESSED_RGB8_ETC2; // core in ES 3.0
+  }
+#endif
+  formatsDetected = true;
+}
+
+static uint64_t hashPixels(const unsigned char *pixels, size_t size) {
+  // FNV-1a over 64-bit words; cache hits are confirmed against the pixels themselves
+  uint64_t hash = 14695981039346656037ULL;
+  size_t numWords = size / sizeof(uint64_t);
+  for (size_t i = 0; i < numWords; i++) {
+    uint64_t word;
+    memcpy(&word, pixels + i * sizeof(uint64_t), sizeof(word));
+    hash = (hash ^ word) * 1099511628211ULL;
+  }
+  for (size_t i = numWords * sizeof(uint64_t); i < size; i++) {
+    hash = (hash ^ pixels[i]) * 1099511628211ULL;
+  }
+  return hash;
+}
+
+bool TextureCompression::HasAlpha(const unsigned char *pixels, GLsizei width, GLsizei height) {
+  size_t numPixels = (size_t)width * (size_t)height;
+  for (size_t i = 0; i < numPixels; i++) {
+    if (pixels[i * 4 + 3] != 255) {
+      return true;
+    }
+  }
+  return false;
+}
+
+unsigned short TextureCompression::GetNumLevels(GLsizei width, GLsizei height) {
+  unsigned short levels = 1;
+  for (GLsizei size = std::max(width, height); size > 1; size >>= 1) {
+    levels++;
+  }
+  return levels;
+}
+
+std::shared_ptr<TextureCompression::Upload> TextureCompression::Encode(const unsigned char *pixels, GLsizei width, GLsizei height, bool compress, PackingMode packing) {
+  if (width <= 0 || height <= 0 || width > 0xFFFF || height > 0xFFFF) {
+    return nullptr;
+  }
+  if (!formatsDetected) {
+    DetectFormats();
+  }
+
+  bool hasAlpha = HasAlpha(pixels, width, height);
+
+  std::shared_ptr<Upload> upload(new Upload());
+  if (compress && hasS3tc) {
+    upload->internalFormat = hasAlpha ? canvas::RGBA_DXT5 : canvas::RGB_DXT1;
+    upload->glInternalFormat = hasAlpha ? GL_COMPRESSED_RGBA_S3TC_DXT5_EXT : GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+    upload->glFormat = upload->glInternalFormat;
+    upload->glType = 0;
+  } else if (compress && etc1Format != 0 && !hasAlpha) {
+    upload->internalFormat = canvas::RGB_ETC1;
+    upload->glInternalFormat = etc1Format;
+    upload->glFormat = etc1Format;
+    upload->glType = 0;
+  } else if (packing == PACKING_ALWAYS || (packing == PACKING_AUTO && !hasAlpha && (size_t)width * (size_t)height >= 512 * 512)) {
+    // FloydSteinberg packs in the component order the platform's GL prefers
+    if (!hasAlpha) {
+      upload->internalFormat = canvas::RGB565;
+      upload->glInternalFormat = GL_RGB565;
+      upload->glFormat = GL_RGB;
+#if defined __APPLE__ || defined __ANDROID__
+      upload->glType = GL_UNSIGNED_SHORT_5_6_5;
+#else
+      upload->glType = GL_UNSIGNED_SHORT_5_6_5_REV;
+#endif
+    } else {
+      upload->internalFormat = canvas::RGBA4;
+      upload->glInternalFormat = GL_RGBA4;
+#if defined __APPLE__ || defined __ANDROID__
+      upload->glFormat = GL_RGBA;
+#else
+      upload->glFormat = GL_BGRA;
+#endif
+      upload->glType = GL_UNSIGNED_SHORT_4_4_4_4;
+    }
+  } else {
+    return nullptr;
+  }
+  upload->width = width;
+  upload->height = height;
+  upload->levels = GetNumLevels(width, height);
+
+  size_t size = (size_t)width * (size_t)height * 4;
+  Key key{hashPixels(pixels, size), width, height, upload->glInternalFormat, upload->glType};
+
+  {
+    std::lock_guard<std::mutex> lock(cacheMutex);
+
+    auto iter = cache.find(key);
+    if (iter != cache.end()) {
+      // the hash only narrows the search; a colliding image must not get another image's texture
+      if (memcmp(iter->second.upload->pixels->data(), pixels, size) == 0) {
+        lru.splice(lru.begin(), lru, iter->second.lruIter);
+        return iter->second.upload;
+      }
+      const Upload &oldUpload = *iter->second.upload;
+      cacheSize -= oldUpload.pixels->size() + (oldUpload.packedImageData ? oldUpload.packedImageData->calculateSize() : 0);
+      lru.erase(iter->second.lruIter);
+      cache.erase(iter);
+    }
+
+    upload->pixels.reset(new std::vector<unsigned char>(pixels, pixels + size));
+    lru.push_front(key);
+    cache[key] = Entry{upload, lru.begin()};
+    cacheSize += size;
+    Trim();
+  }
+
+  canvas::WorkerPool::getDefault().queue([key, upload]() {
+    canvas::ImageData imageData(upload->pixels->data(), upload->width, upload->height, 4);
+    std::shared_ptr<canvas::PackedImageData> packedImageData(new canvas::PackedImageData(upload->internalFormat, upload->levels, imageData));
+
+    std::lock_guard<std::mutex> lock(cacheMutex);
+
+    upload->packedImageData = packedImageData;
+    // counted only if it was not evicted while encoding
+    auto iter = cache.find(key);
+    if (iter != cache.end() && iter->second.upload == upload) {
+      cacheSize += packedImageData->calculateSize();
+      Trim();
+    }
+  });
+
+  return upload;
+}
+
+void TextureCompression::Trim() {
+  while (cacheSize > maxCacheSize && lru.size() > 1) {
+    auto oldIter = cache.find(lru.back());
+    const Upload &oldUpload = *oldIter->second.upload;
+    cacheSize -= oldUpload.pixels->size() + (oldUpload.packedImageData ? oldUpload.packedImageData->calculateSize() : 0);
+    cache.erase(oldIter);
+    lru.pop_back();
+  }
+}
+
+bool TextureCompression::IsReady(const Upload &upload) {
+  std::lock_guard<std::mutex> lock(cacheMutex);
+  return (bool)upload.packedImageData;
+}
+
+void TextureCompression::TexImage2D(GLenum target, const Upload &upload) {
+  std::shared_ptr<canvas::PackedImageData> packedImageData;
+  {
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    packedImageData = upload.packedImageData;
+  }
+
+  glPixelStorei(GL_UNPACK_ALIGNMENT, 2);
+
+  GLsizei levelWidth = upload.width;
+  GLsizei levelHeight = upload.height;
+  for (unsigned short level = 0; level < upload.levels; level++) {
+    size_t offset = packedImageData->calculateOffset(level);
+    if (upload.glType == 0) {
+      size_t size = packedImageData->calculateOffset(level + 1) - offset;
+      glCompressedTexImage2D(target, level, upload.glInternalFormat, levelWidth, levelHeight, 0, size, packedImageData->getData() + offset);
+    } else {
+      glTexImage2D(target, level, upload.glInternalFormat, levelWidth, levelHeight, 0, upload.glFormat, upload.glType, packedImageData->getData() + offset);
+    }
+
+    levelWidth = canvas::PackedImageData::getMipSize(levelWidth);
+    levelHeight = canvas::PackedImageData::getMipSize(levelHeight);
+  }
+}
+
+void TextureCompression::TexImage2DUncompressed(GLenum target, const Upload &upload) {
+  glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+  glTexImage2D(target, 0, GL_RGBA8, upload.width, upload.height, 0, GL_RGBA, GL_UNSIGNED_BYTE, upload.pixels->data());
+}
@@ -0,0 +1,558 @@
+#include <algorithm>
+#include <cstring>
+
+#include <webglcontext/include/webgl.h>
+#include <PackedImageData.h>
+
+#ifndef GL_BGRA
+#define GL_BGRA 0x80E1
+#endif
+#ifndef GL_COMPRESSED_RED_RGTC1
+#define GL_COMPRESSED_RED_RGTC1 0x8DBB
+#endif
+#ifndef GL_COMPRESSED_SIGNED_RED_RGTC1
+#define GL_COMPRESSED_SIGNED_RED_RGTC1 0x8DBC
+#endif
+#ifndef GL_COMPRESSED_RG_RGTC2
+#define GL_COMPRESSED_RG_RGTC2 0x8DBD
+#endif
+#ifndef GL_COMPRESSED_SIGNED_RG_RGTC2
+#define GL_COMPRESSED_SIGNED_RG_RGTC2 0x8DBE
+#endif
+#ifndef GL_COMPRESSED_RGBA_BPTC_UNORM
+#define GL_COMPRESSED_RGBA_BPTC_UNORM 0x8E8C
+#endif
+#ifndef GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM
+#define GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM 0x8E8D
+#endif
+#ifndef GL_COMPRESSED_R11_EAC
+#define GL_COMPRESSED_R11_EAC 0x9270
+#define GL_COMPRESSED_SIGNED_R11_EAC 0x9271
+#define GL_COMPRESSED_RG11_EAC 0x9272
+#define GL_COMPRESSED_SIGNED_RG11_EAC 0x9273
+#define GL_COMPRESSED_RGB8_ETC2 0x9274
+#define GL_COMPRESSED_SRGB8_ETC2 0x9275
+#define GL_COMPRESSED_RGB8_PUNCHTHROUGH_ALPHA1_ETC2 0x9276
+#define GL_COMPRESSED_SRGB8_PUNCHTHROUGH_ALPHA1_ETC2 0x9277
+#define GL_COMPRESSED_RGBA8_ETC2_EAC 0x9278
+#define GL_COMPRESSED_SRGB8_ALPHA8_ETC2_EAC 0x9279
+#endif
+#ifndef GL_COMPRESSED_RGBA_ASTC_4x4_KHR
+#define GL_COMPRESSED_RGBA_ASTC_4x4_KHR 0x93B0
+#endif
+#ifndef GL_COMPRESSED_SRGB8_ALPHA8_ASTC_4x4_KHR
+#define GL_COMPRESSED_SRGB8_ALPHA8_ASTC_4x4_KHR 0x93D0
+#endif
+
+// TextureContainer
+
+template<typename T>
+inline T readValue(const unsigned char *data) {
+  T value;
+  memcpy(&value, data, sizeof(T));
+  return value;
+}
+
+// bytes per 4x4 block, or 0 if the format is not a supported block format
+static size_t getCompressedBlockSize(GLenum internalFormat) {
+  switch (internalFormat) {
+    case GL_COMPRESSED_RGB_S3TC_DXT1_EXT:
+    case GL_COMPRESSED_RGBA_S3TC_DXT1_EXT:
+    case GL_COMPRESSED_SRGB_S3TC_DXT1_EXT:
+    case GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT:
+    case GL_COMPRESSED_RED_RGTC1:
+    case GL_COMPRESSED_SIGNED_RED_RGTC1:
+    case GL_ETC1_RGB8_OES:
+    case GL_COMPRESSED_RGB8_ETC2:
+    case GL_COMPRESSED_SRGB8_ETC2:
+    case GL_COMPRESSED_RGB8_PUNCHTHROUGH_ALPHA1_ETC2:
+    case GL_COMPRESSED_SRGB8_PUNCHTHROUGH_ALPHA1_ETC2:
+    case GL_COMPRESSED_R11_EAC:
+    case GL_COMPRESSED_SIGNED_R11_EAC:
+      return 8;
+    case GL_COMPRESSED_RGBA_S3TC_DXT3_EXT:
+    case GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT3_EXT:
+    case GL_COMPRESSED_RGBA_S3TC_DXT5_EXT:
+    case GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT:
+    case GL_COMPRESSED_RG_RGTC2:
+    case GL_COMPRESSED_SIGNED_RG_RGTC2:
+    case GL_COMPRESSED_RGBA_BPTC_UNORM:
+    case GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM:
+    case GL_COMPRESSED_RGBA8_ETC2_EAC:
+    case GL_COMPRESSED_SRGB8_ALPHA8_ETC2_EAC:
+    case GL_COMPRESSED_RG11_EAC:
+    case GL_COMPRESSED_SIGNED_RG11_EAC:
+    case GL_COMPRESSED_RGBA_ASTC_4x4_KHR:
+    case GL_COMPRESSED_SRGB8_ALPHA8_ASTC_4x4_KHR:
+      return 16;
+    default:
+      return 0;
+  }
+}
+
+// bytes per pixel of an uncompressed format, or 0 if it is not supported
+static size_t getPixelSize(GLenum format, GLenum type) {
+  size_t numChannels;
+  switch (format) {
+    case GL_RED:
+    case GL_ALPHA:
+    case GL_LUMINANCE:
+      numChannels = 1;
+      break;
+    case GL_RG:
+    case GL_LUMINANCE_ALPHA:
+      numChannels = 2;
+      break;
+    case GL_RGB:
+      numChannels = 3;
+      break;
+    case GL_RGBA:
+    case GL_BGRA:
+      numChannels = 4;
+      break;
+    default:
+      return 0;
+  }
+  switch (type) {
+    case GL_UNSIGNED_BYTE:
+    case GL_BYTE:
+      return numChannels;
+    case GL_UNSIGNED_SHORT:
+    case GL_SHORT:
+    case GL_HALF_FLOAT:
+      return numChannels * 2;
+    case GL_UNSIGNED_INT:
+    case GL_INT:
+    case GL_FLOAT:
+      return numChannels * 4;
+    case GL_UNSIGNED_SHORT_5_6_5:
+    case GL_UNSIGNED_SHORT_4_4_4_4:
+    case GL_UNSIGNED_SHORT_5_5_5_1:
+      return 2;
+    default:
+      return 0;
+  }
+}
+
+// sizes are computed in 64 bits; dimensions are limited to maxDimension so they cannot overflow
+static const uint32_t maxDimension = 1 << 15;
+
+static uint64_t calculateLevelSize(uint32_t width, uint32_t height, size_t blockSize) {
+  return (uint64_t)((width + 3) / 4) * (uint64_t)((height + 3) / 4) * blockSize;
+}
+
+static uint32_t getMaxLevels(uint32_t width, uint32_t height) {
+  uint32_t maxLevels = 1;
+  for (uint32_t size = std::max(width, height); size > 1; size >>= 1) {
+    maxLevels++;
+  }
+  return maxLevels;
+}
+
+static bool checkDimensions(uint32_t width, uint32_t height, uint32_t numLevels, std::string &error) {
+  if (width == 0 || width > maxDimension || height > maxDimension) {
+    error = "invalid texture dimensions";
+    return false;
+  }
+  if (numLevels > getMaxLevels(width, std::max<uint32_t>(height, 1))) {
+    error = "too many mip levels";
+    return false;
+  }
+  return true;
+}
+
+TextureContainer::TextureContainer() : internalFormat(0), format(0), type(0), compressed(false), unpackAlignment(4), numFaces(1), generateMipmaps(false) {}
+
+bool TextureContainer::Parse(const unsigned char *data, size_t size, GLint maxTextureSize, std::string &error) {
+  static const unsigned char ktxIdentifier[12] = {0xAB, 'K', 'T', 'X', ' ', '1', '1', 0xBB, '\r', '\n', 0x1A, '\n'};
+  static const unsigned char ktx2Identifier[12] = {0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n'};
+
+  levels.clear();
+  generateMipmaps = false;
+
+  bool ok;
+  if (size >= 12 && memcmp(data, ktxIdentifier, 12) == 0) {
+    ok = ParseKtx(data, size, error);
+  } else if (size >= 12 && memcmp(data, ktx2Identifier, 12) == 0) {
+    ok = ParseKtx2(data, size, error);
+  } else if (size >= 4 && memcmp(data, "DDS ", 4) == 0) {
+    ok = ParseDds(data, size, error);
+  } else {
+    error = "unknown container format";
+    ok = false;
+  }
+  if (!ok) {
+    levels.clear();
+    return false;
+  }
+
+  // start the chain at the first level the driver can take
+  size_t firstLevel = 0;
+  while (firstLevel < levels.size() && (levels[firstLevel].width > maxTextureSize || levels[firstLevel].height > maxTextureSize)) {
+    firstLevel++;
+  }
+  levels.erase(levels.begin(), levels.begin() + firstLevel);
+  if (levels.empty()) {
+    error = "texture is larger than MAX_TEXTURE_SIZE";
+    return false;
+  }
+
+  return true;
+}
+
+bool TextureContainer::ParseKtx(const unsigned char *data, size_t size, std::string &error) {
+  const size_t headerSize = 12 + 13 * 4;
+  if (size < headerSize) {
+    error = "truncated KTX header";
+    return false;
+  }
+  const unsigned char *header = data + 12;
+  if (readValue<uint32_t>(header) != 0x04030201) {
+    error = "big-endian KTX files are not supported";
+    return false;
+  }
+  type = readValue<uint32_t>(header + 4);
+  format = readValue<uint32_t>(header + 12);
+  internalFormat = readValue<uint32_t>(header + 16);
+  uint32_t width = readValue<uint32_t>(header + 24);
+  uint32_t height = std::max<uint32_t>(readValue<uint32_t>(header + 28), 1);
+  uint32_t depth = readValue<uint32_t>(header + 32);
+  uint32_t arrayElements = readValue<uint32_t>(header + 36);
+  numFaces = readValue<uint32_t>(header + 40);
+  uint32_t numLevels = readValue<uint32_t>(header + 44);
+  uint32_t keyValueBytes = readValue<uint32_t>(header + 48);
+
+  if (depth > 1 || arrayElements > 0 || (numFaces != 1 && numFaces != 6)) {
+    error = "only 2D and cube map KTX textures are supported";
+    return false;
+  }
+  if (!checkDimensions(width, height, numLevels, error)) {
+    return false;
+  }
+  // zero levels asks the loader to generate the chain
+  if (numLevels == 0) {
+    generateMipmaps = true;
+    numLevels = 1;
+  }
+  compressed = type == 0;
+  size_t blockSize = compressed ? getCompressedBlockSize(internalFormat) : 0;
+  size_t pixelSize = compressed ? 0 : getPixelSize(format, type);
+  if (compressed ? blockSize == 0 : pixelSize == 0) {
+    error = compressed ? "unsupported KTX compressed format" : "unsupported KTX format";
+    return false;
+  }
+  unpackAlignment = 4;
+
+  if (keyValueBytes > size - headerSize) {
+    error = "truncated KTX key/value data";
+    return false;
+  }
+  uint64_t offset = headerSize + keyValueBytes;
+  for (uint32_t i = 0; i < numLevels; i++) {
+    if (size - offset < 4) {
+      error = "truncated KTX level";
+      return false;
+    }
+    uint64_t imageSize = readValue<uint32_t>(data + offset);
+    offset += 4;
+
+    uint64_t expectedSize = compressed ? calculateLevelSize(width, height, blockSize) : (((uint64_t)width * pixelSize + 3) & ~(uint64_t)3) * height;
+    if (imageSize != expectedSize) {
+      error = "KTX level size does not match its dimensions";
+      return false;
+    }
+
+    Level level;
+    level.width = width;
+    level.height = height;
+    level.size = imageSize;
+    for (uint32_t face = 0; face < numFaces; face++) {
+      if (imageSize > size - offset) {
+        error = "truncated KTX level";
+        return false;
+      }
+      level.faces.push_back(data + offset);
+      offset = std::min<uint64_t>(offset + ((imageSize + 3) & ~(uint64_t)3), size); // cubePadding
+    }
+    offset = std::min<uint64_t>((offset + 3) & ~(uint64_t)3, size); // mipPadding
+    levels.push_back(level);
+
+    width = canvas::PackedImageData::getMipSize(width);
+    height = canvas::PackedImageData::getMipSize(height);
+  }
+
+  return true;
+}
+
+static GLenum vkFormatToGl(uint32_t vkFormat) {
+  switch (vkFormat) {
+    case 131: return GL_COMPRESSED_RGB_S3TC_DXT1_EXT; // VK_FORMAT_BC1_RGB_UNORM_BLOCK
+    case 132: return GL_COMPRESSED_SRGB_S3TC_DXT1_EXT;
+    case 133: return GL_COMPRESSED_RGBA_S3TC_DXT1_EXT;
+    case 134: return GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT;
+    case 135: return GL_COMPRESSED_RGBA_S3TC_DXT3_EXT;
+    case 136: return GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT3_EXT;
+    case 137: return GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+    case 138: return GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT;
+    case 139: return GL_COMPRESSED_RED_RGTC1;
+    case 140: return GL_COMPRESSED_SIGNED_RED_RGTC1;
+    case 141: return GL_COMPRESSED_RG_RGTC2;
+    case 142: return GL_COMPRESSED_SIGNED_RG_RGTC2;
+    case 145: return GL_COMPRESSED_RGBA_BPTC_UNORM;
+    case 146: return GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM;
+    case 147: return GL_COMPRESSED_RGB8_ETC2;
+    case 148: return GL_COMPRESSED_SRGB8_ETC2;
+    case 149: return GL_COMPRESSED_RGB8_PUNCHTHROUGH_ALPHA1_ETC2;
+    case 150: return GL_COMPRESSED_SRGB8_PUNCHTHROUGH_ALPHA1_ETC2;
+    case 151: return GL_COMPRESSED_RGBA8_ETC2_EAC;
+    case 152: return GL_COMPRESSED_SRGB8_ALPHA8_ETC2_EAC;
+    case 153: return GL_COMPRESSED_R11_EAC;
+    case 154: return GL_COMPRESSED_SIGNED_R11_EAC;
+    case 155: return GL_COMPRESSED_RG11_EAC;
+    case 156: return GL_COMPRESSED_SIGNED_RG11_EAC;
+    case 157: return GL_COMPRESSED_RGBA_ASTC_4x4_KHR;
+    case 158: return GL_COMPRESSED_SRGB8_ALPHA8_ASTC_4x4_KHR;
+    default: return 0;
+  }
+}
+
+bool TextureContainer::ParseKtx2(const unsigned char *data, size_t size, std::string &error) {
+  const size_t headerSize = 12 + 9 * 4 + 4 * 4 + 2 * 8;
+  if (size < headerSize) {
+    error = "truncated KTX2 header";
+    return false;
+  }
+  const unsigned char *header = data + 12;
+  uint32_t vkFormat = readValue<uint32_t>(header);
+  uint32_t width = readValue<uint32_t>(header + 8);
+  uint32_t height = std::max<uint32_t>(readValue<uint32_t>(header + 12), 1);
+  uint32_t depth = readValue<uint32_t>(header + 16);
+  uint32_t layers = readValue<uint32_t>(header + 20);
+  numFaces = readValue<uint32_t>(header + 24);
+  uint32_t numLevels = readValue<uint32_t>(header + 28);
+  uint32_t supercompressionScheme = readValue<uint32_t>(header + 32);
+
+  if (depth > 1 || layers > 0 || (numFaces != 1 && numFaces != 6)) {
+    error = "only 2D and cube map KTX2 textures are supported";
+    return false;
+  }
+  if (!checkDimensions(width, height, numLevels, error)) {
+    return false;
+  }
+  // levelCount 0 asks the loader to generate the chain; the index still has the one base level
+  if (numLevels == 0) {
+    generateMipmaps = true;
+    numLevels = 1;
+  }
+  if (supercompressionScheme != 0) {
+    error = "supercompressed KTX2 textures are not supported";
+    return false;
+  }
+  if (vkFormat == 37) { // VK_FORMAT_R8G8B8A8_UNORM
+    compressed = false;
+    internalFormat = GL_RGBA8;
+    format = GL_RGBA;
+    type = GL_UNSIGNED_BYTE;
+  } else if (vkFormat == 43) { // VK_FORMAT_R8G8B8A8_SRGB
+    compressed = false;
+    internalFormat = GL_SRGB8_ALPHA8;
+    format = GL_RGBA;
+    type = GL_UNSIGNED_BYTE;
+  } else {
+    compressed = true;
+    internalFormat = vkFormatToGl(vkFormat);
+    format = 0;
+    type = 0;
+    if (internalFormat == 0) {
+      error = "unsupported KTX2 format";
+      return false;
+    }
+  }
+  unpackAlignment = 1;
+
+  size_t blockSize = getCompressedBlockSize(internalFormat);
+
+  const size_t levelIndexOffset = headerSize;
+  if ((uint64_t)numLevels * 3 * 8 > size - levelIndexOffset) {
+    error = "truncated KTX2 level index";
+    return false;
+  }
+  for (uint32_t i = 0; i < numLevels; i++) {
+    const unsigned char *levelIndex = data + levelIndexOffset + i * 3 * 8;
+    uint64_t byteOffset = readValue<uint64_t>(levelIndex);
+    uint64_t byteLength = readValue<uint64_t>(levelIndex + 8);
+    // checked without adding, which could wrap
+    if (byteOffset > size || byteLength > size - byteOffset) {
+      error = "truncated KTX2 level";
+      return false;
+    }
+    uint64_t expectedSize = compressed ? calculateLevelSize(width, height, blockSize) : (uint64_t)width * height * 4;
+    if (byteLength != expectedSize * numFaces) {
+      error = "KTX2 level size does not match its dimensions";
+      return false;
+    }
+
+    Level level;
+    level.width = width;
+    level.height = height;
+    level.size = expectedSize;
+    for (uint32_t face = 0; face < numFaces; face++) {
+      level.faces.push_back(data + byteOffset + face * level.size);
+    }
+    levels.push_back(level);
+
+    width = canvas::PackedImageData::getMipSize(width);
+    height = canvas::PackedImageData::getMipSize(height);
+  }
+
+  return true;
+}
+
+static GLenum dxgiFormatToGl(uint32_t dxgiFormat) {
+  switch (dxgiFormat) {
+    case 71: return GL_COMPRESSED_RGBA_S3TC_DXT1_EXT; // DXGI_FORMAT_BC1_UNORM
+    case 72: return GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT;
+    case 74: return GL_COMPRESSED_RGBA_S3TC_DXT3_EXT;
+    case 75: return GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT3_EXT;
+    case 77: return GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+    case 78: return GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT;
+    case 80: return GL_COMPRESSED_RED_RGTC1;
+    case 81: return GL_COMPRESSED_SIGNED_RED_RGTC1;
+    case 83: return GL_COMPRESSED_RG_RGTC2;
+    case 84: return GL_COMPRESSED_SIGNED_RG_RGTC2;
+    case 98: return GL_COMPRESSED_RGBA_BPTC_UNORM;
+    case 99: return GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM;
+    default: return 0;
+  }
+}
+
+#define DDS_FOURCC(a, b, c, d) ((uint32_t)(a) | ((uint32_t)(b) << 8) | ((uint32_t)(c) << 16) | ((uint32_t)(d) << 24))
+
+bool TextureContainer::ParseDds(const unsigned char *data, size_t size, std::string &error) {
+  const size_t headerSize = 4 + 124;
+  if (size < headerSize) {
+    error = "truncated DDS header";
+    return false;
+  }
+  const unsigned char *header = data + 4;
+  uint32_t height = std::max<uint32_t>(readValue<uint32_t>(header + 8), 1);
+  uint32_t width = readValue<uint32_t>(header + 12);
+  uint32_t numLevels = std::max<uint32_t>(readValue<uint32_t>(header + 24), 1);
+  if (!checkDimensions(width, height, numLevels, error)) {
+    return false;
+  }
+  const unsigned char *pixelFormat = header + 72;
+  uint32_t pixelFormatFlags = readValue<uint32_t>(pixelFormat + 4);
+  uint32_t fourCC = readValue<uint32_t>(pixelFormat + 8);
+  uint32_t caps2 = readValue<uint32_t>(header + 108);
+
+  size_t offset = headerSize;
+  compressed = true;
+  format = 0;
+  type = 0;
+  if (pixelFormatFlags & 0x4) { // DDPF_FOURCC
+    switch (fourCC) {
+      case DDS_FOURCC('D', 'X', 'T', '1'): internalFormat = GL_COMPRESSED_RGBA_S3TC_DXT1_EXT; break;
+      case DDS_FOURCC('D', 'X', 'T', '3'): internalFormat = GL_COMPRESSED_RGBA_S3TC_DXT3_EXT; break;
+      case DDS_FOURCC('D', 'X', 'T', '5'): internalFormat = GL_COMPRESSED_RGBA_S3TC_DXT5_EXT; break;
+      case DDS_FOURCC('A', 'T', 'I', '1'):
+      case DDS_FOURCC('B', 'C', '4', 'U'): internalFormat = GL_COMPRESSED_RED_RGTC1; break;
+      case DDS_FOURCC('A', 'T', 'I', '2'):
+      case DDS_FOURCC('B', 'C', '5', 'U'): internalFormat = GL_COMPRESSED_RG_RGTC2; break;
+      case DDS_FOURCC('D', 'X', '1', '0'): {
+        if (size < headerSize + 20) {
+          error = "truncated DDS header";
+          return false;
+        }
+        uint32_t dxgiFormat = readValue<uint32_t>(data + headerSize);
+        uint32_t arraySize = readValue<uint32_t>(data + headerSize + 12);
+        if (arraySize > 1) {
+          error = "DDS texture arrays are not supported";
+          return false;
+        }
+        offset += 20;
+        if (dxgiFormat == 28) { // DXGI_FORMAT_R8G8B8A8_UNORM
+          compressed = false;
+          internalFormat = GL_RGBA8;
+          format = GL_RGBA;
+          type = GL_UNSIGNED_BYTE;
+        } else {
+          internalFormat = dxgiFormatToGl(dxgiFormat);
+        }
+        break;
+      }
+      default: internalFormat = 0; break;
+    }
+  } else if ((pixelFormatFlags & 0x40) && readValue<uint32_t>(pixelFormat + 12) == 32 && readValue<uint32_t>(pixelFormat + 16) == 0x000000ff) { // DDPF_RGB, R in the low byte
+    compressed = false;
+    internalFormat = GL_RGBA8;
+    format = GL_RGBA;
+    type = GL_UNSIGNED_BYTE;
+  } else {
+    internalFormat = 0;
+  }
+  if (internalFormat == 0) {
+    error = "unsupported DDS format";
+    return false;
+  }
+  unpackAlignment = 1;
+
+  if (caps2 & 0x200) { // DDSCAPS2_CUBEMAP
+    if ((caps2 & 0xFC00) != 0xFC00) {
+      error = "partial DDS cube maps are not supported";
+      return false;
+    }
+    numFaces = 6;
+  } else {
+    numFaces = 1;
+  }
+
+  size_t blockSize = getCompressedBlockSize(internalFormat);
+  levels.resize(numLevels);
+  // DDS stores each face's whole mip chain before the next face
+  for (uint32_t face = 0; face < numFaces; face++) {
+    uint32_t levelWidth = width;
+    uint32_t levelHeight = height;
+    for (uint32_t i = 0; i < numLevels; i++) {
+      uint64_t levelSize = compressed ? calculateLevelSize(levelWidth, levelHeight, blockSize) : (uint64_t)levelWidth * levelHeight * 4;
+      if (levelSize > size - offset) {
+        error = "truncated DDS level";
+        return false;
+      }
+
+      Level &level = levels[i];
+      level.width = levelWidth;
+      level.height = levelHeight;
+      level.size = levelSize;
+      level.faces.push_back(data + offset);
+      offset += levelSize;
+
+      levelWidth = canvas::PackedImageData::getMipSize(levelWidth);
+      levelHeight = canvas::PackedImageData::getMipSize(levelHeight);
+    }
+  }
+
+  return true;
+}
+
+void TextureContainer::Upload(GLenum target) const {
+  if (!compressed) {
+    glPixelStorei(GL_UNPACK_ALIGNMENT, unpackAlignment);
+  }
+
+  for (size_t i = 0; i < levels.size(); i++) {
+    const Level &level = levels[i];
+    for (size_t face = 0; face < level.faces.size(); face++) {
+      GLenum faceTarget = target == GL_TEXTURE_CUBE_MAP ? (GLenum)(GL_TEXTURE_CUBE_MAP_POSITIVE_X + face) : target;
+      if (compressed) {
+        glCompressedTexImage2D(faceTarget, i, internalFormat, level.width, level.height, 0, level.size, level.faces[face]);
+      } else {
+        glTexImage2D(faceTarget, i, internalFormat, level.width, level.height, 0, format, type, level.faces[face]);
+      }
+    }
+  }
+
+  if (generateMipmaps && !compressed) {
+    glGenerateMipmap(target);
+  }
+}
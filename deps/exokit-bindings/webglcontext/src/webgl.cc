@@ -3,6 +3,7 @@
 
 #include <webglcontext/include/webgl.h>
 #include <canvascontext/include/imageData-context.h>
+#include <canvascontext/include/canvas-context.h>
 // #include <node.h>
 
 /* #include <android/sensor.h>
@@ -522,6 +523,9 @@ void setGlConstants(T &proto) {
   JS_GL_CONSTANT(DEPTH_ATTACHMENT);
   JS_GL_CONSTANT(STENCIL_ATTACHMENT);
   JS_GL_CONSTANT(DEPTH_STENCIL_ATTACHMENT);
+  JS_GL_CONSTANT(COLOR);
+  JS_GL_CONSTANT(DEPTH);
+  JS_GL_CONSTANT(STENCIL);
   JS_GL_CONSTANT(DRAW_BUFFER0);
   JS_GL_CONSTANT(DRAW_BUFFER1);
   JS_GL_CONSTANT(DRAW_BUFFER2);
@@ -618,6 +622,10 @@ Handle<Object> WebGLRenderingContext::Initialize(Isolate *isolate) {
   Nan::SetMethod(proto, "setDefaultVao", SetDefaultVao);
   Nan::SetMethod(proto, "isDirty", IsDirty);
   Nan::SetMethod(proto, "clearDirty", ClearDirty);
+  Nan::SetMethod(proto, "endFrame", EndFrame);
+  Nan::SetMethod(proto, "getStreamingStats", GetStreamingStats);
+  Nan::SetMethod(proto, "setTextureCompression", SetTextureCompression);
+  Nan::SetMethod(proto, "setTexturePacking", SetTexturePacking);
 
   Nan::SetMethod(proto, "uniform1f", glCallWrap<Uniform1f>);
   Nan::SetMethod(proto, "uniform2f", glCallWrap<Uniform2f>);
@@ -685,6 +693,7 @@ Handle<Object> WebGLRenderingContext::Initialize(Isolate *isolate) {
   // Nan::SetMethod(proto, "flipTextureData", glCallWrap<FlipTextureData>);
   Nan::SetMethod(proto, "texImage2D", glCallWrap<TexImage2D>);
   Nan::SetMethod(proto, "compressedTexImage2D", glCallWrap<CompressedTexImage2D>);
+  Nan::SetMethod(proto, "texImage2DFromContainer", glCallWrap<TexImage2DFromContainer>);
   Nan::SetMethod(proto, "texParameteri", glCallWrap<TexParameteri>);
   Nan::SetMethod(proto, "texParameterf", glCallWrap<TexParameterf>);
   Nan::SetMethod(proto, "clear", glCallWrap<Clear>);
@@ -693,6 +702,8 @@ Handle<Object> WebGLRenderingContext::Initialize(Isolate *isolate) {
   Nan::SetMethod(proto, "bindFramebuffer", glCallWrap<BindFramebuffer>);
   Nan::SetMethod(proto, "framebufferTexture2D", glCallWrap<FramebufferTexture2D>);
   Nan::SetMethod(proto, "blitFramebuffer", glCallWrap<BlitFramebuffer>);
+  Nan::SetMethod(proto, "invalidateFramebuffer", glCallWrap<InvalidateFramebuffer>);
+  Nan::SetMethod(proto, "invalidateSubFramebuffer", glCallWrap<InvalidateSubFramebuffer>);
   Nan::SetMethod(proto, "createBuffer", glCallWrap<CreateBuffer>);
   Nan::SetMethod(proto, "bindBuffer", glCallWrap<BindBuffer>);
   Nan::SetMethod(proto, "bufferData", glCallWrap<BufferData>);
@@ -727,42 +738,42 @@ Handle<Object> WebGLRenderingContext::Initialize(Isolate *isolate) {
   Nan::SetMethod(proto, "vertexAttribDivisor", glCallWrap<VertexAttribDivisor>);
   Nan::SetMethod(proto, "drawBuffers", glCallWrap<DrawBuffers>);
 
-  Nan::SetMethod(proto, "blendColor", BlendColor);
-  Nan::SetMethod(proto, "blendEquationSeparate", BlendEquationSeparate);
-  Nan::SetMethod(proto, "blendFuncSeparate", BlendFuncSeparate);
-  Nan::SetMethod(proto, "clearStencil", ClearStencil);
-  Nan::SetMethod(proto, "colorMask", ColorMask);
-  Nan::SetMethod(proto, "copyTexImage2D", CopyTexImage2D);
-  Nan::SetMethod(proto, "copyTexSubImage2D", CopyTexSubImage2D);
-  Nan::SetMethod(proto, "cullFace", CullFace);
-  Nan::SetMethod(proto, "depthMask", DepthMask);
-  Nan::SetMethod(proto, "depthRange", DepthRange);
-  Nan::SetMethod(proto, "disableVertexAttribArray", DisableVertexAttribArray);
-  Nan::SetMethod(proto, "hint", Hint);
-  Nan::SetMethod(proto, "isEnabled", IsEnabled);
-  Nan::SetMethod(proto, "lineWidth", LineWidth);
-  Nan::SetMethod(proto, "polygonOffset", PolygonOffset);
-
-  Nan::SetMethod(proto, "scissor", Scissor);
-  Nan::SetMethod(proto, "stencilFunc", StencilFunc);
-  Nan::SetMethod(proto, "stencilFuncSeparate", StencilFuncSeparate);
-  Nan::SetMethod(proto, "stencilMask", StencilMask);
-  Nan::SetMethod(proto, "stencilMaskSeparate", StencilMaskSeparate);
-  Nan::SetMethod(proto, "stencilOp", StencilOp);
-  Nan::SetMethod(proto, "stencilOpSeparate", StencilOpSeparate);
-  Nan::SetMethod(proto, "bindRenderbuffer", BindRenderbuffer);
-  Nan::SetMethod(proto, "createRenderbuffer", CreateRenderbuffer);
-
-  Nan::SetMethod(proto, "deleteBuffer", DeleteBuffer);
-  Nan::SetMethod(proto, "deleteFramebuffer", DeleteFramebuffer);
-  Nan::SetMethod(proto, "deleteProgram", DeleteProgram);
-  Nan::SetMethod(proto, "deleteRenderbuffer", DeleteRenderbuffer);
-  Nan::SetMethod(proto, "deleteShader", DeleteShader);
-  Nan::SetMethod(proto, "deleteTexture", DeleteTexture);
-  Nan::SetMethod(proto, "detachShader", DetachShader);
-  Nan::SetMethod(proto, "framebufferRenderbuffer", FramebufferRenderbuffer);
-  Nan::SetMethod(proto, "getVertexAttribOffset", GetVertexAttribOffset);
-  Nan::SetMethod(proto, "getShaderPrecisionFormat", GetShaderPrecisionFormat);
+  Nan::SetMethod(proto, "blendColor", glCallWrap<BlendColor>);
+  Nan::SetMethod(proto, "blendEquationSeparate", glCallWrap<BlendEquationSeparate>);
+  Nan::SetMethod(proto, "blendFuncSeparate", glCallWrap<BlendFuncSeparate>);
+  Nan::SetMethod(proto, "clearStencil", glCallWrap<ClearStencil>);
+  Nan::SetMethod(proto, "colorMask", glCallWrap<ColorMask>);
+  Nan::SetMethod(proto, "copyTexImage2D", glCallWrap<CopyTexImage2D>);
+  Nan::SetMethod(proto, "copyTexSubImage2D", glCallWrap<CopyTexSubImage2D>);
+  Nan::SetMethod(proto, "cullFace", glCallWrap<CullFace>);
+  Nan::SetMethod(proto, "depthMask", glCallWrap<DepthMask>);
+  Nan::SetMethod(proto, "depthRange", glCallWrap<DepthRange>);
+  Nan::SetMethod(proto, "disableVertexAttribArray", glCallWrap<DisableVertexAttribArray>);
+  Nan::SetMethod(proto, "hint", glCallWrap<Hint>);
+  Nan::SetMethod(proto, "isEnabled", glCallWrap<IsEnabled>);
+  Nan::SetMethod(proto, "lineWidth", glCallWrap<LineWidth>);
+  Nan::SetMethod(proto, "polygonOffset", glCallWrap<PolygonOffset>);
+
+  Nan::SetMethod(proto, "scissor", glCallWrap<Scissor>);
+  Nan::SetMethod(proto, "stencilFunc", glCallWrap<StencilFunc>);
+  Nan::SetMethod(proto, "stencilFuncSeparate", glCallWrap<StencilFuncSeparate>);
+  Nan::SetMethod(proto, "stencilMask", glCallWrap<StencilMask>);
+  Nan::SetMethod(proto, "stencilMaskSeparate", glCallWrap<StencilMaskSeparate>);
+  Nan::SetMethod(proto, "stencilOp", glCallWrap<StencilOp>);
+  Nan::SetMethod(proto, "stencilOpSeparate", glCallWrap<StencilOpSeparate>);
+  Nan::SetMethod(proto, "bindRenderbuffer", glCallWrap<BindRenderbuffer>);
+  Nan::SetMethod(proto, "createRenderbuffer", glCallWrap<CreateRenderbuffer>);
+
+  Nan::SetMethod(proto, "deleteBuffer", glCallWrap<DeleteBuffer>);
+  Nan::SetMethod(proto, "deleteFramebuffer", glCallWrap<DeleteFramebuffer>);
+  Nan::SetMethod(proto, "deleteProgram", glCallWrap<DeleteProgram>);
+  Nan::SetMethod(proto, "deleteRenderbuffer", glCallWrap<DeleteRenderbuffer>);
+  Nan::SetMethod(proto, "deleteShader", glCallWrap<DeleteShader>);
+  Nan::SetMethod(proto, "deleteTexture", glCallWrap<DeleteTexture>);
+  Nan::SetMethod(proto, "detachShader", glCallWrap<DetachShader>);
+  Nan::SetMethod(proto, "framebufferRenderbuffer", glCallWrap<FramebufferRenderbuffer>);
+  Nan::SetMethod(proto, "getVertexAttribOffset", glCallWrap<GetVertexAttribOffset>);
+  Nan::SetMethod(proto, "getShaderPrecisionFormat", glCallWrap<GetShaderPrecisionFormat>);
 
   Nan::SetMethod(proto, "isBuffer", glCallWrap<IsBuffer>);
   Nan::SetMethod(proto, "isFramebuffer", glCallWrap<IsFramebuffer>);
@@ -834,11 +845,73 @@ WebGLRenderingContext::WebGLRenderingContext() :
   premultiplyAlpha(true),
   packAlignment(4),
   unpackAlignment(4),
-  activeTexture(GL_TEXTURE0)
+  activeTexture(GL_TEXTURE0),
+  textureCompression(false),
+  texturePacking(TextureCompression::PACKING_NONE)
   {}
 
 WebGLRenderingContext::~WebGLRenderingContext() {}
 
+void WebGLRenderingContext::DecompressTexture(GLuint texture) {
+  pendingCompressedTextures.erase(texture);
+  uncompressedTextures.insert(texture);
+
+  auto iter = compressedTextures.find(texture);
+  if (iter == compressedTextures.end()) {
+    return;
+  }
+
+  GLuint unpackBuffer = HasBufferBinding(GL_PIXEL_UNPACK_BUFFER) ? GetBufferBinding(GL_PIXEL_UNPACK_BUFFER) : 0;
+  if (unpackBuffer != 0) {
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+  }
+  glBindTexture(GL_TEXTURE_2D, texture);
+
+  // the encoded mip chain stood in for generateMipmap, so rebuild it from the new level 0
+  TextureCompression::TexImage2DUncompressed(GL_TEXTURE_2D, *iter->second);
+  glGenerateMipmap(GL_TEXTURE_2D);
+
+  glBindTexture(GL_TEXTURE_2D, GetTextureBinding(activeTexture, GL_TEXTURE_2D));
+  if (unpackBuffer != 0) {
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, unpackBuffer);
+  }
+  glPixelStorei(GL_UNPACK_ALIGNMENT, unpackAlignment);
+
+  mipmappedTextures.erase(texture);
+  compressedTextures.erase(iter);
+}
+
+void WebGLRenderingContext::UploadCompressedTextures() {
+  bool uploaded = false;
+  GLuint unpackBuffer = HasBufferBinding(GL_PIXEL_UNPACK_BUFFER) ? GetBufferBinding(GL_PIXEL_UNPACK_BUFFER) : 0;
+
+  for (auto iter = pendingCompressedTextures.begin(); iter != pendingCompressedTextures.end();) {
+    if (!TextureCompression::IsReady(*iter->second)) {
+      iter++;
+      continue;
+    }
+
+    if (!uploaded && unpackBuffer != 0) {
+      glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    }
+    uploaded = true;
+
+    glBindTexture(GL_TEXTURE_2D, iter->first);
+    TextureCompression::TexImage2D(GL_TEXTURE_2D, *iter->second);
+    mipmappedTextures.insert(iter->first);
+    compressedTextures[iter->first] = iter->second;
+    iter = pendingCompressedTextures.erase(iter);
+  }
+
+  if (uploaded) {
+    glBindTexture(GL_TEXTURE_2D, GetTextureBinding(activeTexture, GL_TEXTURE_2D));
+    if (unpackBuffer != 0) {
+      glBindBuffer(GL_PIXEL_UNPACK_BUFFER, unpackBuffer);
+    }
+    glPixelStorei(GL_UNPACK_ALIGNMENT, unpackAlignment);
+  }
+}
+
 NAN_METHOD(WebGLRenderingContext::New) {
   WebGLRenderingContext *gl = new WebGLRenderingContext();
   Local<Object> glObj = info.This();
@@ -849,6 +922,13 @@ NAN_METHOD(WebGLRenderingContext::New) {
 
 NAN_METHOD(WebGLRenderingContext::Destroy) {
   WebGLRenderingContext *gl = ObjectWrap::Unwrap<WebGLRenderingContext>(info.This());
+  if (gl->live) {
+    // the window is destroyed right after this, so free the staging ring and its fences while it is still current
+    if (gl->windowHandle) {
+      glfw::SetCurrentWindowContext(gl->windowHandle);
+    }
+    gl->streamingBuffer.Destroy();
+  }
   gl->live = false;
 }
 
@@ -885,6 +965,49 @@ NAN_METHOD(WebGLRenderingContext::ClearDirty) {
   gl->dirty = false;
 }
 
+NAN_METHOD(WebGLRenderingContext::EndFrame) {
+  WebGLRenderingContext *gl = ObjectWrap::Unwrap<WebGLRenderingContext>(info.This());
+
+  // the frame's commands are flushed; fence the streamed uploads it used and swap in finished texture encodes,
+  // whether or not the context is shown (skipped if the context has already been handed to the present thread)
+  if (gl->live && (!gl->windowHandle || glfwGetCurrentContext() == gl->windowHandle)) {
+    gl->streamingBuffer.EndFrame();
+    gl->UploadCompressedTextures();
+  }
+}
+
+NAN_METHOD(WebGLRenderingContext::GetStreamingStats) {
+  WebGLRenderingContext *gl = ObjectWrap::Unwrap<WebGLRenderingContext>(info.This());
+
+  Local<Object> result = Nan::New<Object>();
+  result->Set(JS_STR("streamed"), JS_NUM((double)gl->streamingBuffer.numStreamed));
+  result->Set(JS_STR("rejected"), JS_NUM((double)gl->streamingBuffer.numRejected));
+  info.GetReturnValue().Set(result);
+}
+
+NAN_METHOD(WebGLRenderingContext::SetTextureCompression) {
+  WebGLRenderingContext *gl = ObjectWrap::Unwrap<WebGLRenderingContext>(info.This());
+  gl->textureCompression = info[0]->BooleanValue();
+}
+
+NAN_METHOD(WebGLRenderingContext::SetTexturePacking) {
+  WebGLRenderingContext *gl = ObjectWrap::Unwrap<WebGLRenderingContext>(info.This());
+  if (info[0]->IsString()) {
+    String::Utf8Value modeValue(info[0]);
+    if (strcmp(*modeValue, "none") == 0) {
+      gl->texturePacking = TextureCompression::PACKING_NONE;
+    } else if (strcmp(*modeValue, "auto") == 0) {
+      gl->texturePacking = TextureCompression::PACKING_AUTO;
+    } else if (strcmp(*modeValue, "always") == 0) {
+      gl->texturePacking = TextureCompression::PACKING_ALWAYS;
+    } else {
+      Nan::ThrowError("setTexturePacking: invalid mode");
+    }
+  } else {
+    Nan::ThrowError("setTexturePacking: invalid arguments");
+  }
+}
+
 // GL CALLS
 
 // A 32-bit and 64-bit compatible way of converting a pointer to a GLuint.
@@ -923,9 +1046,12 @@ inline void *getImageData(Local<Value> arg, int *num = nullptr) {
       if (obj->IsArrayBufferView()) {
         pixels = getArrayData<unsigned char>(obj, num);
       } else {
-        Local<String> dataString = String::NewFromUtf8(Isolate::GetCurrent(), "data", NewStringType::kInternalized).ToLocalChecked();
+        Local<String> dataString = JS_KEY(data);
         if (obj->Has(dataString)) {
+          // a GPU canvas reads its pixels back on its own context
+          GLFWwindow *window = glfwGetCurrentContext();
           Local<Value> data = obj->Get(dataString);
+          glfw::SetCurrentWindowContext(window);
           pixels = getArrayData<unsigned char>(data, num);
         } else {
           Nan::ThrowError("Bad texture argument");
@@ -969,6 +1095,49 @@ void flipImageData(char *dstData, char *srcData, size_t width, size_t height, si
   }
 }
 
+// Invalidation is only a hint, so it is skipped where the driver does not expose it (e.g. GL 4.1 on macOS).
+void invalidateFramebuffer(GLenum target, GLsizei numAttachments, const GLenum *attachments) {
+#if __ANDROID__ || (__APPLE__ && TARGET_OS_IPHONE)
+  glInvalidateFramebuffer(target, numAttachments, attachments);
+#else
+  if (glInvalidateFramebuffer) {
+    glInvalidateFramebuffer(target, numAttachments, attachments);
+  }
+#endif
+}
+
+void invalidateSubFramebuffer(GLenum target, GLsizei numAttachments, const GLenum *attachments, GLint x, GLint y, GLsizei width, GLsizei height) {
+#if __ANDROID__ || (__APPLE__ && TARGET_OS_IPHONE)
+  glInvalidateSubFramebuffer(target, numAttachments, attachments, x, y, width, height);
+#else
+  if (glInvalidateSubFramebuffer) {
+    glInvalidateSubFramebuffer(target, numAttachments, attachments, x, y, width, height);
+  }
+#endif
+}
+
+// When the context renders into an offscreen default framebuffer, the WebGL names for the
+// default framebuffer's buffers have to be translated to that framebuffer's attachment points.
+size_t getInvalidateAttachments(WebGLRenderingContext *gl, GLenum target, Local<Array> attachmentsArray, GLenum *attachments, size_t maxAttachments) {
+  GLint framebuffer = 0;
+  glGetIntegerv(target == GL_READ_FRAMEBUFFER ? GL_READ_FRAMEBUFFER_BINDING : GL_DRAW_FRAMEBUFFER_BINDING, &framebuffer);
+  bool offscreenDefault = gl->defaultFramebuffer != 0 && (GLuint)framebuffer == gl->defaultFramebuffer;
+
+  size_t numAttachments = std::min<size_t>(attachmentsArray->Length(), maxAttachments);
+  for (size_t i = 0; i < numAttachments; i++) {
+    GLenum attachment = attachmentsArray->Get(i)->Uint32Value();
+    if (offscreenDefault) {
+      switch (attachment) {
+        case GL_COLOR: attachment = GL_COLOR_ATTACHMENT0; break;
+        case GL_DEPTH: attachment = GL_DEPTH_ATTACHMENT; break;
+        case GL_STENCIL: attachment = GL_STENCIL_ATTACHMENT; break;
+      }
+    }
+    attachments[i] = attachment;
+  }
+  return numAttachments;
+}
+
 template <typename T>
 void expandLuminance(char *dstData, char *srcData, size_t width, size_t height) {
   size_t size = width * height;
@@ -996,7 +1165,7 @@ void expandLuminanceAlpha(char *dstData, char *srcData, size_t width, size_t hei
 
 NAN_METHOD(WebGLRenderingContext::Uniform1f) {
   if (info[0]->IsObject()) {
-    GLuint location = info[0]->ToObject()->Get(JS_STR("id"))->Uint32Value();
+    GLuint location = info[0]->ToObject()->Get(JS_KEY(id))->Uint32Value();
     float x = (float)info[1]->NumberValue();
 
     glUniform1f(location, x);
@@ -1005,7 +1174,7 @@ NAN_METHOD(WebGLRenderingContext::Uniform1f) {
 
 NAN_METHOD(WebGLRenderingContext::Uniform2f) {
   if (info[0]->IsObject()) {
-    GLuint location = info[0]->ToObject()->Get(JS_STR("id"))->Uint32Value();
+    GLuint location = info[0]->ToObject()->Get(JS_KEY(id))->Uint32Value();
     float x = (float)info[1]->NumberValue();
     float y = (float)info[2]->NumberValue();
 
@@ -1015,7 +1184,7 @@ NAN_METHOD(WebGLRenderingContext::Uniform2f) {
 
 NAN_METHOD(WebGLRenderingContext::Uniform3f) {
   if (info[0]->IsObject()) {
-    GLuint location = info[0]->ToObject()->Get(JS_STR("id"))->Uint32Value();
+    GLuint location = info[0]->ToObject()->Get(JS_KEY(id))->Uint32Value();
     float x = (float)info[1]->NumberValue();
     float y = (float)info[2]->NumberValue();
     float z = (float)info[3]->NumberValue();
@@ -1026,7 +1195,7 @@ NAN_METHOD(WebGLRenderingContext::Uniform3f) {
 
 NAN_METHOD(WebGLRenderingContext::Uniform4f) {
   if (info[0]->IsObject()) {
-    GLuint location = info[0]->ToObject()->Get(JS_STR("id"))->Uint32Value();
+    GLuint location = info[0]->ToObject()->Get(JS_KEY(id))->Uint32Value();
     float x = (float)info[1]->NumberValue();
     float y = (float)info[2]->NumberValue();
     float z = (float)info[3]->NumberValue();
@@ -1038,7 +1207,7 @@ NAN_METHOD(WebGLRenderingContext::Uniform4f) {
 
 NAN_METHOD(WebGLRenderingContext::Uniform1i) {
   if (info[0]->IsObject()) {
-    GLuint location = info[0]->ToObject()->Get(JS_STR("id"))->Uint32Value();
+    GLuint location = info[0]->ToObject()->Get(JS_KEY(id))->Uint32Value();
     GLint x = info[1]->Int32Value();
 
     glUniform1i(location, x);
@@ -1047,7 +1216,7 @@ NAN_METHOD(WebGLRenderingContext::Uniform1i) {
 
 NAN_METHOD(WebGLRenderingContext::Uniform2i) {
   if (info[0]->IsObject()) {
-    GLuint location = info[0]->ToObject()->Get(JS_STR("id"))->Uint32Value();
+    GLuint location = info[0]->ToObject()->Get(JS_KEY(id))->Uint32Value();
     GLint x = info[1]->Int32Value();
     GLint y = info[2]->Int32Value();
 
@@ -1057,7 +1226,7 @@ NAN_METHOD(WebGLRenderingContext::Uniform2i) {
 
 NAN_METHOD(WebGLRenderingContext::Uniform3i) {
   if (info[0]->IsObject()) {
-    GLuint location = info[0]->ToObject()->Get(JS_STR("id"))->Uint32Value();
+    GLuint location = info[0]->ToObject()->Get(JS_KEY(id))->Uint32Value();
     GLint x = info[1]->Int32Value();
     GLint y = info[2]->Int32Value();
     GLint z = info[3]->Int32Value();
@@ -1068,7 +1237,7 @@ NAN_METHOD(WebGLRenderingContext::Uniform3i) {
 
 NAN_METHOD(WebGLRenderingContext::Uniform4i) {
   if (info[0]->IsObject()) {
-    GLuint location = info[0]->ToObject()->Get(JS_STR("id"))->Uint32Value();
+    GLuint location = info[0]->ToObject()->Get(JS_KEY(id))->Uint32Value();
     GLint x = info[1]->Int32Value();
     GLint y = info[2]->Int32Value();
     GLint z = info[3]->Int32Value();
@@ -1080,7 +1249,7 @@ NAN_METHOD(WebGLRenderingContext::Uniform4i) {
 
 NAN_METHOD(WebGLRenderingContext::Uniform1ui) {
   if (info[0]->IsObject()) {
-    GLuint location = info[0]->ToObject()->Get(JS_STR("id"))->Uint32Value();
+    GLuint location = info[0]->ToObject()->Get(JS_KEY(id))->Uint32Value();
     GLuint x = info[1]->Uint32Value();
 
     glUniform1ui(location, x);
@@ -1089,7 +1258,7 @@ NAN_METHOD(WebGLRenderingContext::Uniform1ui) {
 
 NAN_METHOD(WebGLRenderingContext::Uniform2ui) {
   if (info[0]->IsObject()) {
-    GLuint location = info[0]->ToObject()->Get(JS_STR("id"))->Uint32Value();
+    GLuint location = info[0]->ToObject()->Get(JS_KEY(id))->Uint32Value();
     GLuint x = info[1]->Uint32Value();
     GLuint y = info[2]->Uint32Value();
 
@@ -1099,7 +1268,7 @@ NAN_METHOD(WebGLRenderingContext::Uniform2ui) {
 
 NAN_METHOD(WebGLRenderingContext::Uniform3ui) {
   if (info[0]->IsObject()) {
-    GLuint location = info[0]->ToObject()->Get(JS_STR("id"))->Uint32Value();
+    GLuint location = info[0]->ToObject()->Get(JS_KEY(id))->Uint32Value();
     GLuint x = info[1]->Uint32Value();
     GLuint y = info[2]->Uint32Value();
     GLuint z = info[3]->Uint32Value();
@@ -1110,7 +1279,7 @@ NAN_METHOD(WebGLRenderingContext::Uniform3ui) {
 
 NAN_METHOD(WebGLRenderingContext::Uniform4ui) {
   if (info[0]->IsObject()) {
-    GLuint location = info[0]->ToObject()->Get(JS_STR("id"))->Uint32Value();
+    GLuint location = info[0]->ToObject()->Get(JS_KEY(id))->Uint32Value();
     GLuint x = info[1]->Uint32Value();
     GLuint y = info[2]->Uint32Value();
     GLuint z = info[3]->Uint32Value();
@@ -1122,7 +1291,7 @@ NAN_METHOD(WebGLRenderingContext::Uniform4ui) {
 
 NAN_METHOD(WebGLRenderingContext::Uniform1fv) {
   if (info[0]->IsObject()) {
-    GLuint location = info[0]->ToObject()->Get(JS_STR("id"))->Uint32Value();
+    GLuint location = info[0]->ToObject()->Get(JS_KEY(id))->Uint32Value();
 
     GLfloat *data;
     int count;
@@ -1153,7 +1322,7 @@ NAN_METHOD(WebGLRenderingContext::Uniform1fv) {
 
 NAN_METHOD(WebGLRenderingContext::Uniform2fv) {
   if (info[0]->IsObject()) {
-    GLuint location = info[0]->ToObject()->Get(JS_STR("id"))->Uint32Value();
+    GLuint location = info[0]->ToObject()->Get(JS_KEY(id))->Uint32Value();
 
     GLfloat *data;
     int count;
@@ -1186,7 +1355,7 @@ NAN_METHOD(WebGLRenderingContext::Uniform2fv) {
 
 NAN_METHOD(WebGLRenderingContext::Uniform3fv) {
   if (info[0]->IsObject()) {
-    GLuint location = info[0]->ToObject()->Get(JS_STR("id"))->Uint32Value();
+    GLuint location = info[0]->ToObject()->Get(JS_KEY(id))->Uint32Value();
 
     GLfloat *data;
     int count;
@@ -1219,7 +1388,7 @@ NAN_METHOD(WebGLRenderingContext::Uniform3fv) {
 
 NAN_METHOD(WebGLRenderingContext::Uniform4fv) {
   if (info[0]->IsObject()) {
-    GLuint location = info[0]->ToObject()->Get(JS_STR("id"))->Uint32Value();
+    GLuint location = info[0]->ToObject()->Get(JS_KEY(id))->Uint32Value();
 
     GLfloat *data;
     int count;
@@ -1252,7 +1421,7 @@ NAN_METHOD(WebGLRenderingContext::Uniform4fv) {
 
 NAN_METHOD(WebGLRenderingContext::Uniform1iv) {
   if (info[0]->IsObject()) {
-    GLuint location = info[0]->ToObject()->Get(JS_STR("id"))->Uint32Value();
+    GLuint location = info[0]->ToObject()->Get(JS_KEY(id))->Uint32Value();
 
     GLint *data;
     int count;
@@ -1283,7 +1452,7 @@ NAN_METHOD(WebGLRenderingContext::Uniform1iv) {
 
 NAN_METHOD(WebGLRenderingContext::Uniform2iv) {
   if (info[0]->IsObject()) {
-    GLuint location = info[0]->ToObject()->Get(JS_STR("id"))->Uint32Value();
+    GLuint location = info[0]->ToObject()->Get(JS_KEY(id))->Uint32Value();
 
     GLint *data;
     int count;
@@ -1316,7 +1485,7 @@ NAN_METHOD(WebGLRenderingContext::Uniform2iv) {
 
 NAN_METHOD(WebGLRenderingContext::Uniform3iv) {
   if (info[0]->IsObject()) {
-    GLuint location = info[0]->ToObject()->Get(JS_STR("id"))->Uint32Value();
+    GLuint location = info[0]->ToObject()->Get(JS_KEY(id))->Uint32Value();
 
     GLint *data;
     int count;
@@ -1349,7 +1518,7 @@ NAN_METHOD(WebGLRenderingContext::Uniform3iv) {
 
 NAN_METHOD(WebGLRenderingContext::Uniform4iv) {
   if (info[0]->IsObject()) {
-    GLuint location = info[0]->ToObject()->Get(JS_STR("id"))->Uint32Value();
+    GLuint location = info[0]->ToObject()->Get(JS_KEY(id))->Uint32Value();
 
     GLint *data;
     int count;
@@ -1382,7 +1551,7 @@ NAN_METHOD(WebGLRenderingContext::Uniform4iv) {
 
 NAN_METHOD(WebGLRenderingContext::Uniform1uiv) {
   if (info[0]->IsObject()) {
-    GLuint location = info[0]->ToObject()->Get(JS_STR("id"))->Uint32Value();
+    GLuint location = info[0]->ToObject()->Get(JS_KEY(id))->Uint32Value();
     Local<Value> dataValue = info[1];
 
     GLuint *data;
@@ -1414,7 +1583,7 @@ NAN_METHOD(WebGLRenderingContext::Uniform1uiv) {
 
 NAN_METHOD(WebGLRenderingContext::Uniform2uiv) {
   if (info[0]->IsObject()) {
-    GLuint location = info[0]->ToObject()->Get(JS_STR("id"))->Uint32Value();
+    GLuint location = info[0]->ToObject()->Get(JS_KEY(id))->Uint32Value();
     Local<Value> dataValue = info[1];
 
     GLuint *data;
@@ -1446,7 +1615,7 @@ NAN_METHOD(WebGLRenderingContext::Uniform2uiv) {
 
 NAN_METHOD(WebGLRenderingContext::Uniform3uiv) {
   if (info[0]->IsObject()) {
-    GLuint location = info[0]->ToObject()->Get(JS_STR("id"))->Uint32Value();
+    GLuint location = info[0]->ToObject()->Get(JS_KEY(id))->Uint32Value();
     Local<Value> dataValue = info[1];
 
     GLuint *data;
@@ -1478,7 +1647,7 @@ NAN_METHOD(WebGLRenderingContext::Uniform3uiv) {
 
 NAN_METHOD(WebGLRenderingContext::Uniform4uiv) {
   if (info[0]->IsObject()) {
-    GLuint location = info[0]->ToObject()->Get(JS_STR("id"))->Uint32Value();
+    GLuint location = info[0]->ToObject()->Get(JS_KEY(id))->Uint32Value();
     Local<Value> dataValue = info[1];
 
     GLuint *data;
@@ -1510,7 +1679,7 @@ NAN_METHOD(WebGLRenderingContext::Uniform4uiv) {
 
 NAN_METHOD(WebGLRenderingContext::UniformMatrix2fv) {
   if (info[0]->IsObject()) {
-    GLuint location = info[0]->ToObject()->Get(JS_STR("id"))->Uint32Value();
+    GLuint location = info[0]->ToObject()->Get(JS_KEY(id))->Uint32Value();
     GLboolean transpose = info[1]->BooleanValue();
 
     GLfloat *data;
@@ -1549,7 +1718,7 @@ NAN_METHOD(WebGLRenderingContext::UniformMatrix2fv) {
 
 NAN_METHOD(WebGLRenderingContext::UniformMatrix3fv) {
   if (info[0]->IsObject()) {
-    GLuint location = info[0]->ToObject()->Get(JS_STR("id"))->Uint32Value();
+    GLuint location = info[0]->ToObject()->Get(JS_KEY(id))->Uint32Value();
     GLboolean transpose = info[1]->BooleanValue();
 
     GLfloat *data;
@@ -1586,7 +1755,7 @@ NAN_METHOD(WebGLRenderingContext::UniformMatrix3fv) {
 
 NAN_METHOD(WebGLRenderingContext::UniformMatrix4fv) {
   if (info[0]->IsObject()) {
-    GLuint location = info[0]->ToObject()->Get(JS_STR("id"))->Uint32Value();
+    GLuint location = info[0]->ToObject()->Get(JS_KEY(id))->Uint32Value();
     GLboolean transpose = info[1]->BooleanValue();
 
     GLfloat *data;
@@ -1623,7 +1792,7 @@ NAN_METHOD(WebGLRenderingContext::UniformMatrix4fv) {
 
 NAN_METHOD(WebGLRenderingContext::UniformMatrix3x2fv) {
   if (info[0]->IsObject()) {
-    GLuint location = info[0]->ToObject()->Get(JS_STR("id"))->Uint32Value();
+    GLuint location = info[0]->ToObject()->Get(JS_KEY(id))->Uint32Value();
     bool transpose = info[1]->BooleanValue();
     Local<Value> dataValue = info[2];
 
@@ -1661,7 +1830,7 @@ NAN_METHOD(WebGLRenderingContext::UniformMatrix3x2fv) {
 
 NAN_METHOD(WebGLRenderingContext::UniformMatrix4x2fv) {
   if (info[0]->IsObject()) {
-    GLuint location = info[0]->ToObject()->Get(JS_STR("id"))->Uint32Value();
+    GLuint location = info[0]->ToObject()->Get(JS_KEY(id))->Uint32Value();
     bool transpose = info[1]->BooleanValue();
     Local<Value> dataValue = info[2];
 
@@ -1699,7 +1868,7 @@ NAN_METHOD(WebGLRenderingContext::UniformMatrix4x2fv) {
 
 NAN_METHOD(WebGLRenderingContext::UniformMatrix2x3fv) {
   if (info[0]->IsObject()) {
-    GLuint location = info[0]->ToObject()->Get(JS_STR("id"))->Uint32Value();
+    GLuint location = info[0]->ToObject()->Get(JS_KEY(id))->Uint32Value();
     bool transpose = info[1]->BooleanValue();
     Local<Value> dataValue = info[2];
 
@@ -1737,7 +1906,7 @@ NAN_METHOD(WebGLRenderingContext::UniformMatrix2x3fv) {
 
 NAN_METHOD(WebGLRenderingContext::UniformMatrix4x3fv) {
   if (info[0]->IsObject()) {
-    GLuint location = info[0]->ToObject()->Get(JS_STR("id"))->Uint32Value();
+    GLuint location = info[0]->ToObject()->Get(JS_KEY(id))->Uint32Value();
     bool transpose = info[1]->BooleanValue();
     Local<Value> dataValue = info[2];
 
@@ -1775,7 +1944,7 @@ NAN_METHOD(WebGLRenderingContext::UniformMatrix4x3fv) {
 
 NAN_METHOD(WebGLRenderingContext::UniformMatrix2x4fv) {
   if (info[0]->IsObject()) {
-    GLuint location = info[0]->ToObject()->Get(JS_STR("id"))->Uint32Value();
+    GLuint location = info[0]->ToObject()->Get(JS_KEY(id))->Uint32Value();
     bool transpose = info[1]->BooleanValue();
     Local<Value> dataValue = info[2];
 
@@ -1813,7 +1982,7 @@ NAN_METHOD(WebGLRenderingContext::UniformMatrix2x4fv) {
 
 NAN_METHOD(WebGLRenderingContext::UniformMatrix3x4fv) {
   if (info[0]->IsObject()) {
-    GLuint location = info[0]->ToObject()->Get(JS_STR("id"))->Uint32Value();
+    GLuint location = info[0]->ToObject()->Get(JS_KEY(id))->Uint32Value();
     bool transpose = info[1]->BooleanValue();
     Local<Value> dataValue = info[2];
 
@@ -1875,7 +2044,7 @@ NAN_METHOD(WebGLRenderingContext::PixelStorei) {
 }
 
 NAN_METHOD(WebGLRenderingContext::BindAttribLocation) {
-  GLuint programId = info[0]->ToObject()->Get(JS_STR("id"))->Uint32Value();
+  GLuint programId = info[0]->ToObject()->Get(JS_KEY(id))->Uint32Value();
   int index = info[1]->Int32Value();
   String::Utf8Value name(info[2]);
 
@@ -1919,14 +2088,21 @@ NAN_METHOD(WebGLRenderingContext::DrawArraysInstanced) {
 }
 
 NAN_METHOD(WebGLRenderingContext::GenerateMipmap) {
+  WebGLRenderingContext *gl = ObjectWrap::Unwrap<WebGLRenderingContext>(info.This());
   GLint target = info[0]->Int32Value();
+
+  // compressed uploads already carry their full mip chain
+  if (gl->mipmappedTextures.find(gl->GetTextureBinding(gl->activeTexture, target)) != gl->mipmappedTextures.end()) {
+    return;
+  }
+
   glGenerateMipmap(target);
 
   // info.GetReturnValue().Set(Nan::Undefined());
 }
 
 NAN_METHOD(WebGLRenderingContext::GetAttribLocation) {
-  GLint programId = info[0]->ToObject()->Get(JS_STR("id"))->Int32Value();
+  GLint programId = info[0]->ToObject()->Get(JS_KEY(id))->Int32Value();
   String::Utf8Value name(info[1]);
 
   GLint result = glGetAttribLocation(programId, *name);
@@ -1959,14 +2135,14 @@ NAN_METHOD(WebGLRenderingContext::CreateShader) {
 
   GLuint shaderId = glCreateShader(type);
   Local<Object> shaderObject = Nan::New<Object>();
-  shaderObject->Set(JS_STR("id"), JS_INT(shaderId));
+  shaderObject->Set(JS_KEY(id), JS_INT(shaderId));
 
   info.GetReturnValue().Set(shaderObject);
 }
 
 
 NAN_METHOD(WebGLRenderingContext::ShaderSource) {
-  GLint shaderId = info[0]->ToObject()->Get(JS_STR("id"))->Int32Value();
+  GLint shaderId = info[0]->ToObject()->Get(JS_KEY(id))->Int32Value();
   String::Utf8Value code(info[1]);
   GLint length = code.length();
 
@@ -1979,7 +2155,7 @@ NAN_METHOD(WebGLRenderingContext::ShaderSource) {
 
 
 NAN_METHOD(WebGLRenderingContext::CompileShader) {
-  GLint shaderId = info[0]->ToObject()->Get(JS_STR("id"))->Int32Value();
+  GLint shaderId = info[0]->ToObject()->Get(JS_KEY(id))->Int32Value();
   glCompileShader(shaderId);
 
   // info.GetReturnValue().Set(Nan::Undefined());
@@ -2036,7 +2212,7 @@ NAN_METHOD(WebGLRenderingContext::SetDefaultFramebuffer) {
 }
 
 NAN_METHOD(WebGLRenderingContext::GetShaderParameter) {
-  GLint shaderId = info[0]->ToObject()->Get(JS_STR("id"))->Int32Value();
+  GLint shaderId = info[0]->ToObject()->Get(JS_KEY(id))->Int32Value();
   GLint pname = info[1]->Int32Value();
   int value;
   switch (pname) {
@@ -2062,7 +2238,7 @@ NAN_METHOD(WebGLRenderingContext::GetShaderParameter) {
 }
 
 NAN_METHOD(WebGLRenderingContext::GetShaderInfoLog) {
-  GLint shaderId = info[0]->ToObject()->Get(JS_STR("id"))->Int32Value();
+  GLint shaderId = info[0]->ToObject()->Get(JS_KEY(id))->Int32Value();
   char Error[1024];
   int Len;
 
@@ -2076,27 +2252,27 @@ NAN_METHOD(WebGLRenderingContext::CreateProgram) {
   GLuint programId = glCreateProgram();
 
   Local<Object> programObject = Nan::New<Object>();
-  programObject->Set(JS_STR("id"), JS_INT(programId));
+  programObject->Set(JS_KEY(id), JS_INT(programId));
   info.GetReturnValue().Set(programObject);
 }
 
 
 NAN_METHOD(WebGLRenderingContext::AttachShader) {
-  GLint programId = info[0]->ToObject()->Get(JS_STR("id"))->Int32Value();
-  GLint shaderId = info[1]->ToObject()->Get(JS_STR("id"))->Int32Value();
+  GLint programId = info[0]->ToObject()->Get(JS_KEY(id))->Int32Value();
+  GLint shaderId = info[1]->ToObject()->Get(JS_KEY(id))->Int32Value();
 
   glAttachShader(programId, shaderId);
 }
 
 
 NAN_METHOD(WebGLRenderingContext::LinkProgram) {
-  GLint programId = info[0]->ToObject()->Get(JS_STR("id"))->Int32Value();
+  GLint programId = info[0]->ToObject()->Get(JS_KEY(id))->Int32Value();
   glLinkProgram(programId);
 }
 
 
 NAN_METHOD(WebGLRenderingContext::GetProgramParameter) {
-  GLint programId = info[0]->ToObject()->Get(JS_STR("id"))->Int32Value();
+  GLint programId = info[0]->ToObject()->Get(JS_KEY(id))->Int32Value();
   int pname = info[1]->Int32Value();
   int value;
 
@@ -2120,13 +2296,13 @@ NAN_METHOD(WebGLRenderingContext::GetProgramParameter) {
 
 
 NAN_METHOD(WebGLRenderingContext::GetUniformLocation) {
-  GLint programId = info[0]->ToObject()->Get(JS_STR("id"))->Int32Value();
+  GLint programId = info[0]->ToObject()->Get(JS_KEY(id))->Int32Value();
   v8::String::Utf8Value name(info[1]);
 
   GLint location = glGetUniformLocation(programId, *name);
 
   Local<Object> locationObject = Nan::New<Object>();
-  locationObject->Set(JS_STR("id"), JS_INT(location));
+  locationObject->Set(JS_KEY(id), JS_INT(location));
   info.GetReturnValue().Set(locationObject);
 }
 
@@ -2170,7 +2346,7 @@ NAN_METHOD(WebGLRenderingContext::CreateTexture) {
   glGenTextures(1, &texture);
 
   Local<Object> textureObject = Nan::New<Object>();
-  textureObject->Set(JS_STR("id"), JS_INT(texture));
+  textureObject->Set(JS_KEY(id), JS_INT(texture));
   info.GetReturnValue().Set(textureObject);
 }
 
@@ -2180,7 +2356,7 @@ NAN_METHOD(WebGLRenderingContext::BindTexture) {
   WebGLRenderingContext *gl = ObjectWrap::Unwrap<WebGLRenderingContext>(glObj);
 
   GLenum target = info[0]->Int32Value();
-  GLuint texture = info[1]->IsObject() ? info[1]->ToObject()->Get(JS_STR("id"))->Uint32Value() : 0;
+  GLuint texture = info[1]->IsObject() ? info[1]->ToObject()->Get(JS_KEY(id))->Uint32Value() : 0;
 
   glBindTexture(target, texture);
 
@@ -2208,8 +2384,8 @@ NAN_METHOD(WebGLRenderingContext::FlipTextureData) {
 inline bool hasWidthHeight(Local<Value> &value) {
   MaybeLocal<Object> valueObject(Nan::To<Object>(value));
   if (!valueObject.IsEmpty()) {
-    Local<String> widthString = Nan::New<String>("width", sizeof("width") - 1).ToLocalChecked();
-    Local<String> heightString = Nan::New<String>("height", sizeof("height") - 1).ToLocalChecked();
+    Local<String> widthString = JS_KEY(width);
+    Local<String> heightString = JS_KEY(height);
 
     MaybeLocal<Number> widthValue(Nan::To<Number>(valueObject.ToLocalChecked()->Get(widthString)));
     MaybeLocal<Number> heightValue(Nan::To<Number>(valueObject.ToLocalChecked()->Get(heightString)));
@@ -2342,13 +2518,13 @@ int getImageFormat(Local<Value> arg) {
   if (arg->IsArrayBufferView()) {
     return -1;
   } else {
-    Local<Value> constructorName = arg->ToObject()->Get(JS_STR("constructor"))->ToObject()->Get(JS_STR("name"));
+    Local<Value> constructorName = arg->ToObject()->Get(JS_KEY(constructor))->ToObject()->Get(JS_KEY(name));
     if (
-      constructorName->StrictEquals(JS_STR("HTMLImageElement")) ||
-      constructorName->StrictEquals(JS_STR("HTMLVideoElement")) ||
-      constructorName->StrictEquals(JS_STR("ImageData")) ||
-      constructorName->StrictEquals(JS_STR("ImageBitmap")) ||
-      constructorName->StrictEquals(JS_STR("HTMLCanvasElement"))
+      constructorName->StrictEquals(JS_KEY(HTMLImageElement)) ||
+      constructorName->StrictEquals(JS_KEY(HTMLVideoElement)) ||
+      constructorName->StrictEquals(JS_KEY(ImageData)) ||
+      constructorName->StrictEquals(JS_KEY(ImageBitmap)) ||
+      constructorName->StrictEquals(JS_KEY(HTMLCanvasElement))
     ) {
       return GL_RGBA;
     } else {
@@ -2357,6 +2533,15 @@ int getImageFormat(Local<Value> arg) {
   }
 }
 
+bool isStaticImage(Local<Value> arg) {
+  if (arg->IsArrayBufferView()) {
+    return false;
+  } else {
+    Local<Value> constructorName = arg->ToObject()->Get(JS_KEY(constructor))->ToObject()->Get(JS_KEY(name));
+    return constructorName->StrictEquals(JS_KEY(HTMLImageElement)) || constructorName->StrictEquals(JS_KEY(ImageBitmap));
+  }
+}
+
 size_t getArrayBufferViewElementSize(Local<ArrayBufferView> arrayBufferView) {
   if (arrayBufferView->IsFloat64Array()) {
     return 8;
@@ -2369,6 +2554,127 @@ size_t getArrayBufferViewElementSize(Local<ArrayBufferView> arrayBufferView) {
   }
 }
 
+CanvasRenderingContext2D *getCanvasContext2D(Local<Value> arg) {
+  if (arg->IsObject() && !arg->IsArrayBufferView()) {
+    Local<Object> obj = Local<Object>::Cast(arg);
+    Local<Value> constructorName = obj->Get(JS_KEY(constructor))->ToObject()->Get(JS_KEY(name));
+    if (constructorName->StrictEquals(JS_KEY(HTMLCanvasElement)) || constructorName->StrictEquals(JS_KEY(OffscreenCanvas))) {
+      Local<Value> contextObj = obj->Get(JS_KEY(_context));
+      if (contextObj->IsObject() && contextObj->ToObject()->Get(JS_KEY(constructor))->ToObject()->Get(JS_KEY(name))->StrictEquals(JS_KEY(CanvasRenderingContext2D))) {
+        return ObjectWrap::Unwrap<CanvasRenderingContext2D>(Local<Object>::Cast(contextObj));
+      }
+    }
+  }
+  return nullptr;
+}
+
+// Uploads only what was drawn on the canvas since it was last uploaded into the texture. Returns false if the
+// texture has to be filled in full.
+bool texImageCanvasDirtyRect(WebGLRenderingContext *gl, GLuint texture, CanvasRenderingContext2D *canvasContext, Local<Value> pixels, GLsizei width, GLsizei height, GLenum internalformat, bool flipY) {
+  auto iter = gl->canvasTextures.find(texture);
+  if (iter == gl->canvasTextures.end() || gl->framebufferTextures.find(texture) != gl->framebufferTextures.end()) {
+    return false;
+  }
+  const WebGLRenderingContext::CanvasTexture &canvasTexture = iter->second;
+  if (
+    canvasTexture.canvas != canvasContext || canvasTexture.version != canvasContext->GetUploadVersion() ||
+    canvasTexture.width != width || canvasTexture.height != height ||
+    canvasTexture.internalformat != internalformat || canvasTexture.flipY != flipY
+  ) {
+    return false;
+  }
+
+  const SkIRect dirtyRect = canvasContext->GetUploadDirtyRect();
+  if (!dirtyRect.isEmpty()) {
+    // reading the data brings the dirty rows up to date
+    char *pixelsV = (char *)getImageData(pixels);
+    if (pixelsV == nullptr) {
+      return false;
+    }
+
+    size_t stride = dirtyRect.width() * 4;
+    unique_ptr<char[]> dirtyPixels(new char[stride * dirtyRect.height()]);
+    for (int i = 0; i < dirtyRect.height(); i++) {
+      int dstRow = flipY ? (dirtyRect.height() - 1 - i) : i;
+      memcpy(dirtyPixels.get() + dstRow * stride, pixelsV + ((dirtyRect.fTop + i) * width + dirtyRect.fLeft) * 4, stride);
+    }
+    GLint yoffset = flipY ? (height - dirtyRect.fBottom) : dirtyRect.fTop;
+
+    // the sub-rect is tightly packed client memory, whatever the page's unpack state says
+    GLuint unpackBuffer = gl->HasBufferBinding(GL_PIXEL_UNPACK_BUFFER) ? gl->GetBufferBinding(GL_PIXEL_UNPACK_BUFFER) : 0;
+    if (unpackBuffer != 0) {
+      glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    }
+    GLint unpackRowLength;
+    glGetIntegerv(GL_UNPACK_ROW_LENGTH, &unpackRowLength);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+
+    glTexSubImage2D(GL_TEXTURE_2D, 0, dirtyRect.fLeft, yoffset, dirtyRect.width(), dirtyRect.height(), GL_RGBA, GL_UNSIGNED_BYTE, dirtyPixels.get());
+
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, unpackRowLength);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, gl->unpackAlignment);
+    if (unpackBuffer != 0) {
+      glBindBuffer(GL_PIXEL_UNPACK_BUFFER, unpackBuffer);
+    }
+  }
+
+  iter->second.version = canvasContext->TakeUploadDirtyRect();
+  return true;
+}
+
+// Copies a GPU canvas into the texture with a blit once Skia's drawing is done, without reading it back. Returns
+// false if the canvas is raster or its texture is not shared with this context.
+bool texImageCanvasGpu(WebGLRenderingContext *gl, GLuint texture, CanvasRenderingContext2D *canvasContext, GLsizei width, GLsizei height, GLenum internalformat, bool flipY) {
+  GLuint canvasTexture = canvasContext->GetGpuTexture();
+  if (canvasTexture == 0 || !gl->windowHandle || !glfw::IsSameShareGroup(gl->windowHandle, CanvasGpu::GetWindow())) {
+    return false;
+  }
+
+  canvasContext->Rasterize();
+  GLsync fence = CanvasGpu::Flush();
+  glfw::SetCurrentWindowContext(gl->windowHandle);
+  glWaitSync(fence, 0, GL_TIMEOUT_IGNORED);
+  glDeleteSync(fence);
+
+  // with an unpack buffer bound the null pointer would be read as offset 0 into it
+  GLuint unpackBuffer = gl->HasBufferBinding(GL_PIXEL_UNPACK_BUFFER) ? gl->GetBufferBinding(GL_PIXEL_UNPACK_BUFFER) : 0;
+  if (unpackBuffer != 0) {
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+  }
+  glTexImage2D(GL_TEXTURE_2D, 0, internalformat, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+  if (unpackBuffer != 0) {
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, unpackBuffer);
+  }
+
+  GLint readFramebuffer, drawFramebuffer;
+  glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &readFramebuffer);
+  glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &drawFramebuffer);
+  GLboolean scissorTest = glIsEnabled(GL_SCISSOR_TEST);
+
+  GLuint framebuffers[2];
+  glGenFramebuffers(2, framebuffers);
+  glBindFramebuffer(GL_READ_FRAMEBUFFER, framebuffers[0]);
+  glFramebufferTexture2D(GL_READ_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, canvasTexture, 0);
+  glBindFramebuffer(GL_DRAW_FRAMEBUFFER, framebuffers[1]);
+  glFramebufferTexture2D(GL_DRAW_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, texture, 0);
+  if (scissorTest) {
+    glDisable(GL_SCISSOR_TEST);
+  }
+
+  // the canvas texture holds the top row first, as an upload of its pixels would
+  glBlitFramebuffer(0, 0, width, height, 0, flipY ? height : 0, width, flipY ? 0 : height, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+
+  if (scissorTest) {
+    glEnable(GL_SCISSOR_TEST);
+  }
+  glBindFramebuffer(GL_READ_FRAMEBUFFER, readFramebuffer);
+  glBindFramebuffer(GL_DRAW_FRAMEBUFFER, drawFramebuffer);
+  glDeleteFramebuffers(2, framebuffers);
+
+  return true;
+}
+
 NAN_METHOD(WebGLRenderingContext::TexImage2D) {
   Isolate *isolate = Isolate::GetCurrent();
 
@@ -2383,8 +2689,8 @@ NAN_METHOD(WebGLRenderingContext::TexImage2D) {
   Local<Value> pixels = info[8];
   Local<Value> srcOffset = info[9];
 
-  Local<String> widthString = String::NewFromUtf8(isolate, "width", NewStringType::kInternalized).ToLocalChecked();
-  Local<String> heightString = String::NewFromUtf8(isolate, "height", NewStringType::kInternalized).ToLocalChecked();
+  Local<String> widthString = keys::get(isolate, keys::width);
+  Local<String> heightString = keys::get(isolate, keys::height);
 
   if (info.Length() == 6) {
     // width is now format, height is now type, and border is now pixels
@@ -2493,6 +2799,33 @@ NAN_METHOD(WebGLRenderingContext::TexImage2D) {
 
   WebGLRenderingContext *gl = ObjectWrap::Unwrap<WebGLRenderingContext>(info.This());
 
+  GLuint texture = targetV == GL_TEXTURE_2D ? gl->GetTextureBinding(gl->activeTexture, targetV) : 0;
+  bool flipYV = canvas::ImageData::getFlip() && gl->flipY;
+  CanvasRenderingContext2D *canvasContext = (
+    levelV == 0 && texture != 0 &&
+    formatV == GL_RGBA && typeV == GL_UNSIGNED_BYTE && (internalformatV == GL_RGBA || internalformatV == GL_RGBA8)
+  ) ? getCanvasContext2D(pixels) : nullptr;
+  if (canvasContext && (widthV != (GLsizei)canvasContext->GetWidth() || heightV != (GLsizei)canvasContext->GetHeight())) {
+    canvasContext = nullptr;
+  }
+
+  if (levelV == 0 && targetV == GL_TEXTURE_2D) {
+    gl->mipmappedTextures.erase(texture);
+    gl->pendingCompressedTextures.erase(texture);
+    gl->compressedTextures.erase(texture);
+
+    if (canvasContext && texImageCanvasDirtyRect(gl, texture, canvasContext, pixels, widthV, heightV, internalformatV, flipYV)) {
+      return;
+    }
+    gl->canvasTextures.erase(texture);
+
+    if (canvasContext && texImageCanvasGpu(gl, texture, canvasContext, widthV, heightV, internalformatV, flipYV)) {
+      return;
+    }
+  } else if (texture != 0) {
+    gl->DecompressTexture(texture);
+  }
+
   char *pixelsV;
   if (pixels->IsNull()) {
     glTexImage2D(targetV, levelV, internalformatV, widthV, heightV, borderV, formatV, typeV, nullptr);
@@ -2500,6 +2833,38 @@ NAN_METHOD(WebGLRenderingContext::TexImage2D) {
     GLintptr offsetV = pixels->Uint32Value();
     glTexImage2D(targetV, levelV, internalformatV, widthV, heightV, borderV, formatV, typeV, (void *)offsetV);
   } else if ((pixelsV = (char *)getImageData(pixels)) != nullptr) {
+    if (
+      (gl->textureCompression || gl->texturePacking != TextureCompression::PACKING_NONE) &&
+      levelV == 0 && texture != 0 &&
+      formatV == GL_RGBA && typeV == GL_UNSIGNED_BYTE && (internalformatV == GL_RGBA || internalformatV == GL_RGBA8) &&
+      gl->framebufferTextures.find(texture) == gl->framebufferTextures.end() &&
+      gl->uncompressedTextures.find(texture) == gl->uncompressedTextures.end() &&
+      isStaticImage(pixels)
+    ) {
+      unsigned char *srcPixels = (unsigned char *)pixelsV;
+      unique_ptr<char[]> flippedBuffer;
+      if (canvas::ImageData::getFlip() && gl->flipY) {
+        flippedBuffer.reset(new char[widthV * heightV * 4]);
+        flipImageData(flippedBuffer.get(), pixelsV, widthV, heightV, 4);
+        srcPixels = (unsigned char *)flippedBuffer.get();
+      }
+
+      std::shared_ptr<TextureCompression::Upload> upload = TextureCompression::Encode(srcPixels, widthV, heightV, gl->textureCompression, gl->texturePacking);
+      if (upload) {
+        if (TextureCompression::IsReady(*upload)) {
+          TextureCompression::TexImage2D(targetV, *upload);
+          gl->mipmappedTextures.insert(texture);
+          gl->compressedTextures[texture] = upload;
+        } else {
+          // shown as it is until the encode finishes on the worker pool
+          TextureCompression::TexImage2DUncompressed(targetV, *upload);
+          gl->pendingCompressedTextures[texture] = upload;
+        }
+        glPixelStorei(GL_UNPACK_ALIGNMENT, gl->unpackAlignment);
+        return;
+      }
+    }
+
     size_t formatSize = getFormatSize(formatV);
     size_t typeSize = getTypeSize(typeV);
     size_t pixelSize = formatSize * typeSize;
@@ -2569,6 +2934,10 @@ NAN_METHOD(WebGLRenderingContext::TexImage2D) {
       glTexImage2D(targetV, levelV, internalformatV, widthV, heightV, borderV, formatV, typeV, pixelsV2);
     }
 
+    if (canvasContext) {
+      gl->canvasTextures[texture] = WebGLRenderingContext::CanvasTexture{canvasContext, canvasContext->TakeUploadDirtyRect(), widthV, heightV, internalformatV, flipYV};
+    }
+
     if (needsReformat) {
       glPixelStorei(GL_PACK_ALIGNMENT, gl->packAlignment);
       glPixelStorei(GL_UNPACK_ALIGNMENT, gl->unpackAlignment);
@@ -2611,11 +2980,71 @@ NAN_METHOD(WebGLRenderingContext::CompressedTexImage2D) {
     int borderV = border->Int32Value();
 
     glCompressedTexImage2D(targetV, levelV, internalformatV, widthV, heightV, borderV, dataLengthV, dataV);
+
+    WebGLRenderingContext *gl = ObjectWrap::Unwrap<WebGLRenderingContext>(info.This());
+    gl->ForgetCanvasTexture(targetV);
+    gl->ForgetCompressedTexture(targetV);
   } else {
     Nan::ThrowError("compressedTexImage2D: invalid arguments");
   }
 }
 
+NAN_METHOD(WebGLRenderingContext::TexImage2DFromContainer) {
+  if (info[0]->IsNumber() && (info[1]->IsArrayBuffer() || info[1]->IsArrayBufferView())) {
+    WebGLRenderingContext *gl = ObjectWrap::Unwrap<WebGLRenderingContext>(info.This());
+    GLenum targetV = info[0]->Uint32Value();
+
+    // uploads straight from the buffer the page fetched, so the file is never copied
+    const unsigned char *data;
+    size_t size;
+    if (info[1]->IsArrayBuffer()) {
+      Local<ArrayBuffer> arrayBuffer = Local<ArrayBuffer>::Cast(info[1]);
+      data = (const unsigned char *)arrayBuffer->GetContents().Data();
+      size = arrayBuffer->ByteLength();
+    } else {
+      Local<ArrayBufferView> arrayBufferView = Local<ArrayBufferView>::Cast(info[1]);
+      data = (const unsigned char *)arrayBufferView->Buffer()->GetContents().Data() + arrayBufferView->ByteOffset();
+      size = arrayBufferView->ByteLength();
+    }
+
+    GLint maxTextureSize = 0;
+    glGetIntegerv(targetV == GL_TEXTURE_CUBE_MAP ? GL_MAX_CUBE_MAP_TEXTURE_SIZE : GL_MAX_TEXTURE_SIZE, &maxTextureSize);
+
+    TextureContainer container;
+    std::string error;
+    if (!container.Parse(data, size, maxTextureSize, error)) {
+      return Nan::ThrowError(JS_STR(std::string("texImage2DFromContainer: ") + error));
+    }
+    if ((targetV == GL_TEXTURE_CUBE_MAP) != (container.numFaces == 6)) {
+      return Nan::ThrowError("texImage2DFromContainer: target does not match the number of faces");
+    }
+
+    container.Upload(targetV);
+    gl->ForgetCanvasTexture(targetV);
+    gl->ForgetCompressedTexture(targetV);
+    if (!container.compressed) {
+      glPixelStorei(GL_UNPACK_ALIGNMENT, gl->unpackAlignment);
+    }
+
+    GLuint texture = gl->GetTextureBinding(gl->activeTexture, targetV);
+    if ((container.levels.size() > 1 || (container.generateMipmaps && !container.compressed)) && texture != 0) {
+      gl->mipmappedTextures.insert(texture);
+    } else {
+      gl->mipmappedTextures.erase(texture);
+    }
+
+    Local<Object> result = Nan::New<Object>();
+    result->Set(JS_KEY(width), JS_INT(container.levels[0].width));
+    result->Set(JS_KEY(height), JS_INT(container.levels[0].height));
+    result->Set(JS_KEY(levels), JS_INT((uint32_t)container.levels.size()));
+    result->Set(JS_KEY(internalformat), JS_INT(container.internalFormat));
+    result->Set(JS_KEY(compressed), JS_BOOL(container.compressed));
+    info.GetReturnValue().Set(result);
+  } else {
+    Nan::ThrowError("texImage2DFromContainer: invalid arguments");
+  }
+}
+
 NAN_METHOD(WebGLRenderingContext::TexParameteri) {
   int target = info[0]->Int32Value();
   int pname = info[1]->Int32Value();
@@ -2646,7 +3075,7 @@ NAN_METHOD(WebGLRenderingContext::Clear) {
 
 
 NAN_METHOD(WebGLRenderingContext::UseProgram) {
-  GLint programId = info[0]->IsObject() ? info[0]->ToObject()->Get(JS_STR("id"))->Int32Value() : 0;
+  GLint programId = info[0]->IsObject() ? info[0]->ToObject()->Get(JS_KEY(id))->Int32Value() : 0;
   glUseProgram(programId);
 }
 
@@ -2655,7 +3084,7 @@ NAN_METHOD(WebGLRenderingContext::CreateBuffer) {
   glGenBuffers(1, &buffer);
 
   Local<Object> bufferObject = Nan::New<Object>();
-  bufferObject->Set(JS_STR("id"), JS_INT(buffer));
+  bufferObject->Set(JS_KEY(id), JS_INT(buffer));
   info.GetReturnValue().Set(bufferObject);
 }
 
@@ -2664,13 +3093,17 @@ NAN_METHOD(WebGLRenderingContext::BindBuffer) {
     Nan::ThrowError("BindBuffer requires at least 2 arguments");
   } else if (!info[0]->IsNumber()) {
     Nan::ThrowError("First argument to BindBuffer must be a number");
-  } else if (info[1]->IsObject() && info[1]->ToObject()->Get(JS_STR("id"))->IsNumber()) {
+  } else if (info[1]->IsObject() && info[1]->ToObject()->Get(JS_KEY(id))->IsNumber()) {
+    WebGLRenderingContext *gl = ObjectWrap::Unwrap<WebGLRenderingContext>(info.This());
     GLint target = info[0]->Int32Value();
-    GLint buffer = info[1]->ToObject()->Get(JS_STR("id"))->Int32Value();
+    GLint buffer = info[1]->ToObject()->Get(JS_KEY(id))->Int32Value();
     glBindBuffer(target, buffer);
+    gl->SetBufferBinding(target, buffer);
   } else if (info[1]->IsNull()) {
+    WebGLRenderingContext *gl = ObjectWrap::Unwrap<WebGLRenderingContext>(info.This());
     GLint target = info[0]->Int32Value();
     glBindBuffer(target, 0);
+    gl->SetBufferBinding(target, 0);
   } else {
     Nan::ThrowError(String::Concat(JS_STR("Second argument to BindBuffer must be null or a WebGLBuffer; was "), info[1]->ToString()));
   }
@@ -2682,7 +3115,7 @@ NAN_METHOD(WebGLRenderingContext::CreateFramebuffer) {
   glGenFramebuffers(1, &framebuffer);
 
   Local<Object> framebufferObject = Nan::New<Object>();
-  framebufferObject->Set(JS_STR("id"), JS_INT(framebuffer));
+  framebufferObject->Set(JS_KEY(id), JS_INT(framebuffer));
   info.GetReturnValue().Set(framebufferObject);
 }
 
@@ -2691,7 +3124,7 @@ NAN_METHOD(WebGLRenderingContext::BindFramebuffer) {
   WebGLRenderingContext *gl = ObjectWrap::Unwrap<WebGLRenderingContext>(info.This());
 
   GLenum target = info[0]->Uint32Value();
-  GLuint framebuffer = info[1]->IsObject() ? info[1]->ToObject()->Get(JS_STR("id"))->Uint32Value() : gl->defaultFramebuffer;
+  GLuint framebuffer = info[1]->IsObject() ? info[1]->ToObject()->Get(JS_KEY(id))->Uint32Value() : gl->defaultFramebuffer;
 
   glBindFramebuffer(target, framebuffer);
 
@@ -2703,11 +3136,20 @@ NAN_METHOD(WebGLRenderingContext::FramebufferTexture2D) {
   GLenum target = info[0]->Uint32Value();
   GLenum attachment = info[1]->Int32Value();
   GLenum textarget = info[2]->Int32Value();
-  GLuint texture = info[3]->IsObject() ? info[3]->ToObject()->Get(JS_STR("id"))->Uint32Value() : 0;
+  GLuint texture = info[3]->IsObject() ? info[3]->ToObject()->Get(JS_KEY(id))->Uint32Value() : 0;
   GLint level = info[4]->Int32Value();
 
+  WebGLRenderingContext *gl = ObjectWrap::Unwrap<WebGLRenderingContext>(info.This());
+  if (texture != 0) {
+    gl->DecompressTexture(texture);
+  }
+
   glFramebufferTexture2D(target, attachment, textarget, texture, level);
 
+  if (texture != 0) {
+    gl->framebufferTextures.insert(texture);
+  }
+
   // info.GetReturnValue().Set(Nan::Undefined());
 }
 
@@ -2735,7 +3177,40 @@ NAN_METHOD(WebGLRenderingContext::BlitFramebuffer) {
   // info.GetReturnValue().Set(Nan::Undefined());
 }
 
+NAN_METHOD(WebGLRenderingContext::InvalidateFramebuffer) {
+  WebGLRenderingContext *gl = ObjectWrap::Unwrap<WebGLRenderingContext>(info.This());
+
+  if (info[0]->IsNumber() && info[1]->IsArray()) {
+    GLenum target = info[0]->Uint32Value();
+    GLenum attachments[32];
+    size_t numAttachments = getInvalidateAttachments(gl, target, Local<Array>::Cast(info[1]), attachments, sizeof(attachments)/sizeof(attachments[0]));
+
+    invalidateFramebuffer(target, numAttachments, attachments);
+  } else {
+    Nan::ThrowError("invalidateFramebuffer: invalid arguments");
+  }
+}
+
+NAN_METHOD(WebGLRenderingContext::InvalidateSubFramebuffer) {
+  WebGLRenderingContext *gl = ObjectWrap::Unwrap<WebGLRenderingContext>(info.This());
+
+  if (info[0]->IsNumber() && info[1]->IsArray() && info[2]->IsNumber() && info[3]->IsNumber() && info[4]->IsNumber() && info[5]->IsNumber()) {
+    GLenum target = info[0]->Uint32Value();
+    GLenum attachments[32];
+    size_t numAttachments = getInvalidateAttachments(gl, target, Local<Array>::Cast(info[1]), attachments, sizeof(attachments)/sizeof(attachments[0]));
+    GLint x = info[2]->Int32Value();
+    GLint y = info[3]->Int32Value();
+    GLsizei width = info[4]->Int32Value();
+    GLsizei height = info[5]->Int32Value();
+
+    invalidateSubFramebuffer(target, numAttachments, attachments, x, y, width, height);
+  } else {
+    Nan::ThrowError("invalidateSubFramebuffer: invalid arguments");
+  }
+}
+
 NAN_METHOD(WebGLRenderingContext::BufferData) {
+  WebGLRenderingContext *gl = ObjectWrap::Unwrap<WebGLRenderingContext>(info.This());
   GLenum target = info[0]->Uint32Value();
   Local<Object> obj = Local<Object>::Cast(info[1]);
 
@@ -2769,10 +3244,18 @@ NAN_METHOD(WebGLRenderingContext::BufferData) {
   }
 
   glBufferData(target, size, data, usage);
+
+  if (gl->HasBufferBinding(target)) {
+    GLuint buffer = gl->GetBufferBinding(target);
+    if (buffer != 0) {
+      gl->bufferUsages[buffer] = usage;
+    }
+  }
 }
 
 
 NAN_METHOD(WebGLRenderingContext::BufferSubData) {
+  WebGLRenderingContext *gl = ObjectWrap::Unwrap<WebGLRenderingContext>(info.This());
   GLenum target = info[0]->Uint32Value();
   GLint dstOffset = info[1]->Int32Value();
   Local<Object> obj = Local<Object>::Cast(info[2]);
@@ -2799,6 +3282,19 @@ NAN_METHOD(WebGLRenderingContext::BufferSubData) {
     return;
   }
 
+  // stream dynamic buffers through the ring so we never wait on draws still reading them
+  if (gl->HasBufferBinding(target)) {
+    GLuint buffer = gl->GetBufferBinding(target);
+    auto iter = gl->bufferUsages.find(buffer);
+    if (buffer != 0 && iter != gl->bufferUsages.end() && (iter->second == GL_DYNAMIC_DRAW || iter->second == GL_STREAM_DRAW)) {
+      bool streamed = gl->streamingBuffer.Upload(target, dstOffset, data, size);
+      glBindBuffer(GL_COPY_READ_BUFFER, gl->HasBufferBinding(GL_COPY_READ_BUFFER) ? gl->GetBufferBinding(GL_COPY_READ_BUFFER) : 0);
+      if (streamed) {
+        return;
+      }
+    }
+  }
+
   glBufferSubData(target, dstOffset, size, data);
 }
 
@@ -3182,8 +3678,18 @@ NAN_METHOD(WebGLRenderingContext::CopyTexImage2D) {
   GLsizei height = info[6]->Uint32Value();
   GLint border = info[7]->Int32Value();
 
+  WebGLRenderingContext *gl = ObjectWrap::Unwrap<WebGLRenderingContext>(info.This());
+  if (level != 0 && target == GL_TEXTURE_2D && gl->GetTextureBinding(gl->activeTexture, target) != 0) {
+    gl->DecompressTexture(gl->GetTextureBinding(gl->activeTexture, target));
+  }
+
   glCopyTexImage2D(target, level, internalformat, x, y, width, height, border);
 
+  gl->ForgetCanvasTexture(target);
+  if (level == 0) {
+    gl->ForgetCompressedTexture(target);
+  }
+
   // info.GetReturnValue().Set(Nan::Undefined());
 }
 
@@ -3197,8 +3703,15 @@ NAN_METHOD(WebGLRenderingContext::CopyTexSubImage2D) {
   GLsizei width = info[6]->Uint32Value();
   GLsizei height = info[7]->Uint32Value();
 
+  WebGLRenderingContext *gl = ObjectWrap::Unwrap<WebGLRenderingContext>(info.This());
+  if (target == GL_TEXTURE_2D && gl->GetTextureBinding(gl->activeTexture, target) != 0) {
+    gl->DecompressTexture(gl->GetTextureBinding(gl->activeTexture, target));
+  }
+
   glCopyTexSubImage2D(target, level, xoffset, yoffset, x, y, width, height);
 
+  gl->ForgetCanvasTexture(target);
+
   // info.GetReturnValue().Set(Nan::Undefined());
 }
 
@@ -3349,7 +3862,7 @@ NAN_METHOD(WebGLRenderingContext::BindRenderbuffer) {
   WebGLRenderingContext *gl = ObjectWrap::Unwrap<WebGLRenderingContext>(info.This());
 
   GLenum target = info[0]->Int32Value();
-  GLuint renderbuffer = info[1]->IsObject() ? info[1]->ToObject()->Get(JS_STR("id"))->Uint32Value() : 0;
+  GLuint renderbuffer = info[1]->IsObject() ? info[1]->ToObject()->Get(JS_KEY(id))->Uint32Value() : 0;
 
   glBindRenderbuffer(target, renderbuffer);
 
@@ -3363,20 +3876,28 @@ NAN_METHOD(WebGLRenderingContext::CreateRenderbuffer) {
   glGenRenderbuffers(1, &renderbuffer);
 
   Local<Object> renderbufferObject = Nan::New<Object>();
-  renderbufferObject->Set(JS_STR("id"), JS_INT(renderbuffer));
+  renderbufferObject->Set(JS_KEY(id), JS_INT(renderbuffer));
   info.GetReturnValue().Set(renderbufferObject);
 }
 
 NAN_METHOD(WebGLRenderingContext::DeleteBuffer) {
-  GLuint buffer = info[0]->IsObject() ? info[0]->ToObject()->Get(JS_STR("id"))->Uint32Value() : 0;
+  WebGLRenderingContext *gl = ObjectWrap::Unwrap<WebGLRenderingContext>(info.This());
+  GLuint buffer = info[0]->IsObject() ? info[0]->ToObject()->Get(JS_KEY(id))->Uint32Value() : 0;
 
   glDeleteBuffers(1, &buffer);
 
+  gl->bufferUsages.erase(buffer);
+  for (auto iter = gl->bufferBindings.begin(); iter != gl->bufferBindings.end(); iter++) {
+    if (iter->second == buffer) {
+      iter->second = 0;
+    }
+  }
+
   // info.GetReturnValue().Set(Nan::Undefined());
 }
 
 NAN_METHOD(WebGLRenderingContext::DeleteFramebuffer) {
-  GLuint framebuffer = info[0]->IsObject() ? info[0]->ToObject()->Get(JS_STR("id"))->Uint32Value() : 0;
+  GLuint framebuffer = info[0]->IsObject() ? info[0]->ToObject()->Get(JS_KEY(id))->Uint32Value() : 0;
 
   glDeleteFramebuffers(1, &framebuffer);
 
@@ -3384,13 +3905,13 @@ NAN_METHOD(WebGLRenderingContext::DeleteFramebuffer) {
 }
 
 NAN_METHOD(WebGLRenderingContext::DeleteProgram) {
-  GLint programId = info[0]->IsObject() ? info[0]->ToObject()->Get(JS_STR("id"))->Int32Value() : 0;
+  GLint programId = info[0]->IsObject() ? info[0]->ToObject()->Get(JS_KEY(id))->Int32Value() : 0;
 
   glDeleteProgram(programId);
 }
 
 NAN_METHOD(WebGLRenderingContext::DeleteRenderbuffer) {
-  GLuint renderbuffer = info[0]->IsObject() ? info[0]->ToObject()->Get(JS_STR("id"))->Uint32Value() : 0;
+  GLuint renderbuffer = info[0]->IsObject() ? info[0]->ToObject()->Get(JS_KEY(id))->Uint32Value() : 0;
 
   glDeleteRenderbuffers(1, &renderbuffer);
 
@@ -3398,7 +3919,7 @@ NAN_METHOD(WebGLRenderingContext::DeleteRenderbuffer) {
 }
 
 NAN_METHOD(WebGLRenderingContext::DeleteShader) {
-  GLuint shaderId = info[0]->IsObject() ? info[0]->ToObject()->Get(JS_STR("id"))->Uint32Value() : 0;
+  GLuint shaderId = info[0]->IsObject() ? info[0]->ToObject()->Get(JS_KEY(id))->Uint32Value() : 0;
 
   glDeleteShader(shaderId);
 
@@ -3406,16 +3927,24 @@ NAN_METHOD(WebGLRenderingContext::DeleteShader) {
 }
 
 NAN_METHOD(WebGLRenderingContext::DeleteTexture) {
-  GLuint texture = info[0]->IsObject() ? info[0]->ToObject()->Get(JS_STR("id"))->Uint32Value() : 0;
+  WebGLRenderingContext *gl = ObjectWrap::Unwrap<WebGLRenderingContext>(info.This());
+  GLuint texture = info[0]->IsObject() ? info[0]->ToObject()->Get(JS_KEY(id))->Uint32Value() : 0;
 
   glDeleteTextures(1, &texture);
 
+  gl->mipmappedTextures.erase(texture);
+  gl->canvasTextures.erase(texture);
+  gl->framebufferTextures.erase(texture);
+  gl->pendingCompressedTextures.erase(texture);
+  gl->compressedTextures.erase(texture);
+  gl->uncompressedTextures.erase(texture);
+
   // info.GetReturnValue().Set(Nan::Undefined());
 }
 
 NAN_METHOD(WebGLRenderingContext::DetachShader) {
-  GLuint programId = info[0]->ToObject()->Get(JS_STR("id"))->Uint32Value();
-  GLuint shaderId = info[1]->ToObject()->Get(JS_STR("id"))->Uint32Value();
+  GLuint programId = info[0]->ToObject()->Get(JS_KEY(id))->Uint32Value();
+  GLuint shaderId = info[1]->ToObject()->Get(JS_KEY(id))->Uint32Value();
 
   glDetachShader(programId, shaderId);
 }
@@ -3424,7 +3953,7 @@ NAN_METHOD(WebGLRenderingContext::FramebufferRenderbuffer) {
   GLenum target = info[0]->Int32Value();
   GLenum attachment = info[1]->Int32Value();
   GLenum renderbuffertarget = info[2]->Int32Value();
-  GLuint renderbuffer = info[3]->IsObject() ? info[3]->ToObject()->Get(JS_STR("id"))->Uint32Value() : 0;
+  GLuint renderbuffer = info[3]->IsObject() ? info[3]->ToObject()->Get(JS_KEY(id))->Uint32Value() : 0;
 
   glFramebufferRenderbuffer(target, attachment, renderbuffertarget, renderbuffer);
 
@@ -3458,7 +3987,7 @@ NAN_METHOD(WebGLRenderingContext::GetShaderPrecisionFormat) {
 
 NAN_METHOD(WebGLRenderingContext::IsBuffer) {
   if (info[0]->IsObject()) {
-    GLuint arg = info[0]->IsObject() ? info[0]->ToObject()->Get(JS_STR("id"))->Uint32Value() : 0;
+    GLuint arg = info[0]->IsObject() ? info[0]->ToObject()->Get(JS_KEY(id))->Uint32Value() : 0;
     bool ret = glIsBuffer(arg);
 
     info.GetReturnValue().Set(Nan::New<Boolean>(ret));
@@ -3469,7 +3998,7 @@ NAN_METHOD(WebGLRenderingContext::IsBuffer) {
 
 NAN_METHOD(WebGLRenderingContext::IsFramebuffer) {
   if (info[0]->IsObject()) {
-    GLuint arg = info[0]->IsObject() ? info[0]->ToObject()->Get(JS_STR("id"))->Uint32Value() : 0;
+    GLuint arg = info[0]->IsObject() ? info[0]->ToObject()->Get(JS_KEY(id))->Uint32Value() : 0;
     bool ret = glIsFramebuffer(arg);
 
     info.GetReturnValue().Set(JS_BOOL(ret));
@@ -3480,7 +4009,7 @@ NAN_METHOD(WebGLRenderingContext::IsFramebuffer) {
 
 NAN_METHOD(WebGLRenderingContext::IsProgram) {
   if (info[0]->IsObject()) {
-    GLuint arg = info[0]->IsObject() ? info[0]->ToObject()->Get(JS_STR("id"))->Uint32Value() : 0;
+    GLuint arg = info[0]->IsObject() ? info[0]->ToObject()->Get(JS_KEY(id))->Uint32Value() : 0;
     bool ret = glIsProgram(arg);
 
     info.GetReturnValue().Set(JS_BOOL(ret));
@@ -3491,7 +4020,7 @@ NAN_METHOD(WebGLRenderingContext::IsProgram) {
 
 NAN_METHOD(WebGLRenderingContext::IsRenderbuffer) {
   if (info[0]->IsObject()) {
-    GLuint arg = info[0]->IsObject() ? info[0]->ToObject()->Get(JS_STR("id"))->Uint32Value() : 0;
+    GLuint arg = info[0]->IsObject() ? info[0]->ToObject()->Get(JS_KEY(id))->Uint32Value() : 0;
     bool ret = glIsRenderbuffer(arg);
 
     info.GetReturnValue().Set(JS_BOOL(ret));
@@ -3502,7 +4031,7 @@ NAN_METHOD(WebGLRenderingContext::IsRenderbuffer) {
 
 NAN_METHOD(WebGLRenderingContext::IsShader) {
   if (info[0]->IsObject()) {
-    GLuint arg = info[0]->IsObject() ? info[0]->ToObject()->Get(JS_STR("id"))->Uint32Value() : 0;
+    GLuint arg = info[0]->IsObject() ? info[0]->ToObject()->Get(JS_KEY(id))->Uint32Value() : 0;
     bool ret = glIsShader(arg);
 
     info.GetReturnValue().Set(JS_BOOL(ret));
@@ -3513,7 +4042,7 @@ NAN_METHOD(WebGLRenderingContext::IsShader) {
 
 NAN_METHOD(WebGLRenderingContext::IsTexture) {
   if (info[0]->IsObject()) {
-    GLuint arg = info[0]->IsObject() ? info[0]->ToObject()->Get(JS_STR("id"))->Uint32Value() : 0;
+    GLuint arg = info[0]->IsObject() ? info[0]->ToObject()->Get(JS_KEY(id))->Uint32Value() : 0;
     bool ret = glIsTexture(arg);
 
     info.GetReturnValue().Set(JS_BOOL(ret));
@@ -3524,7 +4053,7 @@ NAN_METHOD(WebGLRenderingContext::IsTexture) {
 
 NAN_METHOD(WebGLRenderingContext::IsVertexArray) {
   if (info[0]->IsObject()) {
-    GLuint arg = info[0]->IsObject() ? info[0]->ToObject()->Get(JS_STR("id"))->Uint32Value() : 0;
+    GLuint arg = info[0]->IsObject() ? info[0]->ToObject()->Get(JS_KEY(id))->Uint32Value() : 0;
     bool ret = glIsVertexArray(arg);
 
     info.GetReturnValue().Set(JS_BOOL(ret));
@@ -3535,7 +4064,7 @@ NAN_METHOD(WebGLRenderingContext::IsVertexArray) {
 
 NAN_METHOD(WebGLRenderingContext::IsSync) {
   if (info[0]->IsObject()) {
-    Local<Value> syncId = info[0]->ToObject()->Get(JS_STR("id"));
+    Local<Value> syncId = info[0]->ToObject()->Get(JS_KEY(id));
     if (syncId->IsArray()) {
       Local<Array> syncArray = Local<Array>::Cast(syncId);
       if (syncArray->Get(0)->IsNumber() && syncArray->Get(1)->IsNumber()) {
@@ -3566,7 +4095,7 @@ NAN_METHOD(WebGLRenderingContext::RenderbufferStorage) {
 }
 
 NAN_METHOD(WebGLRenderingContext::GetShaderSource) {
-  GLuint shaderId = info[0]->ToObject()->Get(JS_STR("id"))->Uint32Value();
+  GLuint shaderId = info[0]->ToObject()->Get(JS_KEY(id))->Uint32Value();
 
   GLint len;
   glGetShaderiv(shaderId, GL_SHADER_SOURCE_LENGTH, &len);
@@ -3581,7 +4110,7 @@ NAN_METHOD(WebGLRenderingContext::GetShaderSource) {
 }
 
 NAN_METHOD(WebGLRenderingContext::ValidateProgram) {
-  GLuint programId = info[0]->ToObject()->Get(JS_STR("id"))->Uint32Value();
+  GLuint programId = info[0]->ToObject()->Get(JS_KEY(id))->Uint32Value();
 
   glValidateProgram(programId);
 }
@@ -3599,6 +4128,14 @@ NAN_METHOD(WebGLRenderingContext::TexSubImage2D) {
   Local<Value> pixels = info[8];
   Local<Value> srcOffset = info[9];
 
+  gl->ForgetCanvasTexture(targetV);
+  if (targetV == GL_TEXTURE_2D) {
+    GLuint texture = gl->GetTextureBinding(gl->activeTexture, targetV);
+    if (texture != 0) {
+      gl->DecompressTexture(texture);
+    }
+  }
+
   if (pixels->IsArrayBufferView() && srcOffset->IsNumber()) {
     Local<ArrayBufferView> arrayBufferView = Local<ArrayBufferView>::Cast(pixels);
     size_t srcOffsetInt = srcOffset->Uint32Value();
@@ -3656,6 +4193,9 @@ NAN_METHOD(WebGLRenderingContext::TexStorage2D) {
   GLsizei height = info[4]->Uint32Value();
 
   glTexStorage2D(target, levels, internalFormat, width, height);
+
+  gl->ForgetCanvasTexture(target);
+  gl->ForgetCompressedTexture(target);
 }
 
 NAN_METHOD(WebGLRenderingContext::ReadPixels) {
@@ -3687,7 +4227,7 @@ NAN_METHOD(WebGLRenderingContext::GetTexParameter) {
 }
 
 NAN_METHOD(WebGLRenderingContext::GetActiveAttrib) {
-  GLint programId = info[0]->ToObject()->Get(JS_STR("id"))->Int32Value();
+  GLint programId = info[0]->ToObject()->Get(JS_KEY(id))->Int32Value();
   GLuint index = info[1]->Int32Value();
 
   char name[1024];
@@ -3700,8 +4240,8 @@ NAN_METHOD(WebGLRenderingContext::GetActiveAttrib) {
   if (length > 0) {
     Local<Object> activeInfo = Nan::New<Object>();
     activeInfo->Set(JS_STR("size"), JS_INT(size));
-    activeInfo->Set(JS_STR("type"), JS_INT((int)type));
-    activeInfo->Set(JS_STR("name"), JS_STR(name, length));
+    activeInfo->Set(JS_KEY(type), JS_INT((int)type));
+    activeInfo->Set(JS_KEY(name), JS_STR(name, length));
 
     info.GetReturnValue().Set(activeInfo);
   } else {
@@ -3710,7 +4250,7 @@ NAN_METHOD(WebGLRenderingContext::GetActiveAttrib) {
 }
 
 NAN_METHOD(WebGLRenderingContext::GetActiveUniform) {
-  GLint programId = info[0]->ToObject()->Get(JS_STR("id"))->Int32Value();
+  GLint programId = info[0]->ToObject()->Get(JS_KEY(id))->Int32Value();
   GLuint index = info[1]->Int32Value();
 
   char name[1024];
@@ -3723,8 +4263,8 @@ NAN_METHOD(WebGLRenderingContext::GetActiveUniform) {
   if (length > 0) {
     Local<Object> activeInfo = Nan::New<Object>();
     activeInfo->Set(JS_STR("size"), JS_INT(size));
-    activeInfo->Set(JS_STR("type"), JS_INT((int)type));
-    activeInfo->Set(JS_STR("name"), JS_STR(name, length));
+    activeInfo->Set(JS_KEY(type), JS_INT((int)type));
+    activeInfo->Set(JS_KEY(name), JS_STR(name, length));
 
     info.GetReturnValue().Set(activeInfo);
   } else {
@@ -3733,7 +4273,7 @@ NAN_METHOD(WebGLRenderingContext::GetActiveUniform) {
 }
 
 NAN_METHOD(WebGLRenderingContext::GetAttachedShaders) {
-  GLuint programId = info[0]->ToObject()->Get(JS_STR("id"))->Uint32Value();
+  GLuint programId = info[0]->ToObject()->Get(JS_KEY(id))->Uint32Value();
   GLuint shaders[1024];
   GLsizei count;
 
@@ -3742,7 +4282,7 @@ NAN_METHOD(WebGLRenderingContext::GetAttachedShaders) {
   Local<Array> shadersArr = Nan::New<Array>(count);
   for(int i = 0; i < count; i++) {
     Local<Object> shaderObject = Nan::New<Object>();
-    shaderObject->Set(JS_STR("id"), JS_INT(shaders[i]));
+    shaderObject->Set(JS_KEY(id), JS_INT(shaders[i]));
     shadersArr->Set(i, shaderObject);
   }
 
@@ -3857,8 +4397,8 @@ NAN_METHOD(WebGLRenderingContext::GetParameter) {
     }
     case GL_VERSION:
     {
-      Local<Value> constructorName = info.This()->Get(JS_STR("constructor"))->ToObject()->Get(JS_STR("name"));
-      if (constructorName->StrictEquals(JS_STR("WebGL2RenderingContext"))) {
+      Local<Value> constructorName = info.This()->Get(JS_KEY(constructor))->ToObject()->Get(JS_KEY(name));
+      if (constructorName->StrictEquals(JS_KEY(WebGL2RenderingContext))) {
         info.GetReturnValue().Set(JS_STR("WebGL 2"));
       } else {
         info.GetReturnValue().Set(JS_STR("WebGL 1"));
@@ -3951,7 +4491,7 @@ NAN_METHOD(WebGLRenderingContext::GetParameter) {
 
       if (param != 0) {
         Local<Object> object = Nan::New<Object>();
-        object->Set(JS_STR("id"), JS_INT(param));
+        object->Set(JS_KEY(id), JS_INT(param));
         info.GetReturnValue().Set(object);
       } else {
         info.GetReturnValue().Set(Nan::Null());
@@ -4025,7 +4565,7 @@ NAN_METHOD(WebGLRenderingContext::GetFramebufferAttachmentParameter) {
 }
 
 NAN_METHOD(WebGLRenderingContext::GetProgramInfoLog) {
-  GLuint program = info[0]->ToObject()->Get(JS_STR("id"))->Uint32Value();
+  GLuint program = info[0]->ToObject()->Get(JS_KEY(id))->Uint32Value();
   char Error[1024];
   int Len;
 
@@ -4045,8 +4585,8 @@ NAN_METHOD(WebGLRenderingContext::GetRenderbufferParameter) {
 }
 
 NAN_METHOD(WebGLRenderingContext::GetUniform) {
-  GLuint program = info[0]->ToObject()->Get(JS_STR("id"))->Uint32Value();
-  GLuint location = info[1]->ToObject()->Get(JS_STR("id"))->Uint32Value();
+  GLuint program = info[0]->ToObject()->Get(JS_KEY(id))->Uint32Value();
+  GLuint location = info[1]->ToObject()->Get(JS_KEY(id))->Uint32Value();
 
   char name[1024];
   GLsizei length = 0;
@@ -4372,12 +4912,12 @@ NAN_METHOD(WebGLRenderingContext::CreateVertexArray) {
   glGenVertexArrays(1, &vao);
 
   Local<Object> vaoObject = Nan::New<Object>();
-  vaoObject->Set(JS_STR("id"), JS_INT(vao));
+  vaoObject->Set(JS_KEY(id), JS_INT(vao));
   info.GetReturnValue().Set(vaoObject);
 }
 
 NAN_METHOD(WebGLRenderingContext::DeleteVertexArray) {
-  GLuint vao = info[0]->IsObject() ? info[0]->ToObject()->Get(JS_STR("id"))->Uint32Value() : 0;
+  GLuint vao = info[0]->IsObject() ? info[0]->ToObject()->Get(JS_KEY(id))->Uint32Value() : 0;
 
   glDeleteVertexArrays(1, &vao);
 
@@ -4386,9 +4926,12 @@ NAN_METHOD(WebGLRenderingContext::DeleteVertexArray) {
 
 NAN_METHOD(WebGLRenderingContext::BindVertexArray) {
   WebGLRenderingContext *gl = ObjectWrap::Unwrap<WebGLRenderingContext>(info.This());
-  GLuint vao = info[0]->IsObject() ? info[0]->ToObject()->Get(JS_STR("id"))->Uint32Value() : gl->defaultVao;
+  GLuint vao = info[0]->IsObject() ? info[0]->ToObject()->Get(JS_KEY(id))->Uint32Value() : gl->defaultVao;
 
   glBindVertexArray(vao);
+
+  // the element array binding is vertex array state
+  gl->bufferBindings.erase(GL_ELEMENT_ARRAY_BUFFER);
 }
 
 NAN_METHOD(WebGLRenderingContext::FenceSync) {
@@ -4399,19 +4942,19 @@ NAN_METHOD(WebGLRenderingContext::FenceSync) {
   Local<Array> syncArray = pointerToArray(sync);
 
   Local<Object> syncObject = Nan::New<Object>();
-  syncObject->Set(JS_STR("id"), syncArray);
+  syncObject->Set(JS_KEY(id), syncArray);
   info.GetReturnValue().Set(syncObject);
 }
 
 NAN_METHOD(WebGLRenderingContext::DeleteSync) {
-  Local<Array> syncArray = Local<Array>::Cast(info[0]->ToObject()->Get(JS_STR("id")));
+  Local<Array> syncArray = Local<Array>::Cast(info[0]->ToObject()->Get(JS_KEY(id)));
   GLsync sync = (GLsync)arrayToPointer(syncArray);
 
   glDeleteSync(sync);
 }
 
 NAN_METHOD(WebGLRenderingContext::ClientWaitSync) {
-  Local<Array> syncArray = Local<Array>::Cast(info[0]->ToObject()->Get(JS_STR("id")));
+  Local<Array> syncArray = Local<Array>::Cast(info[0]->ToObject()->Get(JS_KEY(id)));
   GLsync sync = (GLsync)arrayToPointer(syncArray);
   GLbitfield flags = info[1]->Uint32Value();
   double timeoutValue = info[2]->NumberValue();
@@ -4423,7 +4966,7 @@ NAN_METHOD(WebGLRenderingContext::ClientWaitSync) {
 }
 
 NAN_METHOD(WebGLRenderingContext::WaitSync) {
-  Local<Array> syncArray = Local<Array>::Cast(info[0]->ToObject()->Get(JS_STR("id")));
+  Local<Array> syncArray = Local<Array>::Cast(info[0]->ToObject()->Get(JS_KEY(id)));
   GLsync sync = (GLsync)arrayToPointer(syncArray);
   GLbitfield flags = info[1]->Uint32Value();
   double timeoutValue = info[2]->NumberValue();
@@ -4433,7 +4976,7 @@ NAN_METHOD(WebGLRenderingContext::WaitSync) {
 }
 
 NAN_METHOD(WebGLRenderingContext::GetSyncParameter) {
-  Local<Array> syncArray = Local<Array>::Cast(info[0]->ToObject()->Get(JS_STR("id")));
+  Local<Array> syncArray = Local<Array>::Cast(info[0]->ToObject()->Get(JS_KEY(id)));
   GLsync sync = (GLsync)arrayToPointer(syncArray);
   GLbitfield pname = info[1]->Uint32Value();
 
@@ -1,6 +1,7 @@
 #ifndef _OPENVR_IVRCOMPOSITOR_H_
 #define _OPENVR_IVRCOMPOSITOR_H_
 
+#include <memory>
 #include <nan/nan.h>
 #include <v8.h>
 
@@ -13,9 +14,28 @@ namespace vr
 class IVRCompositor;
 }
 
+class SubmitThread;
+
 class IVRCompositor : public Nan::ObjectWrap
 {
 public:
+  // WaitGetFrame layout, in floats. The pose block is position (3), orientation (4) and a valid flag; each eye
+  // block is view matrix (16), projection matrix (16), offset (3), unused, then fov left/right/top/bottom in
+  // degrees (4); each controller block is the GetControllerState layout (21) then position (3) and orientation (4).
+  static constexpr size_t FRAME_POSE = 0;
+  static constexpr size_t FRAME_EYE_SIZE = 40;
+  static constexpr size_t FRAME_LEFT_EYE = 8;
+  static constexpr size_t FRAME_RIGHT_EYE = FRAME_LEFT_EYE + FRAME_EYE_SIZE;
+  static constexpr size_t FRAME_CONTROLLER_SIZE = 28;
+  static constexpr size_t FRAME_LEFT_CONTROLLER = FRAME_RIGHT_EYE + FRAME_EYE_SIZE;
+  static constexpr size_t FRAME_RIGHT_CONTROLLER = FRAME_LEFT_CONTROLLER + FRAME_CONTROLLER_SIZE;
+  static constexpr size_t FRAME_SIZE = FRAME_RIGHT_CONTROLLER + FRAME_CONTROLLER_SIZE;
+
+  // GetFrameTimings layout, in doubles per frame: frame index, presents, mispresents, dropped frames,
+  // reprojection flags, system time in seconds, then total render gpu, compositor gpu, compositor cpu and
+  // client frame interval in milliseconds.
+  static constexpr size_t FRAME_TIMING_SIZE = 10;
+
   static NAN_MODULE_INIT(Init);
 
   // Static factory construction method for other node addons to use.
@@ -23,13 +43,25 @@ public:
 
 private:
   explicit IVRCompositor(vr::IVRCompositor *self);
-  ~IVRCompositor() = default;
+  ~IVRCompositor();
 
   // Node construction method for new instances.
   static NAN_METHOD(New);
 
   static NAN_METHOD(WaitGetPoses);
+  static NAN_METHOD(WaitGetFrame);
   static NAN_METHOD(Submit);
+  static NAN_METHOD(StartSubmitThread);
+  static NAN_METHOD(StopSubmitThread);
+
+  /// virtual bool GetFrameTiming( Compositor_FrameTiming *pTiming, uint32_t unFramesAgo = 0 ) = 0;
+  static NAN_METHOD(GetFrameTiming);
+
+  /// virtual uint32_t GetFrameTimings( Compositor_FrameTiming *pTiming, uint32_t nFrames ) = 0;
+  static NAN_METHOD(GetFrameTimings);
+
+  /// virtual void GetCumulativeStats( Compositor_CumulativeStats *pStats, uint32_t nStatsSizeInBytes ) = 0;
+  static NAN_METHOD(GetCumulativeStats);
 
   /// Create a singleton reference to a constructor function.
   static inline Nan::Persistent<v8::Function>& constructor()
@@ -40,6 +72,22 @@ private:
 
   /// Reference to wrapped OpenVR instance.
   vr::IVRCompositor * const self_;
+
+  /// While running, WaitGetPoses, WaitGetFrame and Submit go through the submit thread.
+  std::unique_ptr<SubmitThread> submitThread;
+
+  /// HMD pose the current frame is rendered with, sampled by WaitGetFrame after the wait rather than taken from
+  /// WaitGetPoses, and submitted alongside the frame so the compositor reprojects from the pose actually used.
+  bool hasRenderPose;
+  float renderPose[12];
+
+  /// Per-eye values that only change with the IPD or the clip planes, cached for WaitGetFrame.
+  bool eyesCached;
+  float cachedIpd;
+  float cachedDepthNear;
+  float cachedDepthFar;
+  float eyeToHead[2][12];
+  float eyeFrames[2][IVRCompositor::FRAME_EYE_SIZE];
 };
 
 NAN_METHOD(NewCompositor);
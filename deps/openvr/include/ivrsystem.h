@@ -9,11 +9,14 @@
 namespace vr
 {
 class IVRSystem;
+struct TrackedDevicePose_t;
 }
 
 class IVRSystem : public Nan::ObjectWrap
 {
 public:
+  static constexpr size_t CONTROLLER_STATE_SIZE = 21;
+
   static NAN_MODULE_INIT(Init);
 
   // Static factory construction method for other node addons to use.
@@ -88,6 +91,7 @@ private:
   /// virtual bool IsTrackedDeviceConnected( vr::TrackedDeviceIndex_t unDeviceIndex ) = 0;
   /// virtual bool GetBoolTrackedDeviceProperty( vr::TrackedDeviceIndex_t unDeviceIndex, ETrackedDeviceProperty prop, ETrackedPropertyError *pError = 0L ) = 0;
   /// virtual float GetFloatTrackedDeviceProperty( vr::TrackedDeviceIndex_t unDeviceIndex, ETrackedDeviceProperty prop, ETrackedPropertyError *pError = 0L ) = 0;
+  static NAN_METHOD(GetFloatTrackedDeviceProperty);
   /// virtual int32_t GetInt32TrackedDeviceProperty( vr::TrackedDeviceIndex_t unDeviceIndex, ETrackedDeviceProperty prop, ETrackedPropertyError *pError = 0L ) = 0;
   /// virtual uint64_t GetUint64TrackedDeviceProperty( vr::TrackedDeviceIndex_t unDeviceIndex, ETrackedDeviceProperty prop, ETrackedPropertyError *pError = 0L ) = 0;
   /// virtual HmdMatrix34_t GetMatrix34TrackedDeviceProperty( vr::TrackedDeviceIndex_t unDeviceIndex, ETrackedDeviceProperty prop, ETrackedPropertyError *pError = 0L ) = 0;
@@ -129,6 +133,13 @@ private:
     return the_constructor;
   }
 
+  /// Writes the controller's state as [1, 5 pressed, 5 touched, 10 axes]; returns false if it has none.
+  bool WriteControllerState(uint32_t index, float *buttons);
+
+  /// Writes the HMD and controller poses as column-major 4x4 matrices into 16-float outputs; the first
+  /// element of an output is NaN if its device has no valid pose.
+  void WritePoses(const vr::TrackedDevicePose_t *poses, uint32_t numPoses, float *hmd, float *leftController, float *rightController);
+
   /// Reference to wrapped OpenVR instance.
   vr::IVRSystem * const self_;
 
@@ -0,0 +1,94 @@
+#ifndef _OPENVR_NULL_RUNTIME_H_
+#define _OPENVR_NULL_RUNTIME_H_
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <openvr.h>
+
+struct GLFWwindow;
+
+/// Serializes calls into OpenVR. With a submit thread the compositor waits and submits there while the JS thread
+/// reads timings and device state, and the OpenVR interfaces may not be called from two threads at once.
+std::mutex &GetVrMutex();
+
+/// Calls the wrapped OpenVR interface, or the null runtime when the wrapper was created without one, holding the
+/// OpenVR mutex until the end of the full expression.
+#define VR_CALL(self, method, ...) (std::lock_guard<std::mutex>(GetVrMutex()), (self) ? (self)->method(__VA_ARGS__) : NullRuntime::Get().method(__VA_ARGS__))
+
+/// Simulated stand-in for the OpenVR system and compositor, for running the VR frame loop without a headset
+/// or SteamVR (CI, benchmarks). The headset and both controllers follow a fixed script driven by the frame
+/// counter, WaitGetPoses blocks until the next simulated vsync, and submitted eye textures are copied into an
+/// offscreen mirror texture. Only the subset of the interfaces the bindings use is provided. The compositor
+/// methods may run on a submit thread while the JS thread reads timings and controller state.
+class NullRuntime
+{
+public:
+  static constexpr float FRAME_RATE = 90;
+  static constexpr uint32_t RENDER_WIDTH = 1512;
+  static constexpr uint32_t RENDER_HEIGHT = 1680;
+  static constexpr float IPD = 0.064f;
+  static constexpr float VSYNC_TO_PHOTONS = 0.011f;
+  static constexpr uint32_t NUM_FRAME_TIMINGS = 32;
+
+  static NullRuntime &Get();
+  static bool IsEnabled();
+  static void SetEnabled(bool enabled);
+
+  void Reset();
+
+  /// IVRSystem
+  void GetRecommendedRenderTargetSize(uint32_t *pnWidth, uint32_t *pnHeight);
+  vr::HmdMatrix44_t GetProjectionMatrix(vr::EVREye eEye, float fNearZ, float fFarZ);
+  void GetProjectionRaw(vr::EVREye eEye, float *pfLeft, float *pfRight, float *pfTop, float *pfBottom);
+  vr::HmdMatrix34_t GetEyeToHeadTransform(vr::EVREye eEye);
+  bool GetTimeSinceLastVsync(float *pfSecondsSinceLastVsync, uint64_t *pulFrameCounter);
+  float GetFloatTrackedDeviceProperty(vr::TrackedDeviceIndex_t unDeviceIndex, vr::ETrackedDeviceProperty prop, vr::ETrackedPropertyError *pError = nullptr);
+  void GetDeviceToAbsoluteTrackingPose(vr::ETrackingUniverseOrigin eOrigin, float fPredictedSecondsToPhotonsFromNow, vr::TrackedDevicePose_t *pTrackedDevicePoseArray, uint32_t unTrackedDevicePoseArrayCount);
+  vr::HmdMatrix34_t GetSeatedZeroPoseToStandingAbsoluteTrackingPose();
+  vr::HmdMatrix34_t GetRawZeroPoseToStandingAbsoluteTrackingPose();
+  vr::TrackedDeviceIndex_t GetTrackedDeviceIndexForControllerRole(vr::ETrackedControllerRole unDeviceType);
+  vr::ETrackedControllerRole GetControllerRoleForTrackedDeviceIndex(vr::TrackedDeviceIndex_t unDeviceIndex);
+  vr::ETrackedDeviceClass GetTrackedDeviceClass(vr::TrackedDeviceIndex_t unDeviceIndex);
+  bool GetControllerState(vr::TrackedDeviceIndex_t unControllerDeviceIndex, vr::VRControllerState_t *pControllerState, uint32_t unControllerStateSize);
+  void TriggerHapticPulse(vr::TrackedDeviceIndex_t unControllerDeviceIndex, uint32_t unAxisId, unsigned short usDurationMicroSec);
+
+  /// IVRCompositor
+  vr::EVRCompositorError WaitGetPoses(vr::TrackedDevicePose_t *pRenderPoseArray, uint32_t unRenderPoseArrayCount, vr::TrackedDevicePose_t *pGamePoseArray, uint32_t unGamePoseArrayCount);
+  vr::EVRCompositorError Submit(vr::EVREye eEye, const vr::Texture_t *pTexture, const vr::VRTextureBounds_t *pBounds = nullptr, vr::EVRSubmitFlags nSubmitFlags = vr::Submit_Default);
+  bool GetFrameTiming(vr::Compositor_FrameTiming *pTiming, uint32_t unFramesAgo = 0);
+  uint32_t GetFrameTimings(vr::Compositor_FrameTiming *pTiming, uint32_t nFrames);
+  void GetCumulativeStats(vr::Compositor_CumulativeStats *pStats, uint32_t nStatsSizeInBytes);
+
+  /// Frames waited for, eye textures submitted, and vsyncs that passed without a frame.
+  uint64_t frames;
+  uint64_t submits;
+  uint64_t missedFrames;
+
+private:
+  typedef std::chrono::steady_clock Clock;
+
+  NullRuntime();
+
+  /// Scripted pose of a device at a time in seconds.
+  void GetDevicePose(vr::TrackedDeviceIndex_t unDeviceIndex, double t, vr::TrackedDevicePose_t *pose);
+  /// Seconds since the first frame; the mutex must be held.
+  double GetTime(Clock::time_point time) const;
+
+  std::mutex mutex;
+  bool started;
+  Clock::time_point startTime;
+  Clock::time_point lastFrameStart;
+  uint64_t vsyncCount;
+
+  /// Timings of finished frames, a ring indexed by frame number; a frame is finished when the next one starts.
+  vr::Compositor_FrameTiming frameTimings[NUM_FRAME_TIMINGS];
+  vr::Compositor_CumulativeStats cumulativeStats;
+
+  /// Offscreen target the submitted eyes are copied into, side by side, in the context that submitted them.
+  GLFWwindow *mirrorContext;
+  unsigned int mirrorFbo;
+  unsigned int mirrorTex;
+};
+
+#endif
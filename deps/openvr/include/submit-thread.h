@@ -0,0 +1,72 @@
+#ifndef _OPENVR_SUBMIT_THREAD_H_
+#define _OPENVR_SUBMIT_THREAD_H_
+
+#include <array>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <openvr.h>
+
+#include <webgl.h>
+
+/// Owns WaitGetPoses and Submit for a compositor on a thread with its own GL context, shared with the
+/// presenting window's. The JS thread fences its finished frame and hands it over without waiting; the submit
+/// thread waits for the fence, submits both eyes and goes straight into WaitGetPoses, so whatever JS does
+/// between frames overlaps the compositor's wait for the running start. The poses are kept for the next
+/// WaitPoses call, which only blocks if they are not in yet.
+class SubmitThread
+{
+public:
+  typedef std::array<vr::TrackedDevicePose_t, vr::k_unMaxTrackedDeviceCount> TrackedDevicePoseArray;
+
+  /// A finished frame: both eyes side by side in the left uMax by vMax of the texture, rendered with the
+  /// HMD pose if there is one.
+  struct Frame
+  {
+    GLuint texture;
+    float uMax;
+    float vMax;
+    bool hasPose;
+    float pose[12];
+  };
+
+  /// Submits both eyes of a frame from the calling thread and hands the frame off if both were accepted.
+  /// Returns the first error.
+  static vr::EVRCompositorError SubmitFrame(vr::IVRCompositor *compositor, const Frame &frame);
+
+  /// Must be called on the main thread; the shared window's context is made current there.
+  SubmitThread(vr::IVRCompositor *compositor, GLFWwindow *sharedWindow);
+  /// Stops the thread and destroys its context. Must be called on the main thread.
+  ~SubmitThread();
+
+  bool IsValid() const { return window != nullptr; }
+
+  /// Blocks until the poses of the next frame are in and copies them out.
+  void WaitPoses(TrackedDevicePoseArray &trackedDevicePoseArray);
+  /// Fences and flushes the current context, then queues the frame; an earlier frame still queued is
+  /// dropped. Returns the error of the last frame the thread submitted, if any.
+  vr::EVRCompositorError Submit(const Frame &frame);
+
+private:
+  void Run();
+
+  vr::IVRCompositor * const compositor;
+  GLFWwindow *window;
+
+  std::thread thread;
+  std::mutex mutex;
+  std::condition_variable framesCv;
+  std::condition_variable posesCv;
+  bool live;
+
+  bool hasFrame;
+  Frame frame;
+  GLsync frameFence;
+  vr::EVRCompositorError submitError;
+
+  bool posesWanted;
+  bool posesReady;
+  TrackedDevicePoseArray poses;
+};
+
+#endif
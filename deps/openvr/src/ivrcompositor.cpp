@@ -1,13 +1,19 @@
 #include <ivrcompositor.h>
 
-#include <array>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
 #include <node.h>
 #include <openvr.h>
 #include <ivrsystem.h>
+#include <null-runtime.h>
+#include <submit-thread.h>
+#include <defines.h>
 
 using namespace v8;
 
-using TrackedDevicePoseArray = std::array<vr::TrackedDevicePose_t, vr::k_unMaxTrackedDeviceCount>;
+using TrackedDevicePoseArray = SubmitThread::TrackedDevicePoseArray;
 
 //=============================================================================
 NAN_MODULE_INIT(IVRCompositor::Init)
@@ -23,7 +29,13 @@ NAN_MODULE_INIT(IVRCompositor::Init)
 
   // Assign all the wrapped methods of this object.
   Nan::SetPrototypeMethod(tpl, "WaitGetPoses", WaitGetPoses);
+  Nan::SetPrototypeMethod(tpl, "WaitGetFrame", WaitGetFrame);
   Nan::SetPrototypeMethod(tpl, "Submit", Submit);
+  Nan::SetPrototypeMethod(tpl, "StartSubmitThread", StartSubmitThread);
+  Nan::SetPrototypeMethod(tpl, "StopSubmitThread", StopSubmitThread);
+  Nan::SetPrototypeMethod(tpl, "GetFrameTiming", GetFrameTiming);
+  Nan::SetPrototypeMethod(tpl, "GetFrameTimings", GetFrameTimings);
+  Nan::SetPrototypeMethod(tpl, "GetCumulativeStats", GetCumulativeStats);
 
   // Set a static constructor function to reference the `New` function template.
   constructor().Reset(Nan::GetFunction(tpl).ToLocalChecked());
@@ -40,11 +52,65 @@ Local<Object> IVRCompositor::NewInstance(vr::IVRCompositor *compositor)
 
 //=============================================================================
 IVRCompositor::IVRCompositor(vr::IVRCompositor *self)
-: self_(self)
+: self_(self), hasRenderPose(false), eyesCached(false), cachedIpd(0), cachedDepthNear(0), cachedDepthFar(0)
 {
   // Do nothing.
 }
 
+//=============================================================================
+IVRCompositor::~IVRCompositor()
+{
+  // Defined here, where SubmitThread is complete.
+}
+
+//=============================================================================
+/// Gets the poses of the next frame, from the submit thread while it runs.
+static void waitGetPoses(vr::IVRCompositor *self, SubmitThread *submitThread, TrackedDevicePoseArray &trackedDevicePoseArray)
+{
+  if (submitThread) {
+    submitThread->WaitPoses(trackedDevicePoseArray);
+  } else {
+    VR_CALL(self, WaitGetPoses, trackedDevicePoseArray.data(), static_cast<uint32_t>(trackedDevicePoseArray.size()), nullptr, 0);
+  }
+}
+
+/// Re-predicts the device poses for when a frame rendered from now on reaches the display. WaitGetPoses predicts
+/// for the frame it waited for, and the submit thread may have fetched those poses well before JS renders.
+static void getRenderPoses(vr::IVRSystem *system, TrackedDevicePoseArray &trackedDevicePoseArray)
+{
+  float secondsSinceLastVsync;
+  if (!VR_CALL(system, GetTimeSinceLastVsync, &secondsSinceLastVsync, nullptr))
+  {
+    return;
+  }
+  const float displayFrequency = VR_CALL(system, GetFloatTrackedDeviceProperty, vr::k_unTrackedDeviceIndex_Hmd, vr::Prop_DisplayFrequency_Float, nullptr);
+  const float vsyncToPhotons = VR_CALL(system, GetFloatTrackedDeviceProperty, vr::k_unTrackedDeviceIndex_Hmd, vr::Prop_SecondsFromVsyncToPhotons_Float, nullptr);
+  if (displayFrequency <= 0)
+  {
+    return;
+  }
+
+  const float secondsToPhotons = std::max(1.0f / displayFrequency - secondsSinceLastVsync, 0.0f) + vsyncToPhotons;
+  VR_CALL(system, GetDeviceToAbsoluteTrackingPose, vr::TrackingUniverseStanding, secondsToPhotons, trackedDevicePoseArray.data(), static_cast<uint32_t>(trackedDevicePoseArray.size()));
+}
+
+/// Throws the JS error for a failed Submit. Losing focus is not an error.
+static void throwCompositorError(vr::EVRCompositorError compositorError)
+{
+  if (compositorError == vr::VRCompositorError_RequestFailed) Nan::ThrowError("Compositor error: VRCompositorError_RequestFailed");
+  else if (compositorError == vr::VRCompositorError_IncompatibleVersion) Nan::ThrowError("Compositor error: VRCompositorError_IncompatibleVersion");
+  else if (compositorError == vr::VRCompositorError_DoNotHaveFocus) {} // Nan::ThrowError("Compositor error: VRCompositorError_DoNotHaveFocus");
+  else if (compositorError == vr::VRCompositorError_InvalidTexture) Nan::ThrowError("Compositor error: VRCompositorError_InvalidTexture");
+  else if (compositorError == vr::VRCompositorError_IsNotSceneApplication) Nan::ThrowError("Compositor error: VRCompositorError_IsNotSceneApplication");
+  else if (compositorError == vr::VRCompositorError_TextureIsOnWrongDevice) Nan::ThrowError("Compositor error: VRCompositorError_TextureIsOnWrongDevice");
+  else if (compositorError == vr::VRCompositorError_TextureUsesUnsupportedFormat) Nan::ThrowError("Compositor error: VRCompositorError_TextureUsesUnsupportedFormat");
+  else if (compositorError == vr::VRCompositorError_SharedTexturesNotSupported) Nan::ThrowError("Compositor error: VRCompositorError_SharedTexturesNotSupported");
+  else if (compositorError == vr::VRCompositorError_IndexOutOfRange) Nan::ThrowError("Compositor error: VRCompositorError_IndexOutOfRange");
+  else if (compositorError == vr::VRCompositorError_AlreadySubmitted) Nan::ThrowError("Compositor error: VRCompositorError_AlreadySubmitted");
+  else if (compositorError == vr::VRCompositorError_InvalidBounds) Nan::ThrowError("Compositor error: VRCompositorError_InvalidBounds");
+  else Nan::ThrowError("Compositor error: unknown");
+}
+
 //=============================================================================
 NAN_METHOD(IVRCompositor::New)
 {
@@ -78,130 +144,250 @@ NAN_METHOD(IVRCompositor::WaitGetPoses)
   }
 
   TrackedDevicePoseArray trackedDevicePoseArray;
-	obj->self_->WaitGetPoses(trackedDevicePoseArray.data(), static_cast<uint32_t>(trackedDevicePoseArray.size()), nullptr, 0);
+  waitGetPoses(obj->self_, obj->submitThread.get(), trackedDevicePoseArray);
 
   IVRSystem* system = IVRSystem::Unwrap<IVRSystem>(Local<Object>::Cast(info[0]));
   Local<Float32Array> hmdFloat32Array = Local<Float32Array>::Cast(info[1]);
   Local<Float32Array> leftControllerFloat32Array = Local<Float32Array>::Cast(info[2]);
   Local<Float32Array> rightControllerFloat32Array = Local<Float32Array>::Cast(info[3]);
-  hmdFloat32Array->Set(0, Number::New(Isolate::GetCurrent(), std::numeric_limits<float>::quiet_NaN()));
-  leftControllerFloat32Array->Set(0, Number::New(Isolate::GetCurrent(), std::numeric_limits<float>::quiet_NaN()));
-  rightControllerFloat32Array->Set(0, Number::New(Isolate::GetCurrent(), std::numeric_limits<float>::quiet_NaN()));
+  if (hmdFloat32Array->Length() < 16 || leftControllerFloat32Array->Length() < 16 || rightControllerFloat32Array->Length() < 16)
+  {
+    Nan::ThrowTypeError("Arguments[1-3] must have 16 elements.");
+    return;
+  }
+
+  system->WritePoses(
+    trackedDevicePoseArray.data(), static_cast<uint32_t>(trackedDevicePoseArray.size()),
+    getTypedArrayData(hmdFloat32Array), getTypedArrayData(leftControllerFloat32Array), getTypedArrayData(rightControllerFloat32Array)
+  );
+}
+
+//=============================================================================
+/// Helpers for the 3x4 row-major rigid transforms OpenVR reports.
+static void multiplyRigid(const float *a, const float *b, float *out)
+{
+  for (unsigned int r = 0; r < 3; r++) {
+    for (unsigned int c = 0; c < 4; c++) {
+      out[r * 4 + c] = a[r * 4 + 0] * b[0 * 4 + c] + a[r * 4 + 1] * b[1 * 4 + c] + a[r * 4 + 2] * b[2 * 4 + c] + (c == 3 ? a[r * 4 + 3] : 0);
+    }
+  }
+}
+
+static void invertRigid(const float *m, float *out)
+{
+  for (unsigned int r = 0; r < 3; r++) {
+    for (unsigned int c = 0; c < 3; c++) {
+      out[r * 4 + c] = m[c * 4 + r];
+    }
+    out[r * 4 + 3] = -(m[0 * 4 + r] * m[3] + m[1 * 4 + r] * m[7] + m[2 * 4 + r] * m[11]);
+  }
+}
+
+static void writePosition(const float *m, float *position)
+{
+  position[0] = m[3];
+  position[1] = m[7];
+  position[2] = m[11];
+}
+
+static void writeOrientation(const float *m, float *q)
+{
+  const float m11 = m[0], m12 = m[1], m13 = m[2];
+  const float m21 = m[4], m22 = m[5], m23 = m[6];
+  const float m31 = m[8], m32 = m[9], m33 = m[10];
+  const float trace = m11 + m22 + m33;
+
+  if (trace > 0) {
+    const float s = 0.5f / std::sqrt(trace + 1.0f);
+    q[3] = 0.25f / s;
+    q[0] = (m32 - m23) * s;
+    q[1] = (m13 - m31) * s;
+    q[2] = (m21 - m12) * s;
+  } else if (m11 > m22 && m11 > m33) {
+    const float s = 2.0f * std::sqrt(1.0f + m11 - m22 - m33);
+    q[3] = (m32 - m23) / s;
+    q[0] = 0.25f * s;
+    q[1] = (m12 + m21) / s;
+    q[2] = (m13 + m31) / s;
+  } else if (m22 > m33) {
+    const float s = 2.0f * std::sqrt(1.0f + m22 - m11 - m33);
+    q[3] = (m13 - m31) / s;
+    q[0] = (m12 + m21) / s;
+    q[1] = 0.25f * s;
+    q[2] = (m23 + m32) / s;
+  } else {
+    const float s = 2.0f * std::sqrt(1.0f + m33 - m11 - m22);
+    q[3] = (m21 - m12) / s;
+    q[0] = (m13 + m31) / s;
+    q[1] = (m23 + m32) / s;
+    q[2] = 0.25f * s;
+  }
+}
+
+static const float identityRigid[12] = {
+  1, 0, 0, 0,
+  0, 1, 0, 0,
+  0, 0, 1, 0,
+};
+
+//=============================================================================
+/// Waits for the next frame like WaitGetPoses, but fills one Float32Array with everything the present loop
+/// needs; see the FRAME_* layout in ivrcompositor.h. Eye-to-head transforms, projections and fovs are cached
+/// until the IPD or the clip planes change.
+NAN_METHOD(IVRCompositor::WaitGetFrame)
+{
+  IVRCompositor* obj = ObjectWrap::Unwrap<IVRCompositor>(info.Holder());
+
+  if (info.Length() != 4)
+  {
+    Nan::ThrowError("Wrong number of arguments.");
+    return;
+  }
+
+  if (!info[0]->IsObject() || !info[1]->IsNumber() || !info[2]->IsNumber() || !info[3]->IsFloat32Array())
+  {
+    Nan::ThrowTypeError("Expected arguments (IVRSystem, number, number, Float32Array).");
+    return;
+  }
+
+  Local<Float32Array> frameFloat32Array = Local<Float32Array>::Cast(info[3]);
+  if (frameFloat32Array->Length() < FRAME_SIZE)
+  {
+    Nan::ThrowTypeError("Argument[3] is too small for a frame.");
+    return;
+  }
+
+  IVRSystem* system = IVRSystem::Unwrap<IVRSystem>(Local<Object>::Cast(info[0]));
+  const float depthNear = static_cast<float>(info[1]->NumberValue());
+  const float depthFar = static_cast<float>(info[2]->NumberValue());
+  float *frame = getTypedArrayData(frameFloat32Array);
+
+  TrackedDevicePoseArray trackedDevicePoseArray;
+  waitGetPoses(obj->self_, obj->submitThread.get(), trackedDevicePoseArray);
+  // the frame is rendered with, and submitted with, a pose sampled now rather than the one WaitGetPoses returned
+  getRenderPoses(system->self_, trackedDevicePoseArray);
+
+  const float ipd = VR_CALL(system->self_, GetFloatTrackedDeviceProperty, vr::k_unTrackedDeviceIndex_Hmd, vr::Prop_UserIpdMeters_Float);
+  if (!obj->eyesCached || ipd != obj->cachedIpd || depthNear != obj->cachedDepthNear || depthFar != obj->cachedDepthFar) {
+    for (unsigned int eye = 0; eye < 2; eye++) {
+      const vr::EVREye eEye = static_cast<vr::EVREye>(eye);
+      float *eyeFrame = obj->eyeFrames[eye];
+
+      const vr::HmdMatrix34_t eyeToHead = VR_CALL(system->self_, GetEyeToHeadTransform, eEye);
+      memcpy(obj->eyeToHead[eye], &eyeToHead.m[0][0], sizeof(obj->eyeToHead[eye]));
+
+      const vr::HmdMatrix44_t projection = VR_CALL(system->self_, GetProjectionMatrix, eEye, depthNear, depthFar);
+      transposeMatrix(&projection.m[0][0], 4, eyeFrame + 16);
+
+      writePosition(obj->eyeToHead[eye], eyeFrame + 32);
+      eyeFrame[35] = 0;
+
+      float fov[4];
+      VR_CALL(system->self_, GetProjectionRaw, eEye, &fov[0], &fov[1], &fov[2], &fov[3]);
+      for (unsigned int i = 0; i < 4; i++) {
+        eyeFrame[36 + i] = std::atan(fov[i]) * (180.0 / 3.14159265358979323846);
+      }
+    }
+
+    obj->eyesCached = true;
+    obj->cachedIpd = ipd;
+    obj->cachedDepthNear = depthNear;
+    obj->cachedDepthFar = depthFar;
+  }
+
+  // an untracked headset is treated as sitting at the origin
+  const float *hmd = identityRigid;
+  float *controllers[2] = {frame + FRAME_LEFT_CONTROLLER, frame + FRAME_RIGHT_CONTROLLER};
+  for (unsigned int i = 0; i < 2; i++) {
+    controllers[i][0] = std::numeric_limits<float>::quiet_NaN();
+    writePosition(identityRigid, controllers[i] + IVRSystem::CONTROLLER_STATE_SIZE);
+    writeOrientation(identityRigid, controllers[i] + IVRSystem::CONTROLLER_STATE_SIZE + 3);
+  }
 
   for (unsigned int i = 0; i < trackedDevicePoseArray.size(); i++) {
     const vr::TrackedDevicePose_t &trackedDevicePose = trackedDevicePoseArray[i];
-    if (trackedDevicePose.bPoseIsValid) {
-      const vr::ETrackedDeviceClass deviceClass = system->self_->GetTrackedDeviceClass(i);
-      if (deviceClass == vr::TrackedDeviceClass_HMD) {
-        const vr::HmdMatrix34_t &matrix = trackedDevicePose.mDeviceToAbsoluteTracking;
-
-        for (unsigned int v = 0; v < 4; v++) {
-          for (unsigned int u = 0; u < 3; u++) {
-            hmdFloat32Array->Set(v * 4 + u, Number::New(Isolate::GetCurrent(), matrix.m[u][v]));
-          }
-        }
-        hmdFloat32Array->Set(0 * 4 + 3, Number::New(Isolate::GetCurrent(), 0));
-        hmdFloat32Array->Set(1 * 4 + 3, Number::New(Isolate::GetCurrent(), 0));
-        hmdFloat32Array->Set(2 * 4 + 3, Number::New(Isolate::GetCurrent(), 0));
-        hmdFloat32Array->Set(3 * 4 + 3, Number::New(Isolate::GetCurrent(), 1));
-      } else if (deviceClass == vr::TrackedDeviceClass_Controller) {
-        const vr::ETrackedControllerRole controllerRole = system->self_->GetControllerRoleForTrackedDeviceIndex(i);
-        if (controllerRole == vr::TrackedControllerRole_LeftHand) {
-          const vr::HmdMatrix34_t &matrix = trackedDevicePose.mDeviceToAbsoluteTracking;
-
-          for (unsigned int v = 0; v < 4; v++) {
-            for (unsigned int u = 0; u < 3; u++) {
-              leftControllerFloat32Array->Set(v * 4 + u, Number::New(Isolate::GetCurrent(), matrix.m[u][v]));
-            }
-          }
-          leftControllerFloat32Array->Set(0 * 4 + 3, Number::New(Isolate::GetCurrent(), 0));
-          leftControllerFloat32Array->Set(1 * 4 + 3, Number::New(Isolate::GetCurrent(), 0));
-          leftControllerFloat32Array->Set(2 * 4 + 3, Number::New(Isolate::GetCurrent(), 0));
-          leftControllerFloat32Array->Set(3 * 4 + 3, Number::New(Isolate::GetCurrent(), 1));
-        } else if (controllerRole == vr::TrackedControllerRole_RightHand) {
-          const vr::HmdMatrix34_t &matrix = trackedDevicePose.mDeviceToAbsoluteTracking;
-
-          for (unsigned int v = 0; v < 4; v++) {
-            for (unsigned int u = 0; u < 3; u++) {
-              rightControllerFloat32Array->Set(v * 4 + u, Number::New(Isolate::GetCurrent(), matrix.m[u][v]));
-            }
-          }
-          rightControllerFloat32Array->Set(0 * 4 + 3, Number::New(Isolate::GetCurrent(), 0));
-          rightControllerFloat32Array->Set(1 * 4 + 3, Number::New(Isolate::GetCurrent(), 0));
-          rightControllerFloat32Array->Set(2 * 4 + 3, Number::New(Isolate::GetCurrent(), 0));
-          rightControllerFloat32Array->Set(3 * 4 + 3, Number::New(Isolate::GetCurrent(), 1));
-        }
+    const vr::ETrackedDeviceClass deviceClass = VR_CALL(system->self_, GetTrackedDeviceClass, i);
+    const float *matrix = &trackedDevicePose.mDeviceToAbsoluteTracking.m[0][0];
+
+    if (deviceClass == vr::TrackedDeviceClass_HMD) {
+      if (trackedDevicePose.bPoseIsValid) {
+        hmd = matrix;
+      }
+    } else if (deviceClass == vr::TrackedDeviceClass_Controller) {
+      const vr::ETrackedControllerRole controllerRole = VR_CALL(system->self_, GetControllerRoleForTrackedDeviceIndex, i);
+      float *controller = controllerRole == vr::TrackedControllerRole_LeftHand ? controllers[0] : (controllerRole == vr::TrackedControllerRole_RightHand ? controllers[1] : nullptr);
+      if (controller && system->WriteControllerState(i, controller) && trackedDevicePose.bPoseIsValid) {
+        writePosition(matrix, controller + IVRSystem::CONTROLLER_STATE_SIZE);
+        writeOrientation(matrix, controller + IVRSystem::CONTROLLER_STATE_SIZE + 3);
       }
     }
   }
+
+  writePosition(hmd, frame + FRAME_POSE);
+  writeOrientation(hmd, frame + FRAME_POSE + 3);
+  frame[FRAME_POSE + 7] = hmd != identityRigid ? 1 : 0;
+
+  obj->hasRenderPose = hmd != identityRigid;
+  if (obj->hasRenderPose) {
+    memcpy(obj->renderPose, hmd, sizeof(obj->renderPose));
+  }
+
+  for (unsigned int eye = 0; eye < 2; eye++) {
+    float *eyeFrame = frame + (eye == 0 ? FRAME_LEFT_EYE : FRAME_RIGHT_EYE);
+    memcpy(eyeFrame, obj->eyeFrames[eye], sizeof(obj->eyeFrames[eye]));
+
+    // view = inverse(hmd * eyeToHead)
+    float eyeToAbsolute[12];
+    float view[12];
+    multiplyRigid(hmd, obj->eyeToHead[eye], eyeToAbsolute);
+    invertRigid(eyeToAbsolute, view);
+    transposeMatrix(view, 3, eyeFrame);
+  }
 }
 
 NAN_METHOD(IVRCompositor::Submit)
 {
   IVRCompositor* obj = ObjectWrap::Unwrap<IVRCompositor>(info.Holder());
 
-  if (info.Length() != 2)
+  if (info.Length() != 2 && info.Length() != 4)
   {
     Nan::ThrowError("Wrong number of arguments.");
     return;
   }
 
-  if (!(info[0]->IsObject() && info[1]->IsNumber()))
+  if (!(info[0]->IsObject() && info[1]->IsNumber()) || (info.Length() == 4 && !(info[2]->IsNumber() && info[3]->IsNumber())))
   {
-    Nan::ThrowError("Expected arguments (object, number).");
+    Nan::ThrowError("Expected arguments (object, number[, number, number]).");
     return;
   }
 
   WebGLRenderingContext *gl = node::ObjectWrap::Unwrap<WebGLRenderingContext>(Local<Object>::Cast(info[0]));
-  GLuint texture = info[1]->Uint32Value();
 
-  vr::EColorSpace colorSpace = vr::ColorSpace_Gamma;
+  SubmitThread::Frame frame;
+  frame.texture = info[1]->Uint32Value();
+  // the eyes may only cover part of the texture when rendering at a reduced scale
+  frame.uMax = info.Length() == 4 ? static_cast<float>(info[2]->NumberValue()) : 1;
+  frame.vMax = info.Length() == 4 ? static_cast<float>(info[3]->NumberValue()) : 1;
+  frame.hasPose = obj->hasRenderPose;
+  if (obj->hasRenderPose) {
+    memcpy(frame.pose, obj->renderPose, sizeof(obj->renderPose));
+    obj->hasRenderPose = false;
+  }
 
-  vr::Texture_t leftEyeTexture = {(void *)(size_t)texture, vr::TextureType_OpenGL, colorSpace};
-  vr::VRTextureBounds_t leftEyeTextureBounds = {
-    0, 0,
-    0.5, 1,
-  };
-  vr::EVRCompositorError compositorError = obj->self_->Submit(vr::Eye_Left, &leftEyeTexture, &leftEyeTextureBounds);
-  if (compositorError != vr::VRCompositorError_None) {
-    if (compositorError == vr::VRCompositorError_RequestFailed) Nan::ThrowError("Compositor error: VRCompositorError_RequestFailed");
-    else if (compositorError == vr::VRCompositorError_IncompatibleVersion) Nan::ThrowError("Compositor error: VRCompositorError_IncompatibleVersion");
-    else if (compositorError == vr::VRCompositorError_DoNotHaveFocus) {} // Nan::ThrowError("Compositor error: VRCompositorError_DoNotHaveFocus");
-    else if (compositorError == vr::VRCompositorError_InvalidTexture) Nan::ThrowError("Compositor error: VRCompositorError_InvalidTexture");
-    else if (compositorError == vr::VRCompositorError_IsNotSceneApplication) Nan::ThrowError("Compositor error: VRCompositorError_IsNotSceneApplication");
-    else if (compositorError == vr::VRCompositorError_TextureIsOnWrongDevice) Nan::ThrowError("Compositor error: VRCompositorError_TextureIsOnWrongDevice");
-    else if (compositorError == vr::VRCompositorError_TextureUsesUnsupportedFormat) Nan::ThrowError("Compositor error: VRCompositorError_TextureUsesUnsupportedFormat");
-    else if (compositorError == vr::VRCompositorError_SharedTexturesNotSupported) Nan::ThrowError("Compositor error: VRCompositorError_SharedTexturesNotSupported");
-    else if (compositorError == vr::VRCompositorError_IndexOutOfRange) Nan::ThrowError("Compositor error: VRCompositorError_IndexOutOfRange");
-    else if (compositorError == vr::VRCompositorError_AlreadySubmitted) Nan::ThrowError("Compositor error: VRCompositorError_AlreadySubmitted");
-    else if (compositorError == vr::VRCompositorError_InvalidBounds) Nan::ThrowError("Compositor error: VRCompositorError_InvalidBounds");
-    else Nan::ThrowError("Compositor error: unknown");
-    return;
-  }
-
-  vr::Texture_t rightEyeTexture = {(void *)(size_t)texture, vr::TextureType_OpenGL, colorSpace};
-  vr::VRTextureBounds_t rightEyeTextureBounds = {
-    0.5, 0,
-    1, 1,
-  };
-  compositorError = obj->self_->Submit(vr::Eye_Right, &rightEyeTexture, &rightEyeTextureBounds);
-  if (compositorError != vr::VRCompositorError_None) {
-    if (compositorError == vr::VRCompositorError_RequestFailed) Nan::ThrowError("Compositor error: VRCompositorError_RequestFailed");
-    else if (compositorError == vr::VRCompositorError_IncompatibleVersion) Nan::ThrowError("Compositor error: VRCompositorError_IncompatibleVersion");
-    else if (compositorError == vr::VRCompositorError_DoNotHaveFocus) {} // Nan::ThrowError("Compositor error: VRCompositorError_DoNotHaveFocus");
-    else if (compositorError == vr::VRCompositorError_InvalidTexture) Nan::ThrowError("Compositor error: VRCompositorError_InvalidTexture");
-    else if (compositorError == vr::VRCompositorError_IsNotSceneApplication) Nan::ThrowError("Compositor error: VRCompositorError_IsNotSceneApplication");
-    else if (compositorError == vr::VRCompositorError_TextureIsOnWrongDevice) Nan::ThrowError("Compositor error: VRCompositorError_TextureIsOnWrongDevice");
-    else if (compositorError == vr::VRCompositorError_TextureUsesUnsupportedFormat) Nan::ThrowError("Compositor error: VRCompositorError_TextureUsesUnsupportedFormat");
-    else if (compositorError == vr::VRCompositorError_SharedTexturesNotSupported) Nan::ThrowError("Compositor error: VRCompositorError_SharedTexturesNotSupported");
-    else if (compositorError == vr::VRCompositorError_IndexOutOfRange) Nan::ThrowError("Compositor error: VRCompositorError_IndexOutOfRange");
-    else if (compositorError == vr::VRCompositorError_AlreadySubmitted) Nan::ThrowError("Compositor error: VRCompositorError_AlreadySubmitted");
-    else if (compositorError == vr::VRCompositorError_InvalidBounds) Nan::ThrowError("Compositor error: VRCompositorError_InvalidBounds");
-    else Nan::ThrowError("Compositor error: unknown");
+  if (obj->submitThread) {
+    // errors of the previous frame surface here, since this one is submitted later
+    const vr::EVRCompositorError compositorError = obj->submitThread->Submit(frame);
+    if (compositorError != vr::VRCompositorError_None) {
+      throwCompositorError(compositorError);
+    }
     return;
   }
 
-  obj->self_->PostPresentHandoff();
+  const vr::EVRCompositorError compositorError = SubmitThread::SubmitFrame(obj->self_, frame);
+  if (compositorError != vr::VRCompositorError_None) {
+    throwCompositorError(compositorError);
+    return;
+  }
 
   if (gl->HasTextureBinding(gl->activeTexture, GL_TEXTURE_2D)) {
     glBindTexture(GL_TEXTURE_2D, gl->GetTextureBinding(gl->activeTexture, GL_TEXTURE_2D));
@@ -220,6 +406,187 @@ NAN_METHOD(IVRCompositor::Submit)
   }
 }
 
+//=============================================================================
+/// Moves waiting and submission to a thread with its own context, shared with the given WebGL context's.
+/// The context must be the one the submitted textures belong to.
+NAN_METHOD(IVRCompositor::StartSubmitThread)
+{
+  IVRCompositor* obj = ObjectWrap::Unwrap<IVRCompositor>(info.Holder());
+
+  if (info.Length() != 1)
+  {
+    Nan::ThrowError("Wrong number of arguments.");
+    return;
+  }
+
+  if (!info[0]->IsObject())
+  {
+    Nan::ThrowTypeError("Argument[0] must be a WebGLRenderingContext.");
+    return;
+  }
+
+  if (obj->submitThread)
+  {
+    return;
+  }
+
+  WebGLRenderingContext *gl = node::ObjectWrap::Unwrap<WebGLRenderingContext>(Local<Object>::Cast(info[0]));
+  std::unique_ptr<SubmitThread> submitThread(new SubmitThread(obj->self_, gl->windowHandle));
+  if (!submitThread->IsValid())
+  {
+    Nan::ThrowError("Unable to create the submit thread context.");
+    return;
+  }
+  obj->submitThread = std::move(submitThread);
+}
+
+//=============================================================================
+/// Joins the submit thread; a frame it has not submitted yet is dropped. Must be called before VR_Shutdown.
+NAN_METHOD(IVRCompositor::StopSubmitThread)
+{
+  IVRCompositor* obj = ObjectWrap::Unwrap<IVRCompositor>(info.Holder());
+
+  if (info.Length() != 0)
+  {
+    Nan::ThrowError("Wrong number of arguments.");
+    return;
+  }
+
+  obj->submitThread.reset();
+}
+
+//=============================================================================
+/// Returns the timing of a finished frame as an object, or null if there is none that many frames ago.
+NAN_METHOD(IVRCompositor::GetFrameTiming)
+{
+  IVRCompositor* obj = ObjectWrap::Unwrap<IVRCompositor>(info.Holder());
+
+  if (info.Length() > 1)
+  {
+    Nan::ThrowError("Wrong number of arguments.");
+    return;
+  }
+
+  if (info.Length() == 1 && !info[0]->IsNumber())
+  {
+    Nan::ThrowTypeError("Argument[0] must be a number.");
+    return;
+  }
+
+  vr::Compositor_FrameTiming timing;
+  timing.m_nSize = sizeof(timing);
+  const uint32_t framesAgo = info.Length() == 1 ? info[0]->Uint32Value() : 0;
+  if (!VR_CALL(obj->self_, GetFrameTiming, &timing, framesAgo))
+  {
+    info.GetReturnValue().Set(Nan::Null());
+    return;
+  }
+
+  Local<Object> result = Nan::New<Object>();
+  result->Set(Nan::New("frameIndex").ToLocalChecked(), Nan::New<Number>(timing.m_nFrameIndex));
+  result->Set(Nan::New("numFramePresents").ToLocalChecked(), Nan::New<Number>(timing.m_nNumFramePresents));
+  result->Set(Nan::New("numMisPresented").ToLocalChecked(), Nan::New<Number>(timing.m_nNumMisPresented));
+  result->Set(Nan::New("numDroppedFrames").ToLocalChecked(), Nan::New<Number>(timing.m_nNumDroppedFrames));
+  result->Set(Nan::New("reprojectionFlags").ToLocalChecked(), Nan::New<Number>(timing.m_nReprojectionFlags));
+  result->Set(Nan::New("systemTimeInSeconds").ToLocalChecked(), Nan::New<Number>(timing.m_flSystemTimeInSeconds));
+  result->Set(Nan::New("preSubmitGpuMs").ToLocalChecked(), Nan::New<Number>(timing.m_flPreSubmitGpuMs));
+  result->Set(Nan::New("postSubmitGpuMs").ToLocalChecked(), Nan::New<Number>(timing.m_flPostSubmitGpuMs));
+  result->Set(Nan::New("totalRenderGpuMs").ToLocalChecked(), Nan::New<Number>(timing.m_flTotalRenderGpuMs));
+  result->Set(Nan::New("compositorRenderGpuMs").ToLocalChecked(), Nan::New<Number>(timing.m_flCompositorRenderGpuMs));
+  result->Set(Nan::New("compositorRenderCpuMs").ToLocalChecked(), Nan::New<Number>(timing.m_flCompositorRenderCpuMs));
+  result->Set(Nan::New("compositorIdleCpuMs").ToLocalChecked(), Nan::New<Number>(timing.m_flCompositorIdleCpuMs));
+  result->Set(Nan::New("clientFrameIntervalMs").ToLocalChecked(), Nan::New<Number>(timing.m_flClientFrameIntervalMs));
+  result->Set(Nan::New("presentCallCpuMs").ToLocalChecked(), Nan::New<Number>(timing.m_flPresentCallCpuMs));
+  result->Set(Nan::New("waitForPresentCpuMs").ToLocalChecked(), Nan::New<Number>(timing.m_flWaitForPresentCpuMs));
+  result->Set(Nan::New("submitFrameMs").ToLocalChecked(), Nan::New<Number>(timing.m_flSubmitFrameMs));
+  info.GetReturnValue().Set(result);
+}
+
+//=============================================================================
+/// Fills a Float64Array with the timings of the most recent finished frames that fit, oldest first, in the
+/// FRAME_TIMING_SIZE layout, and returns how many were written. Meant to be polled every frame without
+/// allocating.
+NAN_METHOD(IVRCompositor::GetFrameTimings)
+{
+  IVRCompositor* obj = ObjectWrap::Unwrap<IVRCompositor>(info.Holder());
+
+  if (info.Length() != 1)
+  {
+    Nan::ThrowError("Wrong number of arguments.");
+    return;
+  }
+
+  if (!info[0]->IsFloat64Array())
+  {
+    Nan::ThrowTypeError("Argument[0] must be a Float64Array.");
+    return;
+  }
+
+  Local<Float64Array> timingsFloat64Array = Local<Float64Array>::Cast(info[0]);
+  double *out = getTypedArrayData(timingsFloat64Array);
+
+  constexpr uint32_t maxFrames = 16;
+  vr::Compositor_FrameTiming timings[maxFrames];
+  for (uint32_t i = 0; i < maxFrames; i++)
+  {
+    timings[i].m_nSize = sizeof(timings[i]);
+  }
+  const uint32_t numFrames = VR_CALL(
+    obj->self_, GetFrameTimings,
+    timings, std::min<uint32_t>(maxFrames, static_cast<uint32_t>(timingsFloat64Array->Length() / FRAME_TIMING_SIZE))
+  );
+
+  for (uint32_t i = 0; i < numFrames; i++)
+  {
+    const vr::Compositor_FrameTiming &timing = timings[i];
+    double *frameTiming = out + i * FRAME_TIMING_SIZE;
+    frameTiming[0] = timing.m_nFrameIndex;
+    frameTiming[1] = timing.m_nNumFramePresents;
+    frameTiming[2] = timing.m_nNumMisPresented;
+    frameTiming[3] = timing.m_nNumDroppedFrames;
+    frameTiming[4] = timing.m_nReprojectionFlags;
+    frameTiming[5] = timing.m_flSystemTimeInSeconds;
+    frameTiming[6] = timing.m_flTotalRenderGpuMs;
+    frameTiming[7] = timing.m_flCompositorRenderGpuMs;
+    frameTiming[8] = timing.m_flCompositorRenderCpuMs;
+    frameTiming[9] = timing.m_flClientFrameIntervalMs;
+  }
+
+  info.GetReturnValue().Set(Nan::New<Number>(numFrames));
+}
+
+//=============================================================================
+NAN_METHOD(IVRCompositor::GetCumulativeStats)
+{
+  IVRCompositor* obj = ObjectWrap::Unwrap<IVRCompositor>(info.Holder());
+
+  if (info.Length() != 0)
+  {
+    Nan::ThrowError("Wrong number of arguments.");
+    return;
+  }
+
+  vr::Compositor_CumulativeStats stats;
+  VR_CALL(obj->self_, GetCumulativeStats, &stats, sizeof(stats));
+
+  Local<Object> result = Nan::New<Object>();
+  result->Set(Nan::New("numFramePresents").ToLocalChecked(), Nan::New<Number>(stats.m_nNumFramePresents));
+  result->Set(Nan::New("numDroppedFrames").ToLocalChecked(), Nan::New<Number>(stats.m_nNumDroppedFrames));
+  result->Set(Nan::New("numReprojectedFrames").ToLocalChecked(), Nan::New<Number>(stats.m_nNumReprojectedFrames));
+  result->Set(Nan::New("numFramePresentsOnStartup").ToLocalChecked(), Nan::New<Number>(stats.m_nNumFramePresentsOnStartup));
+  result->Set(Nan::New("numDroppedFramesOnStartup").ToLocalChecked(), Nan::New<Number>(stats.m_nNumDroppedFramesOnStartup));
+  result->Set(Nan::New("numReprojectedFramesOnStartup").ToLocalChecked(), Nan::New<Number>(stats.m_nNumReprojectedFramesOnStartup));
+  result->Set(Nan::New("numLoading").ToLocalChecked(), Nan::New<Number>(stats.m_nNumLoading));
+  result->Set(Nan::New("numFramePresentsLoading").ToLocalChecked(), Nan::New<Number>(stats.m_nNumFramePresentsLoading));
+  result->Set(Nan::New("numDroppedFramesLoading").ToLocalChecked(), Nan::New<Number>(stats.m_nNumDroppedFramesLoading));
+  result->Set(Nan::New("numReprojectedFramesLoading").ToLocalChecked(), Nan::New<Number>(stats.m_nNumReprojectedFramesLoading));
+  result->Set(Nan::New("numTimedOut").ToLocalChecked(), Nan::New<Number>(stats.m_nNumTimedOut));
+  result->Set(Nan::New("numFramePresentsTimedOut").ToLocalChecked(), Nan::New<Number>(stats.m_nNumFramePresentsTimedOut));
+  result->Set(Nan::New("numDroppedFramesTimedOut").ToLocalChecked(), Nan::New<Number>(stats.m_nNumDroppedFramesTimedOut));
+  result->Set(Nan::New("numReprojectedFramesTimedOut").ToLocalChecked(), Nan::New<Number>(stats.m_nNumReprojectedFramesTimedOut));
+  info.GetReturnValue().Set(result);
+}
+
 NAN_METHOD(NewCompositor) {
   if (info.Length() != 0)
   {
@@ -227,6 +594,12 @@ NAN_METHOD(NewCompositor) {
     return;
   }
 
+  if (NullRuntime::IsEnabled())
+  {
+    info.GetReturnValue().Set(IVRCompositor::NewInstance(nullptr));
+    return;
+  }
+
   // Perform the actual wrapped call.
   vr::IVRCompositor *compositor = vr::VRCompositor();
   if (!compositor)
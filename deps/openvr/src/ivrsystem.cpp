@@ -1,5 +1,7 @@
 #include <ivrsystem.h>
 #include <openvr-util.h>
+#include <null-runtime.h>
+#include <defines.h>
 
 #include <array>
 #include <node.h>
@@ -52,6 +54,7 @@ NAN_MODULE_INIT(IVRSystem::Init)
   /// virtual bool IsTrackedDeviceConnected( vr::TrackedDeviceIndex_t unDeviceIndex ) = 0;
   /// virtual bool GetBoolTrackedDeviceProperty( vr::TrackedDeviceIndex_t unDeviceIndex, ETrackedDeviceProperty prop, ETrackedPropertyError *pError = 0L ) = 0;
   /// virtual float GetFloatTrackedDeviceProperty( vr::TrackedDeviceIndex_t unDeviceIndex, ETrackedDeviceProperty prop, ETrackedPropertyError *pError = 0L ) = 0;
+  Nan::SetPrototypeMethod(tpl, "GetFloatTrackedDeviceProperty", GetFloatTrackedDeviceProperty);
   /// virtual int32_t GetInt32TrackedDeviceProperty( vr::TrackedDeviceIndex_t unDeviceIndex, ETrackedDeviceProperty prop, ETrackedPropertyError *pError = 0L ) = 0;
   /// virtual uint64_t GetUint64TrackedDeviceProperty( vr::TrackedDeviceIndex_t unDeviceIndex, ETrackedDeviceProperty prop, ETrackedPropertyError *pError = 0L ) = 0;
   /// virtual HmdMatrix34_t GetMatrix34TrackedDeviceProperty( vr::TrackedDeviceIndex_t unDeviceIndex, ETrackedDeviceProperty prop, ETrackedPropertyError *pError = 0L ) = 0;
@@ -133,7 +136,7 @@ NAN_METHOD(IVRSystem::GetRecommendedRenderTargetSize)
   }
 
   uint32_t nWidth, nHeight;
-  obj->self_->GetRecommendedRenderTargetSize(&nWidth, &nHeight);
+  VR_CALL(obj->self_, GetRecommendedRenderTargetSize, &nWidth, &nHeight);
 
   Local<Object> result = Nan::New<Object>();
   {
@@ -192,14 +195,12 @@ NAN_METHOD(IVRSystem::GetProjectionMatrix)
   vr::EVREye eEye = static_cast<vr::EVREye>(nEye);
   float fNearZ = static_cast<float>(info[1]->NumberValue());
   float fFarZ = static_cast<float>(info[2]->NumberValue());
-  vr::HmdMatrix44_t matrix = obj->self_->GetProjectionMatrix(eEye, fNearZ, fFarZ);
+  vr::HmdMatrix44_t matrix = VR_CALL(obj->self_, GetProjectionMatrix, eEye, fNearZ, fFarZ);
 
   Local<Float32Array> float32Array = Local<Float32Array>::Cast(info[3]);
-  for (unsigned int v = 0; v < 4; v++) {
-    for (unsigned int u = 0; u < 4; u++) {
-      float32Array->Set(v * 4 + u, Number::New(Isolate::GetCurrent(), matrix.m[u][v]));
-    }
-  }
+  float elements[16];
+  transposeMatrix(&matrix.m[0][0], 4, elements);
+  setTypedArrayData(float32Array, elements, 16);
 }
 
 //=============================================================================
@@ -229,13 +230,11 @@ NAN_METHOD(IVRSystem::GetProjectionRaw)
 
   vr::EVREye eEye = static_cast<vr::EVREye>(nEye);
   float fLeft, fRight, fTop, fBottom;
-  obj->self_->GetProjectionRaw(eEye, &fLeft, &fRight, &fTop, &fBottom);
+  VR_CALL(obj->self_, GetProjectionRaw, eEye, &fLeft, &fRight, &fTop, &fBottom);
 
   Local<Float32Array> float32Array = Local<Float32Array>::Cast(info[1]);
-  float32Array->Set(0, Nan::New<Number>(fLeft));
-  float32Array->Set(1, Nan::New<Number>(fRight));
-  float32Array->Set(2, Nan::New<Number>(fTop));
-  float32Array->Set(3, Nan::New<Number>(fBottom));
+  const float elements[] = {fLeft, fRight, fTop, fBottom};
+  setTypedArrayData(float32Array, elements, 4);
 }
 
 //=============================================================================
@@ -244,6 +243,12 @@ NAN_METHOD(IVRSystem::ComputeDistortion)
 {
   IVRSystem* obj = ObjectWrap::Unwrap<IVRSystem>(info.Holder());
 
+  if (!obj->self_)
+  {
+    Nan::ThrowError("Not supported by the null runtime.");
+    return;
+  }
+
   if (info.Length() != 3)
   {
     Nan::ThrowError("Wrong number of arguments.");
@@ -279,6 +284,7 @@ NAN_METHOD(IVRSystem::ComputeDistortion)
   float fU = static_cast<float>(info[1]->NumberValue());
   float fV = static_cast<float>(info[2]->NumberValue());
   vr::DistortionCoordinates_t distortionCoordinates;
+  std::lock_guard<std::mutex> lock(GetVrMutex());
   bool success = obj->self_->ComputeDistortion(eEye, fU, fV, &distortionCoordinates);
 
   if (!success)
@@ -321,18 +327,12 @@ NAN_METHOD(IVRSystem::GetEyeToHeadTransform)
   }
 
   vr::EVREye eEye = static_cast<vr::EVREye>(nEye);
-  vr::HmdMatrix34_t matrix = obj->self_->GetEyeToHeadTransform(eEye);
+  vr::HmdMatrix34_t matrix = VR_CALL(obj->self_, GetEyeToHeadTransform, eEye);
 
   Local<Float32Array> float32Array = Local<Float32Array>::Cast(info[1]);
-  for (unsigned int v = 0; v < 4; v++) {
-    for (unsigned int u = 0; u < 3; u++) {
-      float32Array->Set(v * 4 + u, Number::New(Isolate::GetCurrent(), matrix.m[u][v]));
-    }
-  }
-  float32Array->Set(0 * 4 + 3, Number::New(Isolate::GetCurrent(), 0));
-  float32Array->Set(1 * 4 + 3, Number::New(Isolate::GetCurrent(), 0));
-  float32Array->Set(2 * 4 + 3, Number::New(Isolate::GetCurrent(), 0));
-  float32Array->Set(3 * 4 + 3, Number::New(Isolate::GetCurrent(), 1));
+  float elements[16];
+  transposeMatrix(&matrix.m[0][0], 3, elements);
+  setTypedArrayData(float32Array, elements, 16);
 }
 
 //=============================================================================
@@ -349,7 +349,7 @@ NAN_METHOD(IVRSystem::GetTimeSinceLastVsync)
 
   float fSecondsSinceLastVsync;
   uint64_t ulFrameCounter;
-  obj->self_->GetTimeSinceLastVsync(&fSecondsSinceLastVsync, &ulFrameCounter);
+  VR_CALL(obj->self_, GetTimeSinceLastVsync, &fSecondsSinceLastVsync, &ulFrameCounter);
 
   Local<Object> result = Nan::New<Object>();
   {
@@ -370,12 +370,19 @@ NAN_METHOD(IVRSystem::GetD3D9AdapterIndex)
 {
   IVRSystem* obj = ObjectWrap::Unwrap<IVRSystem>(info.Holder());
 
+  if (!obj->self_)
+  {
+    Nan::ThrowError("Not supported by the null runtime.");
+    return;
+  }
+
   if (info.Length() != 0)
   {
     Nan::ThrowError("Wrong number of arguments.");
     return;
   }
 
+  std::lock_guard<std::mutex> lock(GetVrMutex());
   uint32_t uIndex = obj->self_->GetD3D9AdapterIndex();
   info.GetReturnValue().Set(Nan::New<Number>(uIndex));
 }
@@ -386,6 +393,12 @@ NAN_METHOD(IVRSystem::GetDXGIOutputInfo)
 {
   IVRSystem* obj = ObjectWrap::Unwrap<IVRSystem>(info.Holder());
 
+  if (!obj->self_)
+  {
+    Nan::ThrowError("Not supported by the null runtime.");
+    return;
+  }
+
   if (info.Length() != 0)
   {
     Nan::ThrowError("Wrong number of arguments.");
@@ -393,6 +406,7 @@ NAN_METHOD(IVRSystem::GetDXGIOutputInfo)
   }
 
   int32_t nAdapterIndex;
+  std::lock_guard<std::mutex> lock(GetVrMutex());
   obj->self_->GetDXGIOutputInfo(&nAdapterIndex);
   info.GetReturnValue().Set(Nan::New<Number>(nAdapterIndex));
 }
@@ -403,12 +417,19 @@ NAN_METHOD(IVRSystem::IsDisplayOnDesktop)
 {
   IVRSystem* obj = ObjectWrap::Unwrap<IVRSystem>(info.Holder());
 
+  if (!obj->self_)
+  {
+    Nan::ThrowError("Not supported by the null runtime.");
+    return;
+  }
+
   if (info.Length() != 0)
   {
     Nan::ThrowError("Wrong number of arguments.");
     return;
   }
 
+  std::lock_guard<std::mutex> lock(GetVrMutex());
   bool bIsVisibleOnDesktop = obj->self_->IsDisplayOnDesktop();
   info.GetReturnValue().Set(Nan::New<Boolean>(bIsVisibleOnDesktop));
 }
@@ -419,6 +440,12 @@ NAN_METHOD(IVRSystem::SetDisplayVisibility)
 {
   IVRSystem* obj = ObjectWrap::Unwrap<IVRSystem>(info.Holder());
 
+  if (!obj->self_)
+  {
+    Nan::ThrowError("Not supported by the null runtime.");
+    return;
+  }
+
   if (info.Length() != 1)
   {
     Nan::ThrowError("Wrong number of arguments.");
@@ -432,6 +459,7 @@ NAN_METHOD(IVRSystem::SetDisplayVisibility)
   }
 
   bool bIsVisibleOnDesktop = info[0]->BooleanValue();
+  std::lock_guard<std::mutex> lock(GetVrMutex());
   bool bSuccess = obj->self_->SetDisplayVisibility(bIsVisibleOnDesktop);
   info.GetReturnValue().Set(Nan::New<Boolean>(bSuccess));
 }
@@ -470,14 +498,14 @@ NAN_METHOD(IVRSystem::GetDeviceToAbsoluteTrackingPose)
   vr::ETrackingUniverseOrigin eOrigin = static_cast<vr::ETrackingUniverseOrigin>(nOrigin);
 
   float fSecondsSinceLastVsync;
-  obj->self_->GetTimeSinceLastVsync( &fSecondsSinceLastVsync, NULL );
-  const float fDisplayFrequency = obj->self_->GetFloatTrackedDeviceProperty( vr::k_unTrackedDeviceIndex_Hmd, vr::Prop_DisplayFrequency_Float );
+  VR_CALL(obj->self_, GetTimeSinceLastVsync, &fSecondsSinceLastVsync, NULL );
+  const float fDisplayFrequency = VR_CALL(obj->self_, GetFloatTrackedDeviceProperty, vr::k_unTrackedDeviceIndex_Hmd, vr::Prop_DisplayFrequency_Float );
   const float fFrameDuration = 1.f / fDisplayFrequency;
-  const float fVsyncToPhotons = obj->self_->GetFloatTrackedDeviceProperty( vr::k_unTrackedDeviceIndex_Hmd, vr::Prop_SecondsFromVsyncToPhotons_Float );
+  const float fVsyncToPhotons = VR_CALL(obj->self_, GetFloatTrackedDeviceProperty, vr::k_unTrackedDeviceIndex_Hmd, vr::Prop_SecondsFromVsyncToPhotons_Float );
   const float fPredictedSecondsToPhotonsFromNow = fFrameDuration - fSecondsSinceLastVsync + fVsyncToPhotons;
 
   TrackedDevicePoseArray trackedDevicePoseArray;
-  obj->self_->GetDeviceToAbsoluteTrackingPose(
+  VR_CALL(obj->self_, GetDeviceToAbsoluteTrackingPose,
     eOrigin, fPredictedSecondsToPhotonsFromNow, trackedDevicePoseArray.data(),
     static_cast<uint32_t>(trackedDevicePoseArray.size())
   );
@@ -485,52 +513,38 @@ NAN_METHOD(IVRSystem::GetDeviceToAbsoluteTrackingPose)
   Local<Float32Array> hmdFloat32Array = Local<Float32Array>::Cast(info[1]);
   Local<Float32Array> leftControllerFloat32Array = Local<Float32Array>::Cast(info[2]);
   Local<Float32Array> rightControllerFloat32Array = Local<Float32Array>::Cast(info[3]);
-  hmdFloat32Array->Set(0, Number::New(Isolate::GetCurrent(), std::numeric_limits<float>::quiet_NaN()));
-  leftControllerFloat32Array->Set(0, Number::New(Isolate::GetCurrent(), std::numeric_limits<float>::quiet_NaN()));
-  rightControllerFloat32Array->Set(0, Number::New(Isolate::GetCurrent(), std::numeric_limits<float>::quiet_NaN()));
+  if (hmdFloat32Array->Length() < 16 || leftControllerFloat32Array->Length() < 16 || rightControllerFloat32Array->Length() < 16)
+  {
+    Nan::ThrowTypeError("Arguments[1-3] must have 16 elements.");
+    return;
+  }
+
+  obj->WritePoses(
+    trackedDevicePoseArray.data(), static_cast<uint32_t>(trackedDevicePoseArray.size()),
+    getTypedArrayData(hmdFloat32Array), getTypedArrayData(leftControllerFloat32Array), getTypedArrayData(rightControllerFloat32Array)
+  );
+}
+
+//=============================================================================
+void IVRSystem::WritePoses(const vr::TrackedDevicePose_t *poses, uint32_t numPoses, float *hmd, float *leftController, float *rightController)
+{
+  hmd[0] = std::numeric_limits<float>::quiet_NaN();
+  leftController[0] = std::numeric_limits<float>::quiet_NaN();
+  rightController[0] = std::numeric_limits<float>::quiet_NaN();
 
-  for (unsigned int i = 0; i < trackedDevicePoseArray.size(); i++) {
-    const vr::TrackedDevicePose_t &trackedDevicePose = trackedDevicePoseArray[i];
+  for (uint32_t i = 0; i < numPoses; i++) {
+    const vr::TrackedDevicePose_t &trackedDevicePose = poses[i];
     if (trackedDevicePose.bPoseIsValid) {
-      const vr::ETrackedDeviceClass deviceClass = obj->self_->GetTrackedDeviceClass(i);
+      const vr::ETrackedDeviceClass deviceClass = VR_CALL(self_, GetTrackedDeviceClass, i);
+      const vr::HmdMatrix34_t &matrix = trackedDevicePose.mDeviceToAbsoluteTracking;
       if (deviceClass == vr::TrackedDeviceClass_HMD) {
-        const vr::HmdMatrix34_t &matrix = trackedDevicePose.mDeviceToAbsoluteTracking;
-
-        for (unsigned int v = 0; v < 4; v++) {
-          for (unsigned int u = 0; u < 3; u++) {
-            hmdFloat32Array->Set(v * 4 + u, Number::New(Isolate::GetCurrent(), matrix.m[u][v]));
-          }
-        }
-        hmdFloat32Array->Set(0 * 4 + 3, Number::New(Isolate::GetCurrent(), 0));
-        hmdFloat32Array->Set(1 * 4 + 3, Number::New(Isolate::GetCurrent(), 0));
-        hmdFloat32Array->Set(2 * 4 + 3, Number::New(Isolate::GetCurrent(), 0));
-        hmdFloat32Array->Set(3 * 4 + 3, Number::New(Isolate::GetCurrent(), 1));
+        transposeMatrix(&matrix.m[0][0], 3, hmd);
       } else if (deviceClass == vr::TrackedDeviceClass_Controller) {
-        const vr::ETrackedControllerRole controllerRole = obj->self_->GetControllerRoleForTrackedDeviceIndex(i);
+        const vr::ETrackedControllerRole controllerRole = VR_CALL(self_, GetControllerRoleForTrackedDeviceIndex, i);
         if (controllerRole == vr::TrackedControllerRole_LeftHand) {
-          const vr::HmdMatrix34_t &matrix = trackedDevicePose.mDeviceToAbsoluteTracking;
-
-          for (unsigned int v = 0; v < 4; v++) {
-            for (unsigned int u = 0; u < 3; u++) {
-              leftControllerFloat32Array->Set(v * 4 + u, Number::New(Isolate::GetCurrent(), matrix.m[u][v]));
-            }
-          }
-          leftControllerFloat32Array->Set(0 * 4 + 3, Number::New(Isolate::GetCurrent(), 0));
-          leftControllerFloat32Array->Set(1 * 4 + 3, Number::New(Isolate::GetCurrent(), 0));
-          leftControllerFloat32Array->Set(2 * 4 + 3, Number::New(Isolate::GetCurrent(), 0));
-          leftControllerFloat32Array->Set(3 * 4 + 3, Number::New(Isolate::GetCurrent(), 1));
-        } else if (controllerRole == vr::TrackedControllerRole_LeftHand) {
-          const vr::HmdMatrix34_t &matrix = trackedDevicePose.mDeviceToAbsoluteTracking;
-
-          for (unsigned int v = 0; v < 4; v++) {
-            for (unsigned int u = 0; u < 3; u++) {
-              rightControllerFloat32Array->Set(v * 4 + u, Number::New(Isolate::GetCurrent(), matrix.m[u][v]));
-            }
-          }
-          rightControllerFloat32Array->Set(0 * 4 + 3, Number::New(Isolate::GetCurrent(), 0));
-          rightControllerFloat32Array->Set(1 * 4 + 3, Number::New(Isolate::GetCurrent(), 0));
-          rightControllerFloat32Array->Set(2 * 4 + 3, Number::New(Isolate::GetCurrent(), 0));
-          rightControllerFloat32Array->Set(3 * 4 + 3, Number::New(Isolate::GetCurrent(), 1));
+          transposeMatrix(&matrix.m[0][0], 3, leftController);
+        } else if (controllerRole == vr::TrackedControllerRole_RightHand) {
+          transposeMatrix(&matrix.m[0][0], 3, rightController);
         }
       }
     }
@@ -549,7 +563,11 @@ NAN_METHOD(IVRSystem::ResetSeatedZeroPose)
     return;
   }
 
-  obj->self_->ResetSeatedZeroPose();
+  if (obj->self_)
+  {
+    std::lock_guard<std::mutex> lock(GetVrMutex());
+    obj->self_->ResetSeatedZeroPose();
+  }
 }
 
 //=============================================================================
@@ -570,17 +588,11 @@ NAN_METHOD(IVRSystem::GetSeatedZeroPoseToStandingAbsoluteTrackingPose)
     return;
   }
 
-  const vr::HmdMatrix34_t &matrix = obj->self_->GetSeatedZeroPoseToStandingAbsoluteTrackingPose();
+  const vr::HmdMatrix34_t matrix = VR_CALL(obj->self_, GetSeatedZeroPoseToStandingAbsoluteTrackingPose);
   Local<Float32Array> float32Array = Local<Float32Array>::Cast(info[0]);
-  for (unsigned int v = 0; v < 4; v++) {
-    for (unsigned int u = 0; u < 3; u++) {
-      float32Array->Set(v * 4 + u, Number::New(Isolate::GetCurrent(), matrix.m[u][v]));
-    }
-  }
-  float32Array->Set(0 * 4 + 3, Number::New(Isolate::GetCurrent(), 0));
-  float32Array->Set(1 * 4 + 3, Number::New(Isolate::GetCurrent(), 0));
-  float32Array->Set(2 * 4 + 3, Number::New(Isolate::GetCurrent(), 0));
-  float32Array->Set(3 * 4 + 3, Number::New(Isolate::GetCurrent(), 1));
+  float elements[16];
+  transposeMatrix(&matrix.m[0][0], 3, elements);
+  setTypedArrayData(float32Array, elements, 16);
 }
 
 //=============================================================================
@@ -595,7 +607,7 @@ NAN_METHOD(IVRSystem::GetRawZeroPoseToStandingAbsoluteTrackingPose)
     return;
   }
 
-  vr::HmdMatrix34_t matrix = obj->self_->GetRawZeroPoseToStandingAbsoluteTrackingPose();
+  vr::HmdMatrix34_t matrix = VR_CALL(obj->self_, GetRawZeroPoseToStandingAbsoluteTrackingPose);
   info.GetReturnValue().Set(encode(matrix));
 }
 
@@ -605,6 +617,12 @@ NAN_METHOD(IVRSystem::GetSortedTrackedDeviceIndicesOfClass)
 {
   IVRSystem* obj = ObjectWrap::Unwrap<IVRSystem>(info.Holder());
 
+  if (!obj->self_)
+  {
+    Nan::ThrowError("Not supported by the null runtime.");
+    return;
+  }
+
   if (info.Length() < 1 || info.Length() > 2)
   {
     Nan::ThrowError("Wrong number of arguments.");
@@ -641,6 +659,7 @@ NAN_METHOD(IVRSystem::GetSortedTrackedDeviceIndicesOfClass)
   vr::ETrackedDeviceClass eTrackedDeviceClass =
     static_cast<vr::ETrackedDeviceClass>(nTrackedDeviceClass);
   TrackedDeviceIndexArray trackedDeviceIndexArray;
+  std::lock_guard<std::mutex> lock(GetVrMutex());
   uint32_t nDeviceIndices = obj->self_->GetSortedTrackedDeviceIndicesOfClass(
     eTrackedDeviceClass, trackedDeviceIndexArray.data(),
     static_cast<uint32_t>(trackedDeviceIndexArray.size()),
@@ -650,12 +669,48 @@ NAN_METHOD(IVRSystem::GetSortedTrackedDeviceIndicesOfClass)
   info.GetReturnValue().Set(encode<(uint32_t)vr::k_unMaxTrackedDeviceCount>(trackedDeviceIndexArray, nDeviceIndices));
 }
 
+//=============================================================================
+/// virtual float GetFloatTrackedDeviceProperty( vr::TrackedDeviceIndex_t unDeviceIndex, ETrackedDeviceProperty prop, ETrackedPropertyError *pError = 0L ) = 0;
+NAN_METHOD(IVRSystem::GetFloatTrackedDeviceProperty)
+{
+  IVRSystem* obj = ObjectWrap::Unwrap<IVRSystem>(info.Holder());
+
+  if (info.Length() != 2)
+  {
+    Nan::ThrowError("Wrong number of arguments.");
+    return;
+  }
+
+  if (!info[0]->IsNumber() || !info[1]->IsNumber())
+  {
+    Nan::ThrowTypeError("Arguments[0-1] must be numbers.");
+    return;
+  }
+
+  uint32_t unDeviceIndex = info[0]->Uint32Value();
+  vr::ETrackedDeviceProperty prop = static_cast<vr::ETrackedDeviceProperty>(info[1]->Int32Value());
+  vr::ETrackedPropertyError error = vr::TrackedProp_Success;
+  const float value = VR_CALL(obj->self_, GetFloatTrackedDeviceProperty, unDeviceIndex, prop, &error);
+
+  // unknown properties read as undefined rather than OpenVR's 0
+  if (error == vr::TrackedProp_Success)
+  {
+    info.GetReturnValue().Set(Nan::New<Number>(value));
+  }
+}
+
 //=============================================================================
 /// virtual EDeviceActivityLevel GetTrackedDeviceActivityLevel( vr::TrackedDeviceIndex_t unDeviceId ) = 0;
 NAN_METHOD(IVRSystem::GetTrackedDeviceActivityLevel)
 {
   IVRSystem* obj = ObjectWrap::Unwrap<IVRSystem>(info.Holder());
 
+  if (!obj->self_)
+  {
+    Nan::ThrowError("Not supported by the null runtime.");
+    return;
+  }
+
   if (info.Length() != 1)
   {
     Nan::ThrowError("Wrong number of arguments.");
@@ -669,6 +724,7 @@ NAN_METHOD(IVRSystem::GetTrackedDeviceActivityLevel)
   }
 
   uint32_t unDeviceId = info[0]->Uint32Value();
+  std::lock_guard<std::mutex> lock(GetVrMutex());
   vr::EDeviceActivityLevel deviceActivityLevel =
     obj->self_->GetTrackedDeviceActivityLevel(unDeviceId);
   info.GetReturnValue().Set(Nan::New<Number>(
@@ -681,6 +737,12 @@ NAN_METHOD(IVRSystem::ApplyTransform)
 {
   IVRSystem* obj = ObjectWrap::Unwrap<IVRSystem>(info.Holder());
 
+  if (!obj->self_)
+  {
+    Nan::ThrowError("Not supported by the null runtime.");
+    return;
+  }
+
   if (info.Length() != 2)
   {
     Nan::ThrowError("Wrong number of arguments.");
@@ -702,6 +764,7 @@ NAN_METHOD(IVRSystem::ApplyTransform)
   const auto trackedDevicePose = decode<vr::TrackedDevicePose_t>(info[0]);
   const auto transform = decode<vr::HmdMatrix34_t>(info[1]);
   vr::TrackedDevicePose_t outputPose;
+  std::lock_guard<std::mutex> lock(GetVrMutex());
   obj->self_->ApplyTransform(&outputPose, &trackedDevicePose, &transform);
   info.GetReturnValue().Set(encode(outputPose));
 }
@@ -722,7 +785,7 @@ NAN_METHOD(IVRSystem::GetTrackedDeviceIndexForControllerRole)
   }
 
   vr::ETrackedControllerRole role = static_cast<vr::ETrackedControllerRole>(info[0]->Uint32Value());
-  vr::TrackedDeviceIndex_t deviceClass = obj->self_->GetTrackedDeviceIndexForControllerRole(role);
+  vr::TrackedDeviceIndex_t deviceClass = VR_CALL(obj->self_, GetTrackedDeviceIndexForControllerRole, role);
   info.GetReturnValue().Set(Nan::New<Number>(
     static_cast<uint32_t>(deviceClass)));
 }
@@ -747,7 +810,7 @@ NAN_METHOD(IVRSystem::GetTrackedDeviceClass)
 
   uint32_t unDeviceIndex = info[0]->Uint32Value();
   vr::ETrackedDeviceClass trackedDeviceClass =
-    obj->self_->GetTrackedDeviceClass(unDeviceIndex);
+    VR_CALL(obj->self_, GetTrackedDeviceClass, unDeviceIndex);
   info.GetReturnValue().Set(Nan::New<Number>(
     static_cast<uint32_t>(trackedDeviceClass)));
 }
@@ -774,47 +837,62 @@ NAN_METHOD(IVRSystem::GetControllerState)
     return;
   }
 
-  Local<Float32Array> buttons = Local<Float32Array>::Cast(info[1]);
-  buttons->Set(0, Number::New(Isolate::GetCurrent(), std::numeric_limits<float>::quiet_NaN()));
+  Local<Float32Array> buttonsFloat32Array = Local<Float32Array>::Cast(info[1]);
+  float buttons[CONTROLLER_STATE_SIZE];
+  buttons[0] = std::numeric_limits<float>::quiet_NaN();
+  size_t numButtons = 1;
 
   uint32_t side = info[0]->Uint32Value();
   for (unsigned int i = 0; i < vr::k_unMaxTrackedDeviceCount; i++) {
-    vr::ETrackedDeviceClass deviceClass = obj->self_->GetTrackedDeviceClass(i);
+    vr::ETrackedDeviceClass deviceClass = VR_CALL(obj->self_, GetTrackedDeviceClass, i);
     if (deviceClass == vr::TrackedDeviceClass_Controller) {
-      const vr::ETrackedControllerRole controllerRole = obj->self_->GetControllerRoleForTrackedDeviceIndex(i);
+      const vr::ETrackedControllerRole controllerRole = VR_CALL(obj->self_, GetControllerRoleForTrackedDeviceIndex, i);
       if ((side == 0 && controllerRole == vr::TrackedControllerRole_LeftHand) || (side == 1 && controllerRole == vr::TrackedControllerRole_RightHand)) {
-        vr::VRControllerState_t controllerState;
-        if (obj->self_->GetControllerState(i, &controllerState, sizeof(controllerState))) {
-          buttons->Set(0, Number::New(Isolate::GetCurrent(), 1));
-
-          buttons->Set(1, Number::New(Isolate::GetCurrent(), (controllerState.ulButtonPressed & vr::ButtonMaskFromId(vr::k_EButton_System)) ? 1 : 0));
-          buttons->Set(2, Number::New(Isolate::GetCurrent(), (controllerState.ulButtonPressed & vr::ButtonMaskFromId(vr::k_EButton_ApplicationMenu)) ? 1 : 0));
-          buttons->Set(3, Number::New(Isolate::GetCurrent(), (controllerState.ulButtonPressed & vr::ButtonMaskFromId(vr::k_EButton_Grip)) ? 1 : 0));
-          buttons->Set(4, Number::New(Isolate::GetCurrent(), (controllerState.ulButtonPressed & vr::ButtonMaskFromId(vr::k_EButton_SteamVR_Touchpad)) ? 1 : 0));
-          buttons->Set(5, Number::New(Isolate::GetCurrent(), (controllerState.ulButtonPressed & vr::ButtonMaskFromId(vr::k_EButton_SteamVR_Trigger)) ? 1 : 0));
-
-          buttons->Set(6, Number::New(Isolate::GetCurrent(), (controllerState.ulButtonTouched & vr::ButtonMaskFromId(vr::k_EButton_System)) ? 1 : 0));
-          buttons->Set(7, Number::New(Isolate::GetCurrent(), (controllerState.ulButtonTouched & vr::ButtonMaskFromId(vr::k_EButton_ApplicationMenu)) ? 1 : 0));
-          buttons->Set(8, Number::New(Isolate::GetCurrent(), (controllerState.ulButtonTouched & vr::ButtonMaskFromId(vr::k_EButton_Grip)) ? 1 : 0));
-          buttons->Set(9, Number::New(Isolate::GetCurrent(), (controllerState.ulButtonTouched & vr::ButtonMaskFromId(vr::k_EButton_SteamVR_Touchpad)) ? 1 : 0));
-          buttons->Set(10, Number::New(Isolate::GetCurrent(), (controllerState.ulButtonTouched & vr::ButtonMaskFromId(vr::k_EButton_SteamVR_Trigger)) ? 1 : 0));
-
-          buttons->Set(11, Number::New(Isolate::GetCurrent(), controllerState.rAxis[0].x));
-          buttons->Set(12, Number::New(Isolate::GetCurrent(), controllerState.rAxis[0].y));
-          buttons->Set(13, Number::New(Isolate::GetCurrent(), controllerState.rAxis[1].x));
-          buttons->Set(14, Number::New(Isolate::GetCurrent(), controllerState.rAxis[1].y));
-          buttons->Set(15, Number::New(Isolate::GetCurrent(), controllerState.rAxis[2].x));
-          buttons->Set(16, Number::New(Isolate::GetCurrent(), controllerState.rAxis[2].y));
-          buttons->Set(17, Number::New(Isolate::GetCurrent(), controllerState.rAxis[3].x));
-          buttons->Set(18, Number::New(Isolate::GetCurrent(), controllerState.rAxis[3].y));
-          buttons->Set(19, Number::New(Isolate::GetCurrent(), controllerState.rAxis[4].x));
-          buttons->Set(20, Number::New(Isolate::GetCurrent(), controllerState.rAxis[4].y));
-
+        if (obj->WriteControllerState(i, buttons)) {
+          numButtons = CONTROLLER_STATE_SIZE;
           break;
         }
       }
     }
   }
+
+  setTypedArrayData(buttonsFloat32Array, buttons, numButtons);
+}
+
+//=============================================================================
+bool IVRSystem::WriteControllerState(uint32_t index, float *buttons)
+{
+  vr::VRControllerState_t controllerState;
+  if (!VR_CALL(self_, GetControllerState, index, &controllerState, sizeof(controllerState))) {
+    return false;
+  }
+
+  buttons[0] = 1;
+
+  buttons[1] = (controllerState.ulButtonPressed & vr::ButtonMaskFromId(vr::k_EButton_System)) ? 1 : 0;
+  buttons[2] = (controllerState.ulButtonPressed & vr::ButtonMaskFromId(vr::k_EButton_ApplicationMenu)) ? 1 : 0;
+  buttons[3] = (controllerState.ulButtonPressed & vr::ButtonMaskFromId(vr::k_EButton_Grip)) ? 1 : 0;
+  buttons[4] = (controllerState.ulButtonPressed & vr::ButtonMaskFromId(vr::k_EButton_SteamVR_Touchpad)) ? 1 : 0;
+  buttons[5] = (controllerState.ulButtonPressed & vr::ButtonMaskFromId(vr::k_EButton_SteamVR_Trigger)) ? 1 : 0;
+
+  buttons[6] = (controllerState.ulButtonTouched & vr::ButtonMaskFromId(vr::k_EButton_System)) ? 1 : 0;
+  buttons[7] = (controllerState.ulButtonTouched & vr::ButtonMaskFromId(vr::k_EButton_ApplicationMenu)) ? 1 : 0;
+  buttons[8] = (controllerState.ulButtonTouched & vr::ButtonMaskFromId(vr::k_EButton_Grip)) ? 1 : 0;
+  buttons[9] = (controllerState.ulButtonTouched & vr::ButtonMaskFromId(vr::k_EButton_SteamVR_Touchpad)) ? 1 : 0;
+  buttons[10] = (controllerState.ulButtonTouched & vr::ButtonMaskFromId(vr::k_EButton_SteamVR_Trigger)) ? 1 : 0;
+
+  buttons[11] = controllerState.rAxis[0].x;
+  buttons[12] = controllerState.rAxis[0].y;
+  buttons[13] = controllerState.rAxis[1].x;
+  buttons[14] = controllerState.rAxis[1].y;
+  buttons[15] = controllerState.rAxis[2].x;
+  buttons[16] = controllerState.rAxis[2].y;
+  buttons[17] = controllerState.rAxis[3].x;
+  buttons[18] = controllerState.rAxis[3].y;
+  buttons[19] = controllerState.rAxis[4].x;
+  buttons[20] = controllerState.rAxis[4].y;
+
+  return true;
 }
 
 NAN_METHOD(IVRSystem::TriggerHapticPulse)
@@ -846,7 +924,7 @@ NAN_METHOD(IVRSystem::TriggerHapticPulse)
   uint32_t unAxisId = info[1]->Uint32Value();
   unsigned short usDurationMicroSec  = info[2]->Uint32Value();
 
-  obj->self_->TriggerHapticPulse(unControllerDeviceIndex, unAxisId, usDurationMicroSec);
+  VR_CALL(obj->self_, TriggerHapticPulse, unControllerDeviceIndex, unAxisId, usDurationMicroSec);
 }
 
 //=============================================================================
@@ -902,12 +980,19 @@ NAN_METHOD(IVRSystem::AcknowledgeQuit_Exiting)
 {
   IVRSystem* obj = ObjectWrap::Unwrap<IVRSystem>(info.Holder());
 
+  if (!obj->self_)
+  {
+    Nan::ThrowError("Not supported by the null runtime.");
+    return;
+  }
+
   if (info.Length() != 0)
   {
     Nan::ThrowError("Wrong number of arguments.");
     return;
   }
 
+  std::lock_guard<std::mutex> lock(GetVrMutex());
   obj->self_->AcknowledgeQuit_Exiting();
 }
 
@@ -917,11 +1002,18 @@ NAN_METHOD(IVRSystem::AcknowledgeQuit_UserPrompt)
 {
   IVRSystem* obj = ObjectWrap::Unwrap<IVRSystem>(info.Holder());
 
+  if (!obj->self_)
+  {
+    Nan::ThrowError("Not supported by the null runtime.");
+    return;
+  }
+
   if (info.Length() != 0)
   {
     Nan::ThrowError("Wrong number of arguments.");
     return;
   }
 
+  std::lock_guard<std::mutex> lock(GetVrMutex());
   obj->self_->AcknowledgeQuit_UserPrompt();
 }
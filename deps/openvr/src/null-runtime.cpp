@@ -0,0 +1,447 @@
+#include <null-runtime.h>
+
+#include <webgl.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <thread>
+
+namespace
+{
+bool nullRuntimeEnabled = false;
+
+/// Raw projection tangents of the left eye; the right eye mirrors them horizontally.
+constexpr float RAW_LEFT = -1.39f;
+constexpr float RAW_RIGHT = 1.25f;
+constexpr float RAW_TOP = -1.47f;
+constexpr float RAW_BOTTOM = 1.47f;
+
+constexpr float STANDING_HEIGHT = 1.6f;
+
+constexpr vr::TrackedDeviceIndex_t LEFT_CONTROLLER_INDEX = 1;
+constexpr vr::TrackedDeviceIndex_t RIGHT_CONTROLLER_INDEX = 2;
+
+void setRigid(vr::HmdMatrix34_t &matrix, const float rotation[3][3], float x, float y, float z)
+{
+  const float position[3] = {x, y, z};
+  for (unsigned int r = 0; r < 3; r++) {
+    for (unsigned int c = 0; c < 3; c++) {
+      matrix.m[r][c] = rotation[r][c];
+    }
+    matrix.m[r][3] = position[r];
+  }
+}
+
+vr::HmdMatrix34_t makeTranslation(float x, float y, float z)
+{
+  const float identity[3][3] = {{1, 0, 0}, {0, 1, 0}, {0, 0, 1}};
+  vr::HmdMatrix34_t matrix;
+  setRigid(matrix, identity, x, y, z);
+  return matrix;
+}
+}
+
+//=============================================================================
+NullRuntime &NullRuntime::Get()
+{
+  static NullRuntime nullRuntime;
+  return nullRuntime;
+}
+
+bool NullRuntime::IsEnabled()
+{
+  return nullRuntimeEnabled;
+}
+
+void NullRuntime::SetEnabled(bool enabled)
+{
+  nullRuntimeEnabled = enabled;
+}
+
+//=============================================================================
+std::mutex &GetVrMutex()
+{
+  static std::mutex vrMutex;
+  return vrMutex;
+}
+
+NullRuntime::NullRuntime()
+: frames(0), submits(0), missedFrames(0), started(false), vsyncCount(0), mirrorContext(nullptr), mirrorFbo(0), mirrorTex(0)
+{
+  Reset();
+}
+
+/// Restarts the simulated clock and clears the stats. The mirror target is kept.
+void NullRuntime::Reset()
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  started = false;
+  vsyncCount = 0;
+  frames = 0;
+  submits = 0;
+  missedFrames = 0;
+  memset(frameTimings, 0, sizeof(frameTimings));
+  memset(&cumulativeStats, 0, sizeof(cumulativeStats));
+}
+
+double NullRuntime::GetTime(Clock::time_point time) const
+{
+  return started ? std::chrono::duration<double>(time - startTime).count() : 0;
+}
+
+//=============================================================================
+void NullRuntime::GetRecommendedRenderTargetSize(uint32_t *pnWidth, uint32_t *pnHeight)
+{
+  *pnWidth = RENDER_WIDTH;
+  *pnHeight = RENDER_HEIGHT;
+}
+
+vr::HmdMatrix44_t NullRuntime::GetProjectionMatrix(vr::EVREye eEye, float fNearZ, float fFarZ)
+{
+  float left, right, top, bottom;
+  GetProjectionRaw(eEye, &left, &right, &top, &bottom);
+
+  const float idx = 1.0f / (right - left);
+  const float idy = 1.0f / (bottom - top);
+  const float idz = 1.0f / (fFarZ - fNearZ);
+
+  vr::HmdMatrix44_t matrix;
+  memset(&matrix, 0, sizeof(matrix));
+  matrix.m[0][0] = 2 * idx;
+  matrix.m[0][2] = (right + left) * idx;
+  matrix.m[1][1] = 2 * idy;
+  matrix.m[1][2] = (bottom + top) * idy;
+  matrix.m[2][2] = -(fFarZ + fNearZ) * idz;
+  matrix.m[2][3] = -2 * fFarZ * fNearZ * idz;
+  matrix.m[3][2] = -1;
+  return matrix;
+}
+
+void NullRuntime::GetProjectionRaw(vr::EVREye eEye, float *pfLeft, float *pfRight, float *pfTop, float *pfBottom)
+{
+  *pfLeft = eEye == vr::Eye_Left ? RAW_LEFT : -RAW_RIGHT;
+  *pfRight = eEye == vr::Eye_Left ? RAW_RIGHT : -RAW_LEFT;
+  *pfTop = RAW_TOP;
+  *pfBottom = RAW_BOTTOM;
+}
+
+vr::HmdMatrix34_t NullRuntime::GetEyeToHeadTransform(vr::EVREye eEye)
+{
+  return makeTranslation(eEye == vr::Eye_Left ? -IPD / 2 : IPD / 2, 0, 0);
+}
+
+bool NullRuntime::GetTimeSinceLastVsync(float *pfSecondsSinceLastVsync, uint64_t *pulFrameCounter)
+{
+  double t;
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    t = GetTime(Clock::now());
+  }
+  const double vsync = std::floor(t * FRAME_RATE);
+  *pfSecondsSinceLastVsync = static_cast<float>(t - vsync / FRAME_RATE);
+  if (pulFrameCounter) {
+    *pulFrameCounter = static_cast<uint64_t>(vsync);
+  }
+  return true;
+}
+
+float NullRuntime::GetFloatTrackedDeviceProperty(vr::TrackedDeviceIndex_t unDeviceIndex, vr::ETrackedDeviceProperty prop, vr::ETrackedPropertyError *pError)
+{
+  vr::ETrackedPropertyError error = vr::TrackedProp_Success;
+  float result = 0;
+  if (unDeviceIndex != vr::k_unTrackedDeviceIndex_Hmd) {
+    error = vr::TrackedProp_UnknownProperty;
+  } else if (prop == vr::Prop_UserIpdMeters_Float) {
+    result = IPD;
+  } else if (prop == vr::Prop_DisplayFrequency_Float) {
+    result = FRAME_RATE;
+  } else if (prop == vr::Prop_SecondsFromVsyncToPhotons_Float) {
+    result = VSYNC_TO_PHOTONS;
+  } else {
+    error = vr::TrackedProp_UnknownProperty;
+  }
+
+  if (pError) {
+    *pError = error;
+  }
+  return result;
+}
+
+//=============================================================================
+/// The headset sways and turns its head slowly; the controllers are held out in front and bob up and down.
+void NullRuntime::GetDevicePose(vr::TrackedDeviceIndex_t unDeviceIndex, double t, vr::TrackedDevicePose_t *pose)
+{
+  memset(pose, 0, sizeof(*pose));
+
+  if (unDeviceIndex == vr::k_unTrackedDeviceIndex_Hmd) {
+    const float yaw = 0.3f * std::sin(t * 0.5);
+    const float c = std::cos(yaw), s = std::sin(yaw);
+    const float rotation[3][3] = {{c, 0, s}, {0, 1, 0}, {-s, 0, c}};
+    setRigid(pose->mDeviceToAbsoluteTracking, rotation, 0.05f * std::sin(t * 0.5), STANDING_HEIGHT + 0.01f * std::sin(t * 2), 0);
+  } else if (unDeviceIndex == LEFT_CONTROLLER_INDEX || unDeviceIndex == RIGHT_CONTROLLER_INDEX) {
+    const float side = unDeviceIndex == LEFT_CONTROLLER_INDEX ? -1 : 1;
+    const float pitch = -0.3f + 0.2f * std::sin(t + side);
+    const float c = std::cos(pitch), s = std::sin(pitch);
+    const float rotation[3][3] = {{1, 0, 0}, {0, c, -s}, {0, s, c}};
+    setRigid(pose->mDeviceToAbsoluteTracking, rotation, side * 0.25f + 0.05f * std::sin(t), 1.2f + 0.05f * std::sin(t * 2 + side), -0.4f);
+  } else {
+    pose->eTrackingResult = vr::TrackingResult_Uninitialized;
+    return;
+  }
+
+  pose->eTrackingResult = vr::TrackingResult_Running_OK;
+  pose->bPoseIsValid = true;
+  pose->bDeviceIsConnected = true;
+}
+
+void NullRuntime::GetDeviceToAbsoluteTrackingPose(vr::ETrackingUniverseOrigin eOrigin, float fPredictedSecondsToPhotonsFromNow, vr::TrackedDevicePose_t *pTrackedDevicePoseArray, uint32_t unTrackedDevicePoseArrayCount)
+{
+  double t;
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    t = GetTime(Clock::now()) + fPredictedSecondsToPhotonsFromNow;
+  }
+  for (uint32_t i = 0; i < unTrackedDevicePoseArrayCount; i++) {
+    GetDevicePose(i, t, &pTrackedDevicePoseArray[i]);
+    if (eOrigin == vr::TrackingUniverseSeated) {
+      pTrackedDevicePoseArray[i].mDeviceToAbsoluteTracking.m[1][3] -= STANDING_HEIGHT;
+    }
+  }
+}
+
+vr::HmdMatrix34_t NullRuntime::GetSeatedZeroPoseToStandingAbsoluteTrackingPose()
+{
+  return makeTranslation(0, STANDING_HEIGHT, 0);
+}
+
+vr::HmdMatrix34_t NullRuntime::GetRawZeroPoseToStandingAbsoluteTrackingPose()
+{
+  return makeTranslation(0, 0, 0);
+}
+
+vr::TrackedDeviceIndex_t NullRuntime::GetTrackedDeviceIndexForControllerRole(vr::ETrackedControllerRole unDeviceType)
+{
+  if (unDeviceType == vr::TrackedControllerRole_LeftHand) {
+    return LEFT_CONTROLLER_INDEX;
+  } else if (unDeviceType == vr::TrackedControllerRole_RightHand) {
+    return RIGHT_CONTROLLER_INDEX;
+  } else {
+    return vr::k_unTrackedDeviceIndexInvalid;
+  }
+}
+
+vr::ETrackedControllerRole NullRuntime::GetControllerRoleForTrackedDeviceIndex(vr::TrackedDeviceIndex_t unDeviceIndex)
+{
+  if (unDeviceIndex == LEFT_CONTROLLER_INDEX) {
+    return vr::TrackedControllerRole_LeftHand;
+  } else if (unDeviceIndex == RIGHT_CONTROLLER_INDEX) {
+    return vr::TrackedControllerRole_RightHand;
+  } else {
+    return vr::TrackedControllerRole_Invalid;
+  }
+}
+
+vr::ETrackedDeviceClass NullRuntime::GetTrackedDeviceClass(vr::TrackedDeviceIndex_t unDeviceIndex)
+{
+  if (unDeviceIndex == vr::k_unTrackedDeviceIndex_Hmd) {
+    return vr::TrackedDeviceClass_HMD;
+  } else if (unDeviceIndex == LEFT_CONTROLLER_INDEX || unDeviceIndex == RIGHT_CONTROLLER_INDEX) {
+    return vr::TrackedDeviceClass_Controller;
+  } else {
+    return vr::TrackedDeviceClass_Invalid;
+  }
+}
+
+/// The thumb circles the touchpad and the trigger is squeezed and released about once every three seconds.
+bool NullRuntime::GetControllerState(vr::TrackedDeviceIndex_t unControllerDeviceIndex, vr::VRControllerState_t *pControllerState, uint32_t unControllerStateSize)
+{
+  if (GetTrackedDeviceClass(unControllerDeviceIndex) != vr::TrackedDeviceClass_Controller || unControllerStateSize != sizeof(vr::VRControllerState_t)) {
+    return false;
+  }
+
+  uint64_t packetNum;
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    packetNum = vsyncCount;
+  }
+
+  const double t = static_cast<double>(packetNum) / FRAME_RATE;
+  memset(pControllerState, 0, sizeof(*pControllerState));
+  pControllerState->unPacketNum = static_cast<uint32_t>(packetNum);
+
+  pControllerState->rAxis[0].x = 0.5f * std::cos(t);
+  pControllerState->rAxis[0].y = 0.5f * std::sin(t);
+  pControllerState->ulButtonTouched |= vr::ButtonMaskFromId(vr::k_EButton_SteamVR_Touchpad);
+
+  const float trigger = 0.5f + 0.5f * std::sin(t * 2);
+  pControllerState->rAxis[1].x = trigger;
+  if (trigger > 0) {
+    pControllerState->ulButtonTouched |= vr::ButtonMaskFromId(vr::k_EButton_SteamVR_Trigger);
+  }
+  if (trigger > 0.9f) {
+    pControllerState->ulButtonPressed |= vr::ButtonMaskFromId(vr::k_EButton_SteamVR_Trigger);
+  }
+  return true;
+}
+
+void NullRuntime::TriggerHapticPulse(vr::TrackedDeviceIndex_t unControllerDeviceIndex, uint32_t unAxisId, unsigned short usDurationMicroSec)
+{
+  // Do nothing.
+}
+
+//=============================================================================
+/// Blocks until the next simulated vsync and returns the poses predicted for when that frame reaches the
+/// display. Vsyncs that passed since the previous call count as missed frames.
+vr::EVRCompositorError NullRuntime::WaitGetPoses(vr::TrackedDevicePose_t *pRenderPoseArray, uint32_t unRenderPoseArrayCount, vr::TrackedDevicePose_t *pGamePoseArray, uint32_t unGamePoseArrayCount)
+{
+  const Clock::time_point now = Clock::now();
+  uint64_t nextVsync;
+  Clock::time_point wakeTime;
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    if (!started) {
+      started = true;
+      startTime = now;
+    }
+
+    nextVsync = static_cast<uint64_t>(GetTime(now) * FRAME_RATE) + 1;
+    if (frames > 0) {
+      // the previous frame stayed on the display until this one is ready
+      const uint32_t missed = static_cast<uint32_t>(nextVsync - vsyncCount - 1);
+      missedFrames += missed;
+
+      vr::Compositor_FrameTiming &timing = frameTimings[frames % NUM_FRAME_TIMINGS];
+      memset(&timing, 0, sizeof(timing));
+      timing.m_nSize = sizeof(timing);
+      timing.m_nFrameIndex = static_cast<uint32_t>(frames);
+      timing.m_nNumFramePresents = 1 + missed;
+      timing.m_nNumDroppedFrames = missed;
+      timing.m_flSystemTimeInSeconds = GetTime(now);
+      timing.m_flClientFrameIntervalMs = static_cast<float>(std::chrono::duration<double, std::milli>(now - lastFrameStart).count());
+
+      cumulativeStats.m_nNumFramePresents += 1 + missed;
+      cumulativeStats.m_nNumDroppedFrames += missed;
+      cumulativeStats.m_nNumReprojectedFrames += missed;
+    }
+    lastFrameStart = now;
+    wakeTime = startTime + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(nextVsync / FRAME_RATE));
+  }
+
+  std::this_thread::sleep_until(wakeTime);
+
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    vsyncCount = nextVsync;
+    frames++;
+  }
+
+  const double t = static_cast<double>(nextVsync) / FRAME_RATE + VSYNC_TO_PHOTONS;
+  for (uint32_t i = 0; i < unRenderPoseArrayCount; i++) {
+    GetDevicePose(i, t, &pRenderPoseArray[i]);
+  }
+  for (uint32_t i = 0; i < unGamePoseArrayCount; i++) {
+    GetDevicePose(i, t + 1 / FRAME_RATE, &pGamePoseArray[i]);
+  }
+  return vr::VRCompositorError_None;
+}
+
+/// Copies the bounds of the submitted GL texture into the same region of the mirror texture, which is
+/// reallocated to the submitted texture's size. The caller's framebuffer and texture bindings are kept.
+vr::EVRCompositorError NullRuntime::Submit(vr::EVREye eEye, const vr::Texture_t *pTexture, const vr::VRTextureBounds_t *pBounds, vr::EVRSubmitFlags nSubmitFlags)
+{
+  if (!pTexture || !pTexture->handle || pTexture->eType != vr::TextureType_OpenGL) {
+    return vr::VRCompositorError_InvalidTexture;
+  }
+  const GLuint texture = static_cast<GLuint>(reinterpret_cast<size_t>(pTexture->handle));
+
+  GLint oldReadFbo, oldDrawFbo, oldTexture;
+  glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &oldReadFbo);
+  glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &oldDrawFbo);
+  glGetIntegerv(GL_TEXTURE_BINDING_2D, &oldTexture);
+  const GLboolean oldScissorTest = glIsEnabled(GL_SCISSOR_TEST);
+
+  GLint width, height;
+  glBindTexture(GL_TEXTURE_2D, texture);
+  glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_WIDTH, &width);
+  glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_HEIGHT, &height);
+
+  vr::EVRCompositorError error = vr::VRCompositorError_None;
+  if (width <= 0 || height <= 0) {
+    error = vr::VRCompositorError_InvalidTexture;
+  } else {
+    // framebuffers are not shared between contexts, and a submit thread has its own
+    if (!mirrorFbo || mirrorContext != glfwGetCurrentContext()) {
+      glGenFramebuffers(1, &mirrorFbo);
+      glGenTextures(1, &mirrorTex);
+      mirrorContext = glfwGetCurrentContext();
+    }
+    GLint mirrorWidth, mirrorHeight;
+    glBindTexture(GL_TEXTURE_2D, mirrorTex);
+    glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_WIDTH, &mirrorWidth);
+    glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_HEIGHT, &mirrorHeight);
+    if (mirrorWidth != width || mirrorHeight != height) {
+      glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    }
+
+    const vr::VRTextureBounds_t bounds = pBounds ? *pBounds : vr::VRTextureBounds_t{0, 0, 1, 1};
+    const GLint x0 = static_cast<GLint>(bounds.uMin * width);
+    const GLint y0 = static_cast<GLint>(bounds.vMin * height);
+    const GLint x1 = static_cast<GLint>(bounds.uMax * width);
+    const GLint y1 = static_cast<GLint>(bounds.vMax * height);
+
+    // read through the mirror framebuffer's second attachment so only one framebuffer is needed
+    glBindFramebuffer(GL_FRAMEBUFFER, mirrorFbo);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, mirrorTex, 0);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT1, GL_TEXTURE_2D, texture, 0);
+    glReadBuffer(GL_COLOR_ATTACHMENT1);
+    glDrawBuffer(GL_COLOR_ATTACHMENT0);
+    glDisable(GL_SCISSOR_TEST);
+    glBlitFramebuffer(x0, y0, x1, y1, x0, y0, x1, y1, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT1, GL_TEXTURE_2D, 0, 0);
+
+    submits++;
+  }
+
+  glBindFramebuffer(GL_READ_FRAMEBUFFER, oldReadFbo);
+  glBindFramebuffer(GL_DRAW_FRAMEBUFFER, oldDrawFbo);
+  glBindTexture(GL_TEXTURE_2D, oldTexture);
+  if (oldScissorTest) {
+    glEnable(GL_SCISSOR_TEST);
+  }
+  return error;
+}
+
+bool NullRuntime::GetFrameTiming(vr::Compositor_FrameTiming *pTiming, uint32_t unFramesAgo)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+
+  // the newest finished frame is the one before the frame in progress
+  if (pTiming->m_nSize != sizeof(vr::Compositor_FrameTiming) || unFramesAgo + 1 >= frames || unFramesAgo >= NUM_FRAME_TIMINGS) {
+    return false;
+  }
+  *pTiming = frameTimings[(frames - 1 - unFramesAgo) % NUM_FRAME_TIMINGS];
+  return true;
+}
+
+uint32_t NullRuntime::GetFrameTimings(vr::Compositor_FrameTiming *pTiming, uint32_t nFrames)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+
+  const uint64_t numFinished = frames > 0 ? frames - 1 : 0;
+  const uint32_t numTimings = static_cast<uint32_t>(std::min<uint64_t>(std::min<uint64_t>(nFrames, numFinished), NUM_FRAME_TIMINGS));
+  for (uint32_t i = 0; i < numTimings; i++) {
+    // oldest first
+    pTiming[i] = frameTimings[(frames - numTimings + i) % NUM_FRAME_TIMINGS];
+  }
+  return numTimings;
+}
+
+void NullRuntime::GetCumulativeStats(vr::Compositor_CumulativeStats *pStats, uint32_t nStatsSizeInBytes)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+
+  memset(pStats, 0, nStatsSizeInBytes);
+  memcpy(pStats, &cumulativeStats, std::min<size_t>(nStatsSizeInBytes, sizeof(cumulativeStats)));
+}
@@ -1,6 +1,7 @@
 #include <ivrsystem.h>
 #include <ivrcompositor.h>
 #include <openvr-bindings.h>
+#include <null-runtime.h>
 
 #include <nan/nan.h>
 
@@ -35,6 +36,14 @@ NAN_METHOD(VR_Init)
     return;
   }
 
+  // The null runtime has no system of its own; the wrapper forwards to it when it wraps nothing.
+  if (NullRuntime::IsEnabled())
+  {
+    NullRuntime::Get().Reset();
+    info.GetReturnValue().Set(IVRSystem::NewInstance(nullptr));
+    return;
+  }
+
   // Perform the actual wrapped call.
   vr::EVRInitError error;
   vr::IVRSystem *system = vr::VR_Init(
@@ -66,7 +75,10 @@ NAN_METHOD(VR_Shutdown)
     return;
   }
 
-  vr::VR_Shutdown();
+  if (!NullRuntime::IsEnabled())
+  {
+    vr::VR_Shutdown();
+  }
 }
 
 //=============================================================================
@@ -79,7 +91,7 @@ NAN_METHOD(VR_IsHmdPresent)
     return;
   }
 
-  const auto result = vr::VR_IsHmdPresent();
+  const auto result = NullRuntime::IsEnabled() || vr::VR_IsHmdPresent();
   info.GetReturnValue().Set(Nan::New<Boolean>(result));
 }
 
@@ -169,6 +181,43 @@ NAN_METHOD(VR_GetInitToken)
   info.GetReturnValue().Set(Nan::New<Number>(result));
 }
 
+//=============================================================================
+/// Switches VR_Init, VR_IsHmdPresent and NewCompositor to the simulated runtime in null-runtime.h.
+NAN_METHOD(VR_SetNullRuntime)
+{
+  if (info.Length() != 1)
+  {
+    Nan::ThrowError("Wrong number of arguments.");
+    return;
+  }
+
+  if (!info[0]->IsBoolean())
+  {
+    Nan::ThrowTypeError("Argument[0] must be a boolean.");
+    return;
+  }
+
+  NullRuntime::SetEnabled(info[0]->BooleanValue());
+}
+
+//=============================================================================
+/// Returns {frames, submits, missedFrames} counted by the null runtime since VR_Init.
+NAN_METHOD(VR_GetNullRuntimeStats)
+{
+  if (info.Length() != 0)
+  {
+    Nan::ThrowError("Wrong number of arguments.");
+    return;
+  }
+
+  const NullRuntime &nullRuntime = NullRuntime::Get();
+  Local<Object> result = Nan::New<Object>();
+  result->Set(Nan::New("frames").ToLocalChecked(), Nan::New<Number>(static_cast<double>(nullRuntime.frames)));
+  result->Set(Nan::New("submits").ToLocalChecked(), Nan::New<Number>(static_cast<double>(nullRuntime.submits)));
+  result->Set(Nan::New("missedFrames").ToLocalChecked(), Nan::New<Number>(static_cast<double>(nullRuntime.missedFrames)));
+  info.GetReturnValue().Set(result);
+}
+
 NAN_METHOD(GetContext)
 { 
   Local<Object> result = Object::New(Isolate::GetCurrent());
@@ -198,6 +247,8 @@ Local<Object> makeVr() {
   exports->Set(Nan::New("VR_GetVRInitErrorAsSymbol").ToLocalChecked(), Nan::New<v8::FunctionTemplate>(VR_GetVRInitErrorAsSymbol)->GetFunction());
   exports->Set(Nan::New("VR_GetVRInitErrorAsEnglishDescription").ToLocalChecked(), Nan::New<v8::FunctionTemplate>(VR_GetVRInitErrorAsEnglishDescription)->GetFunction());
   exports->Set(Nan::New("VR_GetInitToken").ToLocalChecked(), Nan::New<v8::FunctionTemplate>(VR_GetInitToken)->GetFunction());
+  exports->Set(Nan::New("VR_SetNullRuntime").ToLocalChecked(), Nan::New<v8::FunctionTemplate>(VR_SetNullRuntime)->GetFunction());
+  exports->Set(Nan::New("VR_GetNullRuntimeStats").ToLocalChecked(), Nan::New<v8::FunctionTemplate>(VR_GetNullRuntimeStats)->GetFunction());
   exports->Set(Nan::New("getContext").ToLocalChecked(), Nan::New<v8::FunctionTemplate>(GetContext)->GetFunction());
 
   return scope.Escape(exports);
@@ -0,0 +1,172 @@
+#include <submit-thread.h>
+
+#include <cstring>
+#include <null-runtime.h>
+
+//=============================================================================
+vr::EVRCompositorError SubmitThread::SubmitFrame(vr::IVRCompositor *compositor, const Frame &frame)
+{
+  // both eyes share the texture and the pose the frame was rendered with
+  vr::VRTextureWithPose_t eyeTexture;
+  eyeTexture.handle = (void *)(size_t)frame.texture;
+  eyeTexture.eType = vr::TextureType_OpenGL;
+  eyeTexture.eColorSpace = vr::ColorSpace_Gamma;
+  vr::EVRSubmitFlags submitFlags = vr::Submit_Default;
+  if (frame.hasPose) {
+    memcpy(&eyeTexture.mDeviceToAbsoluteTracking.m[0][0], frame.pose, sizeof(frame.pose));
+    submitFlags = vr::Submit_TextureWithPose;
+  }
+
+  const vr::VRTextureBounds_t eyeTextureBounds[2] = {
+    {0, 0, frame.uMax * 0.5f, frame.vMax},
+    {frame.uMax * 0.5f, 0, frame.uMax, frame.vMax},
+  };
+  for (unsigned int eye = 0; eye < 2; eye++) {
+    const vr::EVRCompositorError compositorError = VR_CALL(compositor, Submit, static_cast<vr::EVREye>(eye), &eyeTexture, &eyeTextureBounds[eye], submitFlags);
+    if (compositorError != vr::VRCompositorError_None) {
+      return compositorError;
+    }
+  }
+
+  if (compositor) {
+    std::lock_guard<std::mutex> lock(GetVrMutex());
+    compositor->PostPresentHandoff();
+  }
+  return vr::VRCompositorError_None;
+}
+
+//=============================================================================
+SubmitThread::SubmitThread(vr::IVRCompositor *compositor, GLFWwindow *sharedWindow)
+: compositor(compositor), window(nullptr), live(true), hasFrame(false), frameFence(nullptr),
+  submitError(vr::VRCompositorError_None), posesWanted(false), posesReady(false)
+{
+  window = glfw::CreateSharedWindow(sharedWindow);
+  if (window) {
+    thread = std::thread([this]() {
+      Run();
+    });
+  }
+}
+
+//=============================================================================
+SubmitThread::~SubmitThread()
+{
+  if (thread.joinable()) {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      live = false;
+    }
+    framesCv.notify_one();
+    thread.join();
+  }
+  if (window) {
+    glfw::DestroySharedWindow(window);
+  }
+}
+
+//=============================================================================
+void SubmitThread::WaitPoses(TrackedDevicePoseArray &trackedDevicePoseArray)
+{
+  std::unique_lock<std::mutex> lock(mutex);
+  if (!posesReady) {
+    // nothing was submitted since the last poses, so the thread is idle until asked
+    posesWanted = true;
+    framesCv.notify_one();
+    posesCv.wait(lock, [&]() {
+      return posesReady;
+    });
+  }
+  trackedDevicePoseArray = poses;
+  posesReady = false;
+}
+
+//=============================================================================
+vr::EVRCompositorError SubmitThread::Submit(const Frame &newFrame)
+{
+  GLsync fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+  glFlush();
+
+  vr::EVRCompositorError compositorError;
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (hasFrame) {
+      glDeleteSync(frameFence);
+    }
+    frame = newFrame;
+    frameFence = fence;
+    hasFrame = true;
+
+    compositorError = submitError;
+    submitError = vr::VRCompositorError_None;
+  }
+  framesCv.notify_one();
+
+  return compositorError;
+}
+
+//=============================================================================
+void SubmitThread::Run()
+{
+  glfwMakeContextCurrent(window);
+
+  TrackedDevicePoseArray nextPoses;
+  for (;;) {
+    bool submitting;
+    Frame submitFrame;
+    GLsync fence = nullptr;
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      framesCv.wait(lock, [&]() {
+        return !live || hasFrame || posesWanted;
+      });
+      if (!live) {
+        if (hasFrame) {
+          glDeleteSync(frameFence);
+          hasFrame = false;
+        }
+        break;
+      }
+      submitting = hasFrame;
+      if (submitting) {
+        submitFrame = frame;
+        fence = frameFence;
+        hasFrame = false;
+      }
+    }
+
+    vr::EVRCompositorError compositorError = vr::VRCompositorError_None;
+    GLsync submittedFence = nullptr;
+    if (submitting) {
+      // the flush on the JS thread already submitted the frame, so this only waits for the GPU
+      glClientWaitSync(fence, 0, 1000 * 1000 * 1000);
+      glDeleteSync(fence);
+
+      compositorError = SubmitFrame(compositor, submitFrame);
+
+      // the compositor copies the texture with GL commands on this context
+      submittedFence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+      glFlush();
+    }
+
+    VR_CALL(compositor, WaitGetPoses, nextPoses.data(), static_cast<uint32_t>(nextPoses.size()), nullptr, 0);
+
+    if (submittedFence) {
+      // JS renders into the texture again once it has the poses, so the copy has to be done by then
+      glClientWaitSync(submittedFence, 0, 1000 * 1000 * 1000);
+      glDeleteSync(submittedFence);
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      poses = nextPoses;
+      posesReady = true;
+      posesWanted = false;
+      if (compositorError != vr::VRCompositorError_None) {
+        submitError = compositorError;
+      }
+    }
+    posesCv.notify_all();
+  }
+
+  glfwMakeContextCurrent(nullptr);
+}
@@ -11,8 +11,10 @@ const os = require('os');
 const url = require('url');
 const child_process = require('child_process');
 const repl = require('repl');
+const {performance} = require('perf_hooks');
 
 const core = require('./core.js');
+const {FrameTelemetry} = require('./src/FrameTelemetry.js');
 const mkdirp = require('mkdirp');
 const replHistory = require('repl.history');
 const minimist = require('minimist');
@@ -44,12 +46,23 @@ const args = (() => {
         'quit',
         'blit',
         'require',
+        'compressTextures',
+        'rawInput',
+        'vsync',
+        'nullVr',
+        'dynamicResolution',
+        'asyncVr',
+        'gpuCanvas',
+        'recordCanvas',
       ],
       string: [
         'tab',
         'xr',
         'size',
         'image',
+        'packTextures',
+        'samples',
+        'present',
       ],
       alias: {
         v: 'version',
@@ -81,12 +94,38 @@ const args = (() => {
       blit: minimistArgs.blit,
       image: minimistArgs.image,
       require: minimistArgs.require,
+      compressTextures: minimistArgs.compressTextures,
+      packTextures: minimistArgs.packTextures,
+      rawInput: minimistArgs.rawInput,
+      vsync: minimistArgs.vsync,
+      present: minimistArgs.present,
+      nullVr: minimistArgs.nullVr,
+      dynamicResolution: minimistArgs.dynamicResolution,
+      asyncVr: minimistArgs.asyncVr,
+      gpuCanvas: minimistArgs.gpuCanvas,
+      recordCanvas: minimistArgs.recordCanvas,
+      samples: (() => {
+        if (minimistArgs.samples !== undefined) {
+          const samples = parseInt(minimistArgs.samples, 10);
+          if ([0, 2, 4, 8].includes(samples)) {
+            return samples;
+          } else {
+            console.warn('invalid --samples; expected 0, 2, 4 or 8. using 4');
+          }
+        }
+        return 4;
+      })(),
     };
   } else {
     return {};
   }
 })();
 
+if (args.recordCanvas) {
+  // 2D canvases record display lists and only rasterize when their pixels are read
+  nativeBindings.nativeCanvasRenderingContext2D.setRecording(true);
+}
+
 nativeBindings.nativeGl.onconstruct = (gl, canvas) => {
   const canvasWidth = canvas.width || innerWidth;
   const canvasHeight = canvas.height || innerHeight;
@@ -107,6 +146,18 @@ nativeBindings.nativeGl.onconstruct = (gl, canvas) => {
 
     gl.setWindowHandle(windowHandle);
     gl.setDefaultVao(vao);
+    if (args.gpuCanvas && contexts.length === 0) {
+      // 2D canvases created from now on render on the GPU, in this context's share group
+      if (!nativeBindings.nativeCanvasRenderingContext2D.setGpuContext(windowHandle)) {
+        console.warn('failed to create GPU canvas context; 2D canvases stay in software');
+      }
+    }
+    if (args.compressTextures) {
+      gl.setTextureCompression(true);
+    }
+    if (args.packTextures) {
+      gl.setTexturePacking(args.packTextures);
+    }
 
     gl.canvas = canvas;
 
@@ -122,15 +173,29 @@ nativeBindings.nativeGl.onconstruct = (gl, canvas) => {
 
     const {hidden} = document;
     if (hidden) {
-      const [framebuffer, colorTexture, depthStencilTexture, msFramebuffer, msColorTexture, msDepthStencilTexture] = nativeWindow.createRenderTarget(gl, canvasWidth, canvasHeight, sharedColorTexture, sharedDepthStencilTexture);
+      let [framebuffer, colorTexture, depthStencilTexture, msFramebuffer, msColorTexture, msDepthStencilTexture] = nativeWindow.createRenderTarget(gl, canvasWidth, canvasHeight, sharedColorTexture, sharedDepthStencilTexture, sharedMsColorTexture, sharedMsDepthStencilTexture, args.samples);
 
       gl.setDefaultFramebuffer(msFramebuffer);
 
+      const framebufferSpec = {
+        framebuffer,
+        colorTexture,
+        depthStencilTexture,
+        render() {
+          nativeWindow.setCurrentWindowContext(windowHandle);
+
+          // resolve color, depth and stencil in one unscaled blit, then drop the multisampled copy; a no-op without multisampling
+          nativeWindow.blitFrameBuffer(gl, msFramebuffer, framebuffer, canvas.width, canvas.height, canvas.width, canvas.height, true, true, true, true, true);
+        },
+      };
+
       const _attribute = (name, value) => {
         if (name === 'width' || name === 'height') {
           nativeWindow.setCurrentWindowContext(windowHandle);
 
-          nativeWindow.resizeRenderTarget(gl, canvas.width, canvas.height, framebuffer, colorTexture, depthStencilTexture, msFramebuffer, msColorTexture, msDepthStencilTexture);
+          [framebuffer, colorTexture, depthStencilTexture, msFramebuffer, msColorTexture, msDepthStencilTexture] = nativeWindow.resizeRenderTarget(gl, canvas.width, canvas.height, framebuffer, colorTexture, depthStencilTexture, msFramebuffer, msColorTexture, msDepthStencilTexture);
+          framebufferSpec.colorTexture = colorTexture;
+          framebufferSpec.depthStencilTexture = depthStencilTexture;
         }
       };
       canvas.on('attribute', _attribute);
@@ -138,18 +203,7 @@ nativeBindings.nativeGl.onconstruct = (gl, canvas) => {
         canvas.removeListener('attribute', _attribute);
       });
 
-      document._emit('framebuffer', {
-        framebuffer,
-        colorTexture,
-        depthStencilTexture,
-        render() {
-          nativeWindow.setCurrentWindowContext(windowHandle);
-
-          // color blit is linear, depth/stencil is nearest
-          nativeWindow.blitFrameBuffer(gl, msFramebuffer, framebuffer, canvas.width, canvas.height, canvas.width, canvas.height, true, false, false);
-          nativeWindow.blitFrameBuffer(gl, msFramebuffer, framebuffer, canvas.width, canvas.height, canvas.width, canvas.height, false, true, true);
-        },
-      });
+      document._emit('framebuffer', framebufferSpec);
     }
 
     const ondomchange = () => {
@@ -175,6 +229,7 @@ nativeBindings.nativeGl.onconstruct = (gl, canvas) => {
       nativeWindow.setCurrentWindowContext(windowHandle);
 
       if (gl === vrPresentState.glContext) {
+        vrPresentState.compositor.StopSubmitThread();
         nativeVr.VR_Shutdown();
 
         vrPresentState.glContext = null;
@@ -217,15 +272,7 @@ nativeBindings.nativeGl.onconstruct = (gl, canvas) => {
 };
 
 const zeroMatrix = new THREE.Matrix4();
-const localFloat32Array = zeroMatrix.toArray(new Float32Array(16));
-const localFloat32Array2 = zeroMatrix.toArray(new Float32Array(16));
-const localFloat32Array3 = zeroMatrix.toArray(new Float32Array(16));
 const localFloat32Array4 = new Float32Array(16);
-const localOffsetArray = new Float32Array(3);
-const localOffsetArray2 = new Float32Array(3);
-const localFovArray = new Float32Array(4);
-const localFovArray2 = new Float32Array(4);
-const localGamepadArray = new Float32Array(24);
 
 const handEntrySize = (1 + (5 * 5)) * (3 + 3);
 const maxNumPlanes = 32 * 3;
@@ -243,11 +290,62 @@ const numPlanesArray = new Uint32Array(1);
 const controllersArray = new Float32Array((3 + 4 + 1) * 2);
 const gesturesArray = new Float32Array(4 * 2);
 
+// packed frame filled by IVRCompositor::WaitGetFrame; the layout mirrors the FRAME_* constants in ivrcompositor.h
+const vrFrameLayout = {
+  pose: 0,
+  leftEye: 8,
+  rightEye: 8 + 40,
+  leftController: 8 + 40 * 2,
+  rightController: 8 + 40 * 2 + 28,
+  size: 8 + 40 * 2 + 28 * 2,
+};
+const vrFrameArray = new Float32Array(vrFrameLayout.size);
+const _makeEyeFrame = offset => ({
+  view: vrFrameArray.subarray(offset, offset + 16),
+  projection: vrFrameArray.subarray(offset + 16, offset + 32),
+  offset: vrFrameArray.subarray(offset + 32, offset + 35),
+  fov: vrFrameArray.subarray(offset + 36, offset + 40),
+});
+// frames filled by IVRCompositor::GetFrameTimings, FRAME_TIMING_SIZE doubles each
+const vrFrameTimingSize = 10;
+const vrFrameTimingsArray = new Float64Array(vrFrameTimingSize * 8);
+const leftEyeFrame = _makeEyeFrame(vrFrameLayout.leftEye);
+const rightEyeFrame = _makeEyeFrame(vrFrameLayout.rightEye);
+const _updateVrGamepad = (gamepad, offset) => {
+  if (!isNaN(vrFrameArray[offset])) {
+    gamepad.buttons[0].pressed = vrFrameArray[offset + 4] !== 0; // pad
+    gamepad.buttons[1].pressed = vrFrameArray[offset + 5] !== 0; // trigger
+    gamepad.buttons[2].pressed = vrFrameArray[offset + 3] !== 0; // grip
+    gamepad.buttons[3].pressed = vrFrameArray[offset + 2] !== 0; // menu
+    gamepad.buttons[4].pressed = vrFrameArray[offset + 1] !== 0; // system
+
+    gamepad.buttons[0].touched = vrFrameArray[offset + 9] !== 0; // pad
+    gamepad.buttons[1].touched = vrFrameArray[offset + 10] !== 0; // trigger
+    gamepad.buttons[2].touched = vrFrameArray[offset + 8] !== 0; // grip
+    gamepad.buttons[3].touched = vrFrameArray[offset + 7] !== 0; // menu
+    gamepad.buttons[4].touched = vrFrameArray[offset + 6] !== 0; // system
+
+    for (let i = 0; i < 10; i++) {
+      gamepad.axes[i] = vrFrameArray[offset + 11 + i];
+    }
+    gamepad.buttons[1].value = gamepad.axes[2]; // trigger
+
+    // pose
+    for (let i = 0; i < 3; i++) {
+      gamepad.pose.position[i] = vrFrameArray[offset + 21 + i];
+    }
+    for (let i = 0; i < 4; i++) {
+      gamepad.pose.orientation[i] = vrFrameArray[offset + 24 + i];
+    }
+
+    return gamepad;
+  } else {
+    return null;
+  }
+};
+
 const localVector = new THREE.Vector3();
-const localVector2 = new THREE.Vector3();
 const localQuaternion = new THREE.Quaternion();
-const localMatrix = new THREE.Matrix4();
-const localMatrix2 = new THREE.Matrix4();
 const _normalizeMatrixArray = float32Array => {
   if (isNaN(float32Array[0])) {
     zeroMatrix.toArray(float32Array);
@@ -262,8 +360,10 @@ const vrPresentState = {
   glContext: null,
   msFbo: null,
   msTex: null,
+  msDepthStencilTex: null,
   fbo: null,
   tex: null,
+  depthStencilTex: null,
   hasPose: false,
   lmContext: null,
 };
@@ -271,6 +371,53 @@ let renderWidth = 0;
 let renderHeight = 0;
 const depthNear = 0.1;
 const depthFar = 10000.0;
+
+// The VR target is allocated at the recommended size and the eyes are rendered into a scaled sub-rect of it
+// (renderWidth/renderHeight), so the scale can change every frame without reallocating. With
+// --dynamicResolution the scale follows the frame time; content can cap it with requestViewportScaling.
+const RENDER_SCALE_MIN = 0.5;
+const RENDER_SCALE_SETTLE_FRAMES = 15;
+const renderScaleState = {
+  recommendedWidth: 0,
+  recommendedHeight: 0,
+  scale: 1,
+  maxScale: 1,
+  frameTime: 0,
+  gpuTime: 0,
+  frameStart: 0,
+  settleFrames: 0,
+  displayFrequency: 0,
+};
+const _updateRenderScale = () => {
+  let {scale} = renderScaleState;
+  if (args.dynamicResolution && ++renderScaleState.settleFrames >= RENDER_SCALE_SETTLE_FRAMES) {
+    const frameTime = Math.max(renderScaleState.frameTime, renderScaleState.gpuTime);
+    const budget = 1000 / renderScaleState.displayFrequency;
+    if (frameTime > budget * 0.9) {
+      scale *= 0.9;
+    } else if (frameTime < budget * 0.7) {
+      scale *= 1.05;
+    }
+  }
+  scale = Math.min(Math.max(scale, RENDER_SCALE_MIN), renderScaleState.maxScale);
+  if (scale !== renderScaleState.scale) {
+    renderScaleState.scale = scale;
+    renderScaleState.settleFrames = 0;
+  }
+
+  renderWidth = Math.round(renderScaleState.recommendedWidth * scale);
+  renderHeight = Math.round(renderScaleState.recommendedHeight * scale);
+};
+const _addRenderScaleSample = (frameTime, gpuTime) => {
+  // smooth over a few frames; gpu times arrive late and only where timer queries are supported
+  renderScaleState.frameTime += (frameTime - renderScaleState.frameTime) * 0.2;
+  if (gpuTime >= 0) {
+    renderScaleState.gpuTime += (gpuTime - renderScaleState.gpuTime) * 0.2;
+  }
+};
+nativeVr.requestViewportScaling = function(scale) {
+  renderScaleState.maxScale = Math.min(Math.max(scale, RENDER_SCALE_MIN), 1);
+};
 nativeVr.requestPresent = function(layers) {
   if (!vrPresentState.glContext) {
     const layer = layers.find(layer => layer && layer.source && layer.source.tagName === 'CANVAS');
@@ -287,15 +434,24 @@ nativeVr.requestPresent = function(layers) {
       const vrContext = vrPresentState.vrContext || nativeVr.getContext();
       const system = vrPresentState.system || nativeVr.VR_Init(nativeVr.EVRApplicationType.Scene);
       const compositor = vrPresentState.compositor || vrContext.compositor.NewCompositor();
+      if (args.asyncVr) {
+        // waiting for the running start and submitting move to their own thread, overlapping the JS between frames
+        compositor.StartSubmitThread(context);
+      }
 
       const lmContext = vrPresentState.lmContext || (nativeLm && new nativeLm());
 
       const {width: halfWidth, height} = system.GetRecommendedRenderTargetSize();
       const width = halfWidth * 2;
-      renderWidth = halfWidth;
-      renderHeight = height;
+      renderScaleState.recommendedWidth = halfWidth;
+      renderScaleState.recommendedHeight = height;
+      // headsets run at 72-144 Hz, so budget against the one we got rather than FPS
+      renderScaleState.displayFrequency = system.GetFloatTrackedDeviceProperty(nativeVr.k_unTrackedDeviceIndex_Hmd, nativeVr.ETrackedDeviceProperty.Prop_DisplayFrequency_Float) || FPS;
+      renderScaleState.frameTime = 0;
+      renderScaleState.gpuTime = 0;
+      _updateRenderScale();
 
-      const [fbo, tex, depthStencilTex, msFbo, msTex, msDepthStencilTex] = nativeWindow.createRenderTarget(context, width, height, 0, 0, 0, 0);
+      const [fbo, tex, depthStencilTex, msFbo, msTex, msDepthStencilTex] = nativeWindow.createRenderTarget(context, width, height, 0, 0, 0, 0, args.samples);
 
       context.setDefaultFramebuffer(msFbo);
 
@@ -306,8 +462,10 @@ nativeVr.requestPresent = function(layers) {
       vrPresentState.glContext = context;
       vrPresentState.msFbo = msFbo;
       vrPresentState.msTex = msTex;
+      vrPresentState.msDepthStencilTex = msDepthStencilTex;
       vrPresentState.fbo = fbo;
       vrPresentState.tex = tex;
+      vrPresentState.depthStencilTex = depthStencilTex;
 
       vrPresentState.lmContext = lmContext;
 
@@ -338,13 +496,18 @@ nativeVr.requestPresent = function(layers) {
 };
 nativeVr.exitPresent = function() {
   if (vrPresentState.isPresenting) {
+    vrPresentState.compositor.StopSubmitThread();
     nativeVr.VR_Shutdown();
 
-    nativeWindow.destroyRenderTarget(vrPresentState.msFbo, vrPresentState.msTex);
-    nativeWindow.destroyRenderTarget(vrPresentState.fbo, vrPresentState.tex);
-
     const context = vrPresentState.glContext;
     nativeWindow.setCurrentWindowContext(context.getWindowHandle());
+    nativeWindow.endGpuTimer(context);
+
+    if (vrPresentState.msFbo !== vrPresentState.fbo) {
+      nativeWindow.destroyRenderTarget(vrPresentState.msFbo, vrPresentState.msTex, vrPresentState.msDepthStencilTex);
+    }
+    nativeWindow.destroyRenderTarget(vrPresentState.fbo, vrPresentState.tex, vrPresentState.depthStencilTex);
+
     context.setDefaultFramebuffer(0);
 
     vrPresentState.isPresenting = false;
@@ -353,8 +516,10 @@ nativeVr.exitPresent = function() {
     vrPresentState.glContext = null;
     vrPresentState.msFbo = null;
     vrPresentState.msTex = null;
+    vrPresentState.msDepthStencilTex = null;
     vrPresentState.fbo = null;
     vrPresentState.tex = null;
+    vrPresentState.depthStencilTex = null;
   }
 
   return Promise.resolve();
@@ -426,7 +591,7 @@ if (nativeMl) {
   };
 }
 
-nativeWindow.setEventHandler((type, data) => {
+const _handleWindowEvent = (type, data) => {
   // console.log(type, data);
 
   const {windowHandle} = data;
@@ -561,21 +726,129 @@ nativeWindow.setEventHandler((type, data) => {
   } else {
     console.warn('got native window event with no matching context', {type, data});
   }
-});
+};
+nativeWindow.setEventHandler(_handleWindowEvent);
+
+// high-rate window input is queued natively and drained once per frame by pollEvents
+const INPUT_EVENT_STRIDE = 8;
+// event names as the handler receives them; the payload types below match what the native callbacks set
+const inputEventTypes = [
+  null,
+  'mousemove',
+  'mousedown',
+  'mouseup',
+  'click',
+  'wheel',
+  'mouseenter',
+  'keydown',
+  'keyup',
+  'keypress',
+  'window_pos',
+  'windowResize',
+  'framebufferResize',
+  'refresh',
+  'iconified',
+  'focus',
+  'quit',
+  'drop',
+];
+const inputEvents = new Float64Array(INPUT_EVENT_STRIDE * 1024);
+const _dispatchInputEvents = numEvents => {
+  for (let i = 0; i < numEvents; i++) {
+    const offset = i * INPUT_EVENT_STRIDE;
+    const type = inputEventTypes[inputEvents[offset]];
+    const windowHandle = [inputEvents[offset + 1], inputEvents[offset + 2]];
+    const a = inputEvents[offset + 3];
+    const b = inputEvents[offset + 4];
+    const c = inputEvents[offset + 5];
+    const d = inputEvents[offset + 6];
+    const mods = inputEvents[offset + 7];
+    const modifiers = {
+      shiftKey: !!(mods & 0x1),
+      ctrlKey: !!(mods & 0x2),
+      altKey: !!(mods & 0x4),
+      metaKey: !!(mods & 0x8),
+    };
+
+    let data;
+    switch (type) {
+      case 'mousemove': {
+        data = Object.assign({type, clientX: a, clientY: b, pageX: a, pageY: b, movementX: c, movementY: d, windowHandle}, modifiers);
+        break;
+      }
+      case 'mousedown':
+      case 'mouseup':
+      case 'click': {
+        data = Object.assign({type, button: a, which: a, clientX: b, clientY: c, pageX: b, pageY: c, windowHandle}, modifiers);
+        break;
+      }
+      case 'wheel': {
+        data = Object.assign({type, deltaX: a, deltaY: b, deltaZ: 0, deltaMode: 0, windowHandle}, modifiers);
+        break;
+      }
+      case 'mouseenter': {
+        data = {type, entered: a, windowHandle};
+        break;
+      }
+      case 'keydown':
+      case 'keyup':
+      case 'keypress': {
+        data = Object.assign({type, which: a, keyCode: b, charCode: c, windowHandle}, modifiers);
+        break;
+      }
+      case 'window_pos': {
+        data = {type, xpos: a, ypos: b, windowHandle};
+        break;
+      }
+      case 'windowResize': {
+        data = {type: 'resize', width: a, height: b, windowHandle};
+        break;
+      }
+      case 'framebufferResize': {
+        data = {type: 'framebuffer_resize', width: a, height: b, windowHandle};
+        break;
+      }
+      case 'iconified': {
+        data = {type, iconified: !!a, windowHandle};
+        break;
+      }
+      case 'focus': {
+        data = {type: 'focused', focused: !!a, windowHandle};
+        break;
+      }
+      case 'drop': {
+        data = {paths: nativeWindow.takeDroppedPaths(), windowHandle};
+        break;
+      }
+      default: {
+        data = {type, windowHandle};
+        break;
+      }
+    }
+    _handleWindowEvent(type, data);
+  }
+};
+nativeWindow.setInputQueue(true, !!args.rawInput);
+nativeWindow.setVsync(!!args.vsync);
+if (args.nullVr) {
+  nativeVr.VR_SetNullRuntime(true);
+}
+if (args.present) {
+  nativeWindow.setPresentMode(args.present);
+}
 
 core.setVersion(version);
 
 let innerWidth = 1280; // XXX do not track this globally
 let innerHeight = 1024;
 const FPS = 90;
-const FRAME_TIME_MAX = ~~(1000 / FPS);
-const FRAME_TIME_MIN = 0;
 
 const _bindWindow = (window, newWindowCb) => {
   window.innerWidth = innerWidth;
   window.innerHeight = innerHeight;
   window.on('unload', () => {
     clearTimeout(timeout);
+    clearImmediate(immediate);
   });
   window.on('navigate', newWindowCb);
   window.document.on('paste', e => {
@@ -699,34 +972,37 @@ const _bindWindow = (window, newWindowCb) => {
         const windowHandle = context.getWindowHandle();
         nativeWindow.setCurrentWindowContext(windowHandle);
         context.flush();
+        // hidden and iframe contexts too, or their streamed uploads are never retired
+        context.endFrame();
 
         if (nativeWindow.isVisible(windowHandle) || vrPresentState.glContext === context || mlGlContext === context) {
           if (vrPresentState.glContext === context && vrPresentState.hasPose) {
-            nativeWindow.blitFrameBuffer(context, vrPresentState.msFbo, vrPresentState.fbo, renderWidth * 2, renderHeight, renderWidth * 2, renderHeight, true, false, false);
+            nativeWindow.blitFrameBuffer(context, vrPresentState.msFbo, vrPresentState.fbo, renderWidth * 2, renderHeight, renderWidth * 2, renderHeight, true, false, false, true, true);
 
-            vrPresentState.compositor.Submit(context, vrPresentState.tex);
+            _addRenderScaleSample(performance.now() - renderScaleState.frameStart, nativeWindow.endGpuTimer(context));
+            vrPresentState.compositor.Submit(context, vrPresentState.tex, renderWidth / renderScaleState.recommendedWidth, renderHeight / renderScaleState.recommendedHeight);
             vrPresentState.hasPose = false;
 
-            nativeWindow.blitFrameBuffer(context, vrPresentState.fbo, 0, renderWidth * (args.blit ? 1 : 2), renderHeight, window.innerWidth, window.innerHeight, true, false, false);
+            nativeWindow.blitFrameBuffer(context, vrPresentState.fbo, 0, renderWidth * (args.blit ? 1 : 2), renderHeight, window.innerWidth, window.innerHeight, true, false, false, false, true);
           } else if (mlGlContext === context && mlHasPose) {
             mlContext.SubmitFrame(mlFbo, window.innerWidth, window.innerHeight);
             mlHasPose = false;
 
-            nativeWindow.blitFrameBuffer(context, mlFbo, 0, window.innerWidth, window.innerHeight, window.innerWidth, window.innerHeight, true, false, false);
+            nativeWindow.blitFrameBuffer(context, mlFbo, 0, window.innerWidth, window.innerHeight, window.innerWidth, window.innerHeight, true, false, false, false, true);
           }
 
+          // clear before swapping: with async present the context is handed off by the swap
+          context.clearDirty();
+
           nativeWindow.swapBuffers(windowHandle);
 
           numDirtyFrames++;
           _checkDirtyFrameTimeout();
-
-          context.clearDirty();
         }
       }
     }
   }
 
-  let lastFrameTime = Date.now();
   const timestamps = {
     frames: 0,
     last: Date.now(),
@@ -740,11 +1016,15 @@ const _bindWindow = (window, newWindowCb) => {
     total: 0,
   };
   const TIMESTAMP_FRAMES = 90;
+  const telemetry = new FrameTelemetry();
+  let lastFrameStart = 0;
+  window.getFrameTelemetry = () => telemetry.get(); // XXX non-standard
   const [leftGamepad, rightGamepad] = core.getAllGamepads();
   const gamepads = [null, null];
   const frameData = new window.VRFrameData();
   const stageParameters = new window.VRStageParameters();
   let timeout = null;
+  let immediate = null;
   let numFrames = 0;
   let numDirtyFrames = 0;
   const dirtyFrameContexts = [];
@@ -800,6 +1080,7 @@ const _bindWindow = (window, newWindowCb) => {
 
   window.on('unload', () => {
     clearTimeout(timeout);
+    clearImmediate(immediate);
   });
   window.on('navigate', newWindowCb);
   window.document.on('paste', e => {
@@ -814,6 +1095,8 @@ const _bindWindow = (window, newWindowCb) => {
   });
 
   window.on('vrdisplaypresentchange', e => {
+    telemetry.resetVr();
+
     if (e.display) {
       const gamepads = [leftGamepad, rightGamepad];
       for (let i = 0; i < gamepads.length; i++) {
@@ -846,9 +1129,21 @@ const _bindWindow = (window, newWindowCb) => {
   });
 
   const _recurse = () => {
+    nativeWindow.beginFrame();
+
+    const frameStart = performance.now();
+    if (lastFrameStart !== 0) {
+      telemetry.addFrame(frameStart - lastFrameStart);
+    }
+    lastFrameStart = frameStart;
+    if (contexts.length > 0) {
+      telemetry.addSwapStats(nativeWindow.getSwapStats(contexts[0].getWindowHandle()));
+    }
+
     if (args.performance) {
       if (timestamps.frames >= TIMESTAMP_FRAMES) {
-        console.log(`${(TIMESTAMP_FRAMES/(timestamps.total/1000)).toFixed(0)} FPS | ${timestamps.idle}ms idle | ${timestamps.wait}ms wait | ${timestamps.prepare}ms prepare | ${timestamps.events}ms events | ${timestamps.media}ms media | ${timestamps.user}ms user | ${timestamps.submit}ms submit`);
+        const frameTimes = nativeWindow.getFrameTimes(true);
+        console.log(`${(TIMESTAMP_FRAMES/(timestamps.total/1000)).toFixed(0)} FPS | ${timestamps.idle}ms idle | ${timestamps.wait}ms wait | ${timestamps.prepare}ms prepare | ${timestamps.events}ms events | ${timestamps.media}ms media | ${timestamps.user}ms user | ${timestamps.submit}ms submit | ${frameTimes.p50}/${frameTimes.p95}/${frameTimes.p99}/${frameTimes.max.toFixed(1)}ms frame p50/p95/p99/max`);
 
         timestamps.frames = 0;
         timestamps.idle = 0;
@@ -871,13 +1166,18 @@ const _bindWindow = (window, newWindowCb) => {
 
     if (vrPresentState.isPresenting && vrPresentState.glContext && vrPresentState.glContext.canvas.ownerDocument.defaultView === window) {
       // wait for frame
-      vrPresentState.compositor.WaitGetPoses(
-        vrPresentState.system,
-        localFloat32Array, // hmd
-        localFloat32Array2, // left controller
-        localFloat32Array3 // right controller
-      );
+      vrPresentState.compositor.WaitGetFrame(vrPresentState.system, depthNear, depthFar, vrFrameArray);
       vrPresentState.hasPose = true;
+      _updateRenderScale();
+      renderScaleState.frameStart = performance.now();
+      nativeWindow.setCurrentWindowContext(vrPresentState.glContext.getWindowHandle());
+      nativeWindow.beginGpuTimer(vrPresentState.glContext);
+
+      const numFrameTimings = vrPresentState.compositor.GetFrameTimings(vrFrameTimingsArray);
+      telemetry.addVrFrameTimings(vrFrameTimingsArray, numFrameTimings, vrFrameTimingSize);
+      if ((numFrames % FPS) === 0) {
+        telemetry.setVrCumulativeStats(vrPresentState.compositor.GetCumulativeStats());
+      }
       if (args.performance) {
         const now = Date.now();
         const diff = now - timestamps.last;
@@ -885,58 +1185,21 @@ const _bindWindow = (window, newWindowCb) => {
         timestamps.total += diff;
         timestamps.last = now;
       }
-      _normalizeMatrixArray(localFloat32Array);
-      _normalizeMatrixArray(localFloat32Array2);
-      _normalizeMatrixArray(localFloat32Array3);
 
       // build frame data
-      const hmdMatrix = localMatrix.fromArray(localFloat32Array);
-
-      hmdMatrix.decompose(localVector, localQuaternion, localVector2);
+      localVector.fromArray(vrFrameArray, vrFrameLayout.pose);
+      localQuaternion.fromArray(vrFrameArray, vrFrameLayout.pose + 3);
       frameData.pose.set(localVector, localQuaternion);
 
-      hmdMatrix.getInverse(hmdMatrix);
-
-      vrPresentState.system.GetEyeToHeadTransform(0, localFloat32Array4);
-      localMatrix2.fromArray(localFloat32Array4);
-      localMatrix2.decompose(localVector, localQuaternion, localVector2);
-      localVector.toArray(localOffsetArray);
-      const leftOffset = localOffsetArray;
-      localMatrix2
-        .getInverse(localMatrix2)
-        .multiply(hmdMatrix);
-      localMatrix2.toArray(frameData.leftViewMatrix);
-
-      vrPresentState.system.GetProjectionMatrix(0, depthNear, depthFar, localFloat32Array4);
-      _normalizeMatrixArray(localFloat32Array4);
-      frameData.leftProjectionMatrix.set(localFloat32Array4);
-
-      vrPresentState.system.GetProjectionRaw(0, localFovArray);
-      for (let i = 0; i < localFovArray.length; i++) {
-        localFovArray[i] = Math.atan(localFovArray[i]) / Math.PI * 180;
-      }
-      const leftFov = localFovArray;
-
-      vrPresentState.system.GetEyeToHeadTransform(1, localFloat32Array4);
-      _normalizeMatrixArray(localFloat32Array4);
-      localMatrix2.fromArray(localFloat32Array4);
-      localMatrix2.decompose(localVector, localQuaternion, localVector2);
-      localVector.toArray(localOffsetArray2);
-      const rightOffset = localOffsetArray2;
-      localMatrix2
-        .getInverse(localMatrix2)
-        .multiply(hmdMatrix);
-      localMatrix2.toArray(frameData.rightViewMatrix);
-
-      vrPresentState.system.GetProjectionMatrix(1, depthNear, depthFar, localFloat32Array4);
-      _normalizeMatrixArray(localFloat32Array4);
-      frameData.rightProjectionMatrix.set(localFloat32Array4);
-
-      vrPresentState.system.GetProjectionRaw(1, localFovArray2);
-      for (let i = 0; i < localFovArray2.length; i++) {
-        localFovArray2[i] = Math.atan(localFovArray2[i]) / Math.PI * 180;
-      }
-      const rightFov = localFovArray2;
+      frameData.leftViewMatrix.set(leftEyeFrame.view);
+      frameData.leftProjectionMatrix.set(leftEyeFrame.projection);
+      const leftOffset = leftEyeFrame.offset;
+      const leftFov = leftEyeFrame.fov;
+
+      frameData.rightViewMatrix.set(rightEyeFrame.view);
+      frameData.rightProjectionMatrix.set(rightEyeFrame.projection);
+      const rightOffset = rightEyeFrame.offset;
+      const rightFov = rightEyeFrame.fov;
 
       // build stage parameters
       // vrPresentState.system.GetSeatedZeroPoseToStandingAbsoluteTrackingPose(localFloat32Array4);
@@ -944,65 +1207,8 @@ const _bindWindow = (window, newWindowCb) => {
       // stageParameters.sittingToStandingTransform.set(localFloat32Array4);
 
       // build gamepads data
-      vrPresentState.system.GetControllerState(0, localGamepadArray);
-      if (!isNaN(localGamepadArray[0])) {
-        // matrix
-        localMatrix.fromArray(localFloat32Array2);
-        localMatrix.decompose(localVector, localQuaternion, localVector2);
-        localVector.toArray(leftGamepad.pose.position);
-        localQuaternion.toArray(leftGamepad.pose.orientation);
-
-        leftGamepad.buttons[0].pressed = localGamepadArray[4] !== 0; // pad
-        leftGamepad.buttons[1].pressed = localGamepadArray[5] !== 0; // trigger
-        leftGamepad.buttons[2].pressed = localGamepadArray[3] !== 0; // grip
-        leftGamepad.buttons[3].pressed = localGamepadArray[2] !== 0; // menu
-        leftGamepad.buttons[4].pressed = localGamepadArray[1] !== 0; // system
-
-        leftGamepad.buttons[0].touched = localGamepadArray[9] !== 0; // pad
-        leftGamepad.buttons[1].touched = localGamepadArray[10] !== 0; // trigger
-        leftGamepad.buttons[2].touched = localGamepadArray[8] !== 0; // grip
-        leftGamepad.buttons[3].touched = localGamepadArray[7] !== 0; // menu
-        leftGamepad.buttons[4].touched = localGamepadArray[6] !== 0; // system
-
-        for (let i = 0; i < 10; i++) {
-          leftGamepad.axes[i] = localGamepadArray[11+i];
-        }
-        leftGamepad.buttons[1].value = leftGamepad.axes[2]; // trigger
-
-        gamepads[0] = leftGamepad;
-      } else {
-        gamepads[0] = null;
-      }
-
-      vrPresentState.system.GetControllerState(1, localGamepadArray);
-      if (!isNaN(localGamepadArray[0])) {
-        // matrix
-        localMatrix.fromArray(localFloat32Array3);
-        localMatrix.decompose(localVector, localQuaternion, localVector2);
-        localVector.toArray(rightGamepad.pose.position);
-        localQuaternion.toArray(rightGamepad.pose.orientation);
-
-        rightGamepad.buttons[0].pressed = localGamepadArray[4] !== 0; // pad
-        rightGamepad.buttons[1].pressed = localGamepadArray[5] !== 0; // trigger
-        rightGamepad.buttons[2].pressed = localGamepadArray[3] !== 0; // grip
-        rightGamepad.buttons[3].pressed = localGamepadArray[2] !== 0; // menu
-        rightGamepad.buttons[4].pressed = localGamepadArray[1] !== 0; // system
-
-        rightGamepad.buttons[0].touched = localGamepadArray[9] !== 0; // pad
-        rightGamepad.buttons[1].touched = localGamepadArray[10] !== 0; // trigger
-        rightGamepad.buttons[2].touched = localGamepadArray[8] !== 0; // grip
-        rightGamepad.buttons[3].touched = localGamepadArray[7] !== 0; // menu
-        rightGamepad.buttons[4].touched = localGamepadArray[6] !== 0; // system
-
-        for (let i = 0; i < 10; i++) {
-          rightGamepad.axes[i] = localGamepadArray[11+i];
-        }
-        rightGamepad.buttons[1].value = rightGamepad.axes[2]; // trigger
-
-        gamepads[1] = rightGamepad;
-      } else {
-        gamepads[1] = null;
-      }
+      gamepads[0] = _updateVrGamepad(leftGamepad, vrFrameLayout.leftController);
+      gamepads[1] = _updateVrGamepad(rightGamepad, vrFrameLayout.rightController);
 
       if (vrPresentState.lmContext) {
         vrPresentState.lmContext.WaitGetPoses(handsArray);
@@ -1108,7 +1314,8 @@ const _bindWindow = (window, newWindowCb) => {
     }
 
     // poll for window events
-    nativeWindow.pollEvents();
+    const numInputEvents = nativeWindow.pollEvents(inputEvents);
+    _dispatchInputEvents(numInputEvents);
     if (args.performance) {
       const now = Date.now();
       const diff = now - timestamps.last;
@@ -1172,9 +1379,20 @@ const _bindWindow = (window, newWindowCb) => {
     numFrames++;
 
     // wait for next frame
-    const now = Date.now();
-    timeout = setTimeout(_recurse, Math.min(Math.max(FRAME_TIME_MAX - ~~(now - lastFrameTime), FRAME_TIME_MIN), FRAME_TIME_MAX));
-    lastFrameTime = now;
+    const delay = nativeWindow.endFrame(numInputEvents > 0, vrPresentState.isPresenting || isMlPresenting);
+    if (delay >= 2) {
+      // coarse wait on the event loop, then land on the frame boundary natively
+      timeout = setTimeout(_nextFrame, Math.floor(delay) - 1);
+    } else {
+      immediate = setImmediate(_nextFrame);
+    }
+  };
+  const _nextFrame = () => {
+    timeout = null;
+    immediate = null;
+
+    nativeWindow.waitForFrame();
+    _recurse();
   };
   process.nextTick(_recurse);
 };
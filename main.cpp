@@ -64,25 +64,16 @@ void Java_com_mafintosh_nodeonandroid_NodeService_onResize
 void Java_com_mafintosh_nodeonandroid_NodeService_onNewFrame
 () {
 // (JNIEnv *env, jclass clas, jfloatArray headViewMatrix, jfloatArray headQuaternion, jfloatArray centerArray) {
-  float headViewMatrixElements[] = {0};
-  float headQuaternionElements[] = {0};
-  float centerArrayElements[] = {0};
+  float headViewMatrixElements[16] = {0};
+  float headQuaternionElements[4] = {0};
+  float centerArrayElements[3] = {0};
 
   {
     HandleScope handle_scope(Isolate::GetCurrent());
 
-    Local<Float32Array> headMatrixFloat32Array = Float32Array::New(ArrayBuffer::New(Isolate::GetCurrent(), 16 * 4), 0, 16);
-    for (int i = 0; i < 16; i++) {
-      headMatrixFloat32Array->Set(i, Number::New(Isolate::GetCurrent(), headViewMatrixElements[i]));
-    }
-    Local<Float32Array> headQuaternionFloat32Array = Float32Array::New(ArrayBuffer::New(Isolate::GetCurrent(), 4 * 4), 0, 4);
-    for (int i = 0; i < 4; i++) {
-      headQuaternionFloat32Array->Set(i, Number::New(Isolate::GetCurrent(), headQuaternionElements[i]));
-    }
-    Local<Float32Array> centerFloat32Array = Float32Array::New(ArrayBuffer::New(Isolate::GetCurrent(), 3 * 4), 0, 3);
-    for (int i = 0; i < 3; i++) {
-      centerFloat32Array->Set(i, Number::New(Isolate::GetCurrent(), centerArrayElements[i]));
-    }
+    Local<Float32Array> headMatrixFloat32Array = createTypedArray<Float32Array>(16, headViewMatrixElements);
+    Local<Float32Array> headQuaternionFloat32Array = createTypedArray<Float32Array>(4, headQuaternionElements);
+    Local<Float32Array> centerFloat32Array = createTypedArray<Float32Array>(3, centerArrayElements);
     Local<Value> argv[] = {headMatrixFloat32Array, headQuaternionFloat32Array, centerFloat32Array};
     callFunction("onNewFrame", sizeof(argv)/sizeof(argv[0]), argv);
   }
@@ -92,20 +83,14 @@ void Java_com_mafintosh_nodeonandroid_NodeService_onNewFrame
 void Java_com_mafintosh_nodeonandroid_NodeService_onDrawEye
 () {
 // (JNIEnv *env, jclass clasj, jfloatArray eyeViewMatrix, jfloatArray eyePerspectiveMatrix) {
-  float eyeViewMatrixElements[] = {0};
-  float eyePerspectiveMatrixElements[] = {0};
+  float eyeViewMatrixElements[16] = {0};
+  float eyePerspectiveMatrixElements[16] = {0};
 
   {
     HandleScope handle_scope(Isolate::GetCurrent());
 
-    Local<Float32Array> eyeViewMatrixFloat32Array = Float32Array::New(ArrayBuffer::New(Isolate::GetCurrent(), 16 * 4), 0, 16);
-    for (int i = 0; i < 16; i++) {
-      eyeViewMatrixFloat32Array->Set(i, Number::New(Isolate::GetCurrent(), eyeViewMatrixElements[i]));
-    }
-    Local<Float32Array> eyePerspectiveMatrixFloat32Array = Float32Array::New(ArrayBuffer::New(Isolate::GetCurrent(), 4 * 4), 0, 4);
-    for (int i = 0; i < 4; i++) {
-      eyePerspectiveMatrixFloat32Array->Set(i, Number::New(Isolate::GetCurrent(), eyePerspectiveMatrixElements[i]));
-    }
+    Local<Float32Array> eyeViewMatrixFloat32Array = createTypedArray<Float32Array>(16, eyeViewMatrixElements);
+    Local<Float32Array> eyePerspectiveMatrixFloat32Array = createTypedArray<Float32Array>(16, eyePerspectiveMatrixElements);
     Local<Value> argv[] = {eyeViewMatrixFloat32Array, eyePerspectiveMatrixFloat32Array};
     callFunction("onDrawEye", sizeof(argv)/sizeof(argv[0]), argv);
   }
@@ -115,31 +100,24 @@ void Java_com_mafintosh_nodeonandroid_NodeService_onDrawEye
 void Java_com_mafintosh_nodeonandroid_NodeService_onDrawFrame
 () {
 // (JNIEnv *env, jclass clas, jfloatArray viewMatrix, jfloatArray projectionMatrix, jfloatArray centerArray) {
-  float viewMatrixElements[] = {0};
-  float projectionMatrixElements[] = {0};
-  float centerArrayElements[] = {0};
+  float viewMatrixElements[16] = {0};
+  float projectionMatrixElements[16] = {0};
+  float centerArrayElements[3] = {0};
 
   {
     HandleScope handle_scope(Isolate::GetCurrent());
 
-    Local<Float32Array> viewFloat32Array = Float32Array::New(ArrayBuffer::New(Isolate::GetCurrent(), 16 * 4), 0, 16);
-    for (int i = 0; i < 16; i++) {
-      viewFloat32Array->Set(i, Number::New(Isolate::GetCurrent(), viewMatrixElements[i]));
-    }
-    Local<Float32Array> projectionFloat32Array = Float32Array::New(ArrayBuffer::New(Isolate::GetCurrent(), 16 * 4), 0, 16);
-    for (int i = 0; i < 16; i++) {
-      projectionFloat32Array->Set(i, Number::New(Isolate::GetCurrent(), projectionMatrixElements[i]));
-    }
-    Local<Float32Array> centerFloat32Array = Float32Array::New(ArrayBuffer::New(Isolate::GetCurrent(), 3 * 4), 0, 3);
-    for (int i = 0; i < 3; i++) {
-      centerFloat32Array->Set(i, Number::New(Isolate::GetCurrent(), centerArrayElements[i]));
-    }
+    Local<Float32Array> viewFloat32Array = createTypedArray<Float32Array>(16, viewMatrixElements);
+    Local<Float32Array> projectionFloat32Array = createTypedArray<Float32Array>(16, projectionMatrixElements);
+    Local<Float32Array> centerFloat32Array = createTypedArray<Float32Array>(3, centerArrayElements);
     Local<Value> argv[] = {viewFloat32Array, projectionFloat32Array, centerFloat32Array};
     callFunction("onDrawFrame", sizeof(argv)/sizeof(argv[0]), argv);
   }
 }
 
 void InitExports(Handle<Object> exports) {
+  keys::init(Isolate::GetCurrent(), exports);
+
   Local<Value> gl = makeGl();
   exports->Set(v8::String::NewFromUtf8(Isolate::GetCurrent(), "nativeGl"), gl);
   
@@ -164,7 +142,7 @@ void InitExports(Handle<Object> exports) {
   Local<Value> canvasPattern = makeCanvasPattern();
   exports->Set(v8::String::NewFromUtf8(Isolate::GetCurrent(), "nativeCanvasPattern"), canvasPattern);
 
-  Local<Value> canvas = makeCanvasRenderingContext2D(imageData, canvasGradient, canvasPattern);
+  Local<Value> canvas = makeCanvasRenderingContext2D(imageData, imageBitmap, canvasGradient, canvasPattern);
   exports->Set(v8::String::NewFromUtf8(Isolate::GetCurrent(), "nativeCanvasRenderingContext2D"), canvas);
 
   Local<Value> audio = makeAudio();
@@ -203,6 +181,13 @@ void Init(Handle<Object> exports) {
   canvas::ImageData::setFlip(true);
 
   InitExports(exports);
+
+#if NODE_MODULE_VERSION >= 64 // node 10
+  Isolate *isolate = Isolate::GetCurrent();
+  node::AddEnvironmentCleanupHook(isolate, [](void *arg) {
+    keys::dispose((Isolate *)arg);
+  }, isolate);
+#endif
 }
 
 NODE_MODULE(NODE_GYP_MODULE_NAME, Init)
@@ -180,6 +180,14 @@ nativeVr.EVRApplicationType = {
   Bootstrapper: 7,
 };
 
+nativeVr.k_unTrackedDeviceIndex_Hmd = 0;
+
+nativeVr.ETrackedDeviceProperty = {
+  Prop_SecondsFromVsyncToPhotons_Float: 2001,
+  Prop_DisplayFrequency_Float: 2002,
+  Prop_UserIpdMeters_Float: 2003,
+};
+
 nativeVr.EVREye = {
   Left: 0,
   Right: 1,
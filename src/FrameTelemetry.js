@@ -0,0 +1,144 @@
+// Rolling frame timing for a page. The main loop reports its frame times, the desktop swap chain its swap
+// intervals and missed vsyncs, and the VR compositor its per-frame timings; get() summarizes the last
+// WINDOW_SIZE samples of each so dashboards can report percentiles and dropped/reprojected frame rates
+// without tracking history themselves.
+
+const WINDOW_SIZE = 900; // 10s at 90Hz
+
+class RollingSamples {
+  constructor(size = WINDOW_SIZE) {
+    this.samples = new Float64Array(size);
+    this.count = 0;
+    this.index = 0;
+  }
+  add(value) {
+    this.samples[this.index] = value;
+    this.index = (this.index + 1) % this.samples.length;
+    this.count = Math.min(this.count + 1, this.samples.length);
+  }
+  sum() {
+    let result = 0;
+    for (let i = 0; i < this.count; i++) {
+      result += this.samples[i];
+    }
+    return result;
+  }
+  getStats() {
+    if (this.count === 0) {
+      return {
+        count: 0,
+        mean: 0,
+        p50: 0,
+        p95: 0,
+        p99: 0,
+        max: 0,
+      };
+    }
+
+    const sorted = this.samples.slice(0, this.count).sort();
+    const _percentile = p => sorted[Math.min(Math.floor(this.count * p), this.count - 1)];
+    return {
+      count: this.count,
+      mean: this.sum() / this.count,
+      p50: _percentile(0.5),
+      p95: _percentile(0.95),
+      p99: _percentile(0.99),
+      max: sorted[this.count - 1],
+    };
+  }
+  clear() {
+    this.count = 0;
+    this.index = 0;
+  }
+}
+
+class FrameTelemetry {
+  constructor() {
+    this.frameTimes = new RollingSamples();
+
+    this.swapIntervals = new RollingSamples();
+    this.missedVsyncs = new RollingSamples();
+    this.lastSwaps = 0;
+    this.lastMissedVsyncs = 0;
+
+    this.vrFrameIntervals = new RollingSamples();
+    this.vrGpuTimes = new RollingSamples();
+    this.vrCompositorGpuTimes = new RollingSamples();
+    this.vrReprojected = new RollingSamples();
+    this.vrDropped = new RollingSamples();
+    this.lastVrFrameIndex = -1;
+    this.vrCumulativeStats = null;
+  }
+  addFrame(frameTime) {
+    this.frameTimes.add(frameTime);
+  }
+  // Takes the cumulative counters of nativeWindow.getSwapStats; a single new swap carries its interval.
+  addSwapStats({swaps, missedVsyncs, interval}) {
+    const newSwaps = swaps - this.lastSwaps;
+    if (newSwaps > 0) {
+      if (newSwaps === 1 && this.lastSwaps > 0) {
+        this.swapIntervals.add(interval);
+      }
+      this.missedVsyncs.add(missedVsyncs - this.lastMissedVsyncs);
+    }
+    this.lastSwaps = swaps;
+    this.lastMissedVsyncs = missedVsyncs;
+  }
+  // Takes frames written by IVRCompositor.GetFrameTimings; frames already seen are skipped.
+  addVrFrameTimings(timings, numFrames, stride) {
+    for (let i = 0; i < numFrames; i++) {
+      const offset = i * stride;
+      const frameIndex = timings[offset];
+      if (frameIndex > this.lastVrFrameIndex) {
+        const numFramePresents = timings[offset + 1];
+        const numDroppedFrames = timings[offset + 3];
+        this.vrReprojected.add(numFramePresents > 1 ? 1 : 0);
+        this.vrDropped.add(numDroppedFrames);
+        this.vrGpuTimes.add(timings[offset + 6]);
+        this.vrCompositorGpuTimes.add(timings[offset + 7]);
+        this.vrFrameIntervals.add(timings[offset + 9]);
+        this.lastVrFrameIndex = frameIndex;
+      }
+    }
+  }
+  setVrCumulativeStats(stats) {
+    this.vrCumulativeStats = stats;
+  }
+  resetVr() {
+    this.vrFrameIntervals.clear();
+    this.vrGpuTimes.clear();
+    this.vrCompositorGpuTimes.clear();
+    this.vrReprojected.clear();
+    this.vrDropped.clear();
+    this.lastVrFrameIndex = -1;
+    this.vrCumulativeStats = null;
+  }
+  get() {
+    // a frame that missed n vsyncs (or was dropped n times) took n + 1 display refreshes
+    const _rate = samples => {
+      const missed = samples.sum();
+      const total = samples.count + missed;
+      return total > 0 ? missed / total : 0;
+    };
+    return {
+      frame: this.frameTimes.getStats(),
+      swap: Object.assign(this.swapIntervals.getStats(), {
+        missedVsyncRate: _rate(this.missedVsyncs),
+      }),
+      vr: this.vrFrameIntervals.count > 0 ? {
+        frameInterval: this.vrFrameIntervals.getStats(),
+        gpu: this.vrGpuTimes.getStats(),
+        compositorGpu: this.vrCompositorGpuTimes.getStats(),
+        reprojectionRate: this.vrReprojected.count > 0 ? this.vrReprojected.sum() / this.vrReprojected.count : 0,
+        droppedFrameRate: _rate(this.vrDropped),
+        cumulative: this.vrCumulativeStats,
+      } : null,
+    };
+  }
+}
+
+module.exports = {
+  WINDOW_SIZE,
+  RollingSamples,
+  FrameTelemetry,
+};
@@ -252,6 +252,7 @@ class XRWebGLLayer {
     } = options;
 
     this.context = context;
+    this._session = session;
 
     this.antialias = antialias;
     this.depth = depth;
@@ -285,7 +286,10 @@ class XRWebGLLayer {
     return view._viewport;
   }
   requestViewportScaling(viewportScaleFactor) {
-    throw new Error('not implemented'); // XXX
+    // takes effect from the next frame's viewports
+    if (this._session.device.onrequestviewportscaling) {
+      this._session.device.onrequestviewportscaling(viewportScaleFactor);
+    }
   }
 }
 module.exports.XRWebGLLayer = XRWebGLLayer
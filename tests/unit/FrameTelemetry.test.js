@@ -0,0 +1,59 @@
+/* global assert, describe, it */
+const {RollingSamples, FrameTelemetry} = require('../../src/FrameTelemetry');
+
+describe('FrameTelemetry', () => {
+  describe('RollingSamples', () => {
+    it('reports percentiles of the samples', () => {
+      const samples = new RollingSamples(100);
+      for (let i = 100; i > 0; i--) {
+        samples.add(i);
+      }
+      const stats = samples.getStats();
+      assert.equal(stats.count, 100);
+      assert.equal(stats.mean, 50.5);
+      assert.equal(stats.p50, 51);
+      assert.equal(stats.p95, 96);
+      assert.equal(stats.p99, 100);
+      assert.equal(stats.max, 100);
+    });
+
+    it('keeps only the newest samples', () => {
+      const samples = new RollingSamples(2);
+      samples.add(10);
+      samples.add(1);
+      samples.add(2);
+      const stats = samples.getStats();
+      assert.equal(stats.count, 2);
+      assert.equal(stats.max, 2);
+    });
+  });
+
+  it('counts missed vsyncs against display refreshes', () => {
+    const telemetry = new FrameTelemetry();
+    telemetry.addSwapStats({swaps: 1, missedVsyncs: 0, interval: 0});
+    telemetry.addSwapStats({swaps: 2, missedVsyncs: 0, interval: 16});
+    telemetry.addSwapStats({swaps: 3, missedVsyncs: 2, interval: 48});
+    const {swap} = telemetry.get();
+    assert.equal(swap.count, 2);
+    assert.equal(swap.max, 48);
+    assert.equal(swap.missedVsyncRate, 2 / 5);
+  });
+
+  it('skips VR frames it has already seen', () => {
+    const telemetry = new FrameTelemetry();
+    const stride = 10;
+    const timings = new Float64Array(stride * 2);
+    timings.set([1, 1, 0, 0, 0, 0, 5, 1, 1, 11], 0);
+    timings.set([2, 2, 0, 1, 0, 0, 7, 1, 1, 22], stride);
+    telemetry.addVrFrameTimings(timings, 2, stride);
+    telemetry.addVrFrameTimings(timings, 2, stride);
+    const {vr} = telemetry.get();
+    assert.equal(vr.frameInterval.count, 2);
+    assert.equal(vr.gpu.max, 7);
+    assert.equal(vr.reprojectionRate, 0.5);
+    assert.equal(vr.droppedFrameRate, 1 / 3);
+
+    telemetry.resetVr();
+    assert.equal(telemetry.get().vr, null);
+  });
+});
@@ -0,0 +1,32 @@
+/* global assert, describe, it */
+const child_process = require('child_process');
+const path = require('path');
+
+describe('--nullVr', () => {
+  it('runs the VR frame loop without a runtime', function (done) {
+    this.timeout(30000);
+
+    const exokit = child_process.spawn(process.argv[0], [
+      path.join(__dirname, '..', '..', 'index.js'),
+      '--nullVr',
+      path.join(__dirname, 'data', 'nullVr.html'),
+    ]);
+    let output = '';
+    exokit.stdout.on('data', data => {
+      output += data;
+
+      const match = output.match(/nullVr (frames|error) (.*)\n/);
+      if (match) {
+        exokit.kill();
+        assert.equal(match[1], 'frames', match[2]);
+        assert.equal(match[2], '10');
+        done();
+      }
+    });
+    exokit.on('exit', code => {
+      if (!/nullVr (frames|error)/.test(output)) {
+        done(new Error(`exited with ${code} before presenting`));
+      }
+    });
+  });
+});
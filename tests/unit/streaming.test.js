@@ -0,0 +1,32 @@
+/* global assert, describe, it */
+const child_process = require('child_process');
+const path = require('path');
+
+describe('bufferSubData streaming', () => {
+  it('keeps streaming past the ring capacity on a hidden context', function (done) {
+    this.timeout(30000);
+
+    const exokit = child_process.spawn(process.argv[0], [
+      path.join(__dirname, '..', '..', 'index.js'),
+      path.join(__dirname, 'data', 'streaming.html'),
+    ]);
+    let output = '';
+    exokit.stdout.on('data', data => {
+      output += data;
+
+      const match = output.match(/streaming ([0-9]+) ([0-9]+)\n/);
+      if (match) {
+        exokit.kill();
+        // 32 uploads of 1MB through a 4MB ring only stream past the first few if finished frames are retired
+        const streamed = parseInt(match[1], 10);
+        assert.isAbove(streamed, 4);
+        done();
+      }
+    });
+    exokit.on('exit', code => {
+      if (!/streaming [0-9]+ [0-9]+\n/.test(output)) {
+        done(new Error(`exited with ${code} before streaming`));
+      }
+    });
+  });
+});
@@ -0,0 +1,31 @@
+/* global assert, describe, it */
+const child_process = require('child_process');
+const path = require('path');
+
+describe('texImage2DFromContainer', () => {
+  it('uploads valid KTX, KTX2 and DDS files and rejects malformed ones', function (done) {
+    this.timeout(30000);
+
+    const exokit = child_process.spawn(process.argv[0], [
+      path.join(__dirname, '..', '..', 'index.js'),
+      path.join(__dirname, 'data', 'textureContainer.html'),
+    ]);
+    let output = '';
+    exokit.stdout.on('data', data => {
+      output += data;
+
+      const match = output.match(/containers ([0-9]+) (.*)\n/);
+      if (match) {
+        exokit.kill();
+        assert.isAbove(parseInt(match[1], 10), 0);
+        assert.deepEqual(JSON.parse(match[2]), []);
+        done();
+      }
+    });
+    exokit.on('exit', code => {
+      if (!/containers [0-9]+ .*\n/.test(output)) {
+        done(new Error(`exited with ${code} before parsing`));
+      }
+    });
+  });
+});